@@ -9,6 +9,7 @@
 #	define	GET_CPUID(inf, id)			__cpuid(inf, id)
 #	define	GET_CPUIDEX(inf, id, sid)	__cpuidex(inf, id, sid)
 #elif defined(__GNUC__)
+#	include <stdio.h>
 #	include <unistd.h>
 #	include <cpuid.h>
 #	define	GET_CPUID(inf, id)			__cpuid(id, inf[0], inf[1], inf[2], inf[3])
@@ -74,3 +75,117 @@ slb_bool_t IsSimdAvailableAVX512(void)
 	}
 	return s_bAvailable;
 }
+
+/* Returns if SSSE3 is available */
+slb_bool_t IsSimdAvailableSSSE3(void)
+{
+	static slb_bool_t s_bAvailable = -1;
+	if (s_bAvailable < 0) {
+		int eax_max;
+		int info[4];
+		GET_CPUID(info, 0);
+		eax_max = info[0];
+		if (1 <= eax_max) {
+			GET_CPUID(info, 1);
+			s_bAvailable = (slb_bool_t)( (info[2] & (1 << 9)) != 0 );
+		}
+		else {
+			s_bAvailable = SLB_FALSE;
+		}
+	}
+	return s_bAvailable;
+}
+
+/* Returns if GFNI is available */
+slb_bool_t IsSimdAvailableGFNI(void)
+{
+	static slb_bool_t s_bAvailable = -1;
+	if (s_bAvailable < 0) {
+		int eax_max;
+		int info[4];
+		GET_CPUID(info, 0);
+		eax_max = info[0];
+		if (7 <= eax_max) {
+			GET_CPUIDEX(info, 7, 0);
+			s_bAvailable = (slb_bool_t)( (info[2] & (1 << 8)) != 0 );
+		}
+		else {
+			s_bAvailable = SLB_FALSE;
+		}
+	}
+	return s_bAvailable;
+}
+
+/* Returns the size of the data (or unified) cache of the level in bytes (0: unknown)
+	The deterministic cache parameters of CPUID (leaf 4, or 0x8000001D of AMD) are used,
+	and /sys/devices/system/cpu of Linux when CPUID does not report them.
+*/
+slb_uint_t GetCacheSize(slb_uint_t level)
+{
+	static slb_uint_t s_size[4];
+	static slb_bool_t s_bDone = SLB_FALSE;
+
+	if (s_bDone == SLB_FALSE) {
+		const unsigned int leaf[2] = { 4U, 0x8000001dU };
+		int info[4];
+		unsigned int i, l, lv, type, max[2];
+
+		GET_CPUID(info, 0);
+		max[0] = (unsigned int)info[0];
+		GET_CPUID(info, 0x80000000);
+		max[1] = (unsigned int)info[0];
+
+		for (l = 0; l < 2U; ++l) {
+			if ( (max[l] < leaf[l]) || (s_size[1] != 0U) ) {
+				continue;
+			}
+			for (i = 0; i < 16U; ++i) {
+				GET_CPUIDEX(info, (int)leaf[l], (int)i);
+				type = (unsigned int)info[0] & 0x1fU;
+				lv = ( (unsigned int)info[0] >> 5 ) & 7U;
+				if (type == 0U) {
+					break;
+				}
+				if ( (type != 2U) && (lv < 4U) ) {		/* data or unified */
+					s_size[lv] = ( ( (unsigned int)info[1] >> 22 ) + 1U ) *				/* ways */
+								 ( ( ( (unsigned int)info[1] >> 12 ) & 0x3ffU ) + 1U ) *	/* partitions */
+								 ( ( (unsigned int)info[1] & 0xfffU ) + 1U ) *			/* line size */
+								 ( (unsigned int)info[2] + 1U );						/* sets */
+				}
+			}
+		}
+
+#if defined(__GNUC__)
+		for (i = 0; (i < 16U) && (s_size[1] == 0U || s_size[2] == 0U); ++i) {
+			char path[64], text[16];
+			FILE* fp;
+			unsigned int size;
+
+			sprintf(path, "/sys/devices/system/cpu/cpu0/cache/index%u/level", i);
+			if ( ( fp = fopen(path, "r") ) == NULL ) {
+				break;
+			}
+			lv = ( fscanf(fp, "%u", &lv) == 1 ) ? lv : 0U;
+			fclose(fp);
+			sprintf(path, "/sys/devices/system/cpu/cpu0/cache/index%u/type", i);
+			if ( ( fp = fopen(path, "r") ) == NULL ) {
+				break;
+			}
+			type = ( ( fscanf(fp, "%15s", text) == 1 ) && (text[0] != 'I') ) ? 1U : 0U;		/* not Instruction */
+			fclose(fp);
+			sprintf(path, "/sys/devices/system/cpu/cpu0/cache/index%u/size", i);
+			if ( ( fp = fopen(path, "r") ) == NULL ) {
+				break;
+			}
+			size = ( fscanf(fp, "%uK", &size) == 1 ) ? size * 1024U : 0U;
+			fclose(fp);
+			if ( (type != 0U) && (1U <= lv) && (lv < 4U) && (s_size[lv] == 0U) ) {
+				s_size[lv] = size;
+			}
+		}
+#endif
+		s_bDone = SLB_TRUE;
+	}
+
+	return ( level < 4U ) ? s_size[level] : 0U;
+}
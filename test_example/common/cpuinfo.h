@@ -6,6 +6,13 @@
 
 #include "slb_types.h"
 
+/* Enables the instruction set for a function using SIMD intrinsics */
+#if defined(__GNUC__)
+#	define SIMD_TARGET(isa)	__attribute__((target(isa)))
+#else
+#	define SIMD_TARGET(isa)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -13,6 +20,10 @@ extern "C" {
 slb_bool_t IsSimdAvailableSSE2(void);
 slb_bool_t IsSimdAvailableAVX2(void);
 slb_bool_t IsSimdAvailableAVX512(void);
+slb_bool_t IsSimdAvailableSSSE3(void);
+slb_bool_t IsSimdAvailableGFNI(void);
+
+slb_uint_t GetCacheSize(slb_uint_t level);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ Timing leakage check
+ *******************************************************************************/
+#include "ctcheck.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#elif defined(__GNUC__)
+#	include <x86intrin.h>
+#endif
+
+#define CT_WARMUP			1000	/* Number of measurements to decide the cropping thresholds */
+#define CT_CROPS			5		/* Number of cropping thresholds */
+
+/* Percentiles for cropping */
+static const slb_uint_t s_crop_percent[CT_CROPS] = { 100U, 95U, 90U, 75U, 50U };
+
+/* Welch's t-test (online) */
+typedef struct {
+	double	n[2];		/* number of measurements */
+	double	mean[2];	/* mean */
+	double	m2[2];		/* sum of squares of differences from mean */
+} CT_TTEST;
+
+static void ttest_push(CT_TTEST* test, slb_uint_t cls, double value);
+static double ttest_value(const CT_TTEST* test);
+static int compare_cycles(const void* a, const void* b);
+
+/* Checks timing leakage and returns the largest |t| */
+double ct_check(
+	CT_PREPARE		prepare_func,		/* function to prepare input */
+	CT_RUN			run_func,			/* function to run target */
+	void*			param,				/* parameter for functions */
+	slb_uint_t		measurements		/* number of measurements */
+)
+{
+	slb_uint64_t warmup[CT_WARMUP];
+	slb_uint64_t threshold[CT_CROPS];
+	CT_TTEST test[CT_CROPS];
+	double t_max = 0.0;
+	slb_uint_t i, c;
+
+	for (c = 0; c < CT_CROPS; ++c) {
+		test[c].n[0] = test[c].n[1] = 0.0;
+		test[c].mean[0] = test[c].mean[1] = 0.0;
+		test[c].m2[0] = test[c].m2[1] = 0.0;
+		threshold[c] = SLB_ULLONG_MAX;
+	}
+
+	for (i = 0; i < CT_WARMUP + measurements; ++i) {
+		const slb_uint_t cls = (slb_uint_t)rand() & 1U;
+		slb_uint64_t start, cycles;
+
+		/* Measure */
+		prepare_func(param, cls);
+		start = __rdtsc();
+		run_func(param);
+		cycles = __rdtsc() - start;
+
+		/* Decide the cropping thresholds from the warm-up measurements */
+		if (i < CT_WARMUP) {
+			warmup[i] = cycles;
+			if (i == CT_WARMUP - 1U) {
+				qsort(warmup, CT_WARMUP, sizeof(warmup[0]), compare_cycles);
+				for (c = 1; c < CT_CROPS; ++c) {
+					threshold[c] = warmup[ ( CT_WARMUP * s_crop_percent[c] ) / 100U ];
+				}
+			}
+			continue;
+		}
+
+		for (c = 0; c < CT_CROPS; ++c) {
+			if (cycles <= threshold[c]) {
+				ttest_push(&test[c], cls, (double)cycles);
+			}
+		}
+	}
+
+	for (c = 0; c < CT_CROPS; ++c) {
+		double t = fabs( ttest_value(&test[c]) );
+		if (t_max < t) {
+			t_max = t;
+		}
+	}
+
+	return t_max;
+}
+
+/* Adds a measurement (Welford's method) */
+static void ttest_push(CT_TTEST* test, slb_uint_t cls, double value)
+{
+	double delta;
+
+	test->n[cls] += 1.0;
+	delta = value - test->mean[cls];
+	test->mean[cls] += delta / test->n[cls];
+	test->m2[cls] += delta * ( value - test->mean[cls] );
+}
+
+/* Returns t value */
+static double ttest_value(const CT_TTEST* test)
+{
+	double var0, var1, den;
+
+	if ( (test->n[0] < 2.0) || (test->n[1] < 2.0) ) {
+		return 0.0;
+	}
+
+	var0 = test->m2[0] / ( test->n[0] - 1.0 );
+	var1 = test->m2[1] / ( test->n[1] - 1.0 );
+	den = sqrt( ( var0 / test->n[0] ) + ( var1 / test->n[1] ) );
+	if (den == 0.0) {
+		return 0.0;
+	}
+
+	return ( test->mean[0] - test->mean[1] ) / den;
+}
+
+/* Compares cycles for qsort */
+static int compare_cycles(const void* a, const void* b)
+{
+	const slb_uint64_t va = *(const slb_uint64_t*)a;
+	const slb_uint64_t vb = *(const slb_uint64_t*)b;
+	return (va < vb) ? -1 : ( (vb < va) ? 1 : 0 );
+}
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ Timing leakage check
+ -------------------------------------------------------------------------------
+ Checks statistically that the processing time does not depend on the secret
+ input, in the manner of dudect.
+
+ The target is measured many times, and the input of each measurement is chosen
+ at random from two classes: the fixed input and the random input.
+ Welch's t-test is applied to the processing times of the two classes, and
+ |t| larger than CT_T_THRESHOLD means that the processing time depends on the input.
+ Since the large outliers caused by interrupts hide small differences, the test is
+ also applied to the processing times cropped at some percentiles.
+ *******************************************************************************/
+#ifndef CTCHECK_H
+#define CTCHECK_H
+
+#include "slb_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CT_T_THRESHOLD		4.5		/* Threshold of |t| to judge as leakage */
+
+#define CT_CLASS_FIXED		0U		/* Class: fixed input */
+#define CT_CLASS_RANDOM		1U		/* Class: random input */
+
+/* Prepares the input of the class (not measured) */
+typedef void (*CT_PREPARE)(void* param, slb_uint_t cls);
+
+/* Runs the target (measured) */
+typedef void (*CT_RUN)(void* param);
+
+double ct_check(
+	CT_PREPARE		prepare_func,		/* function to prepare input */
+	CT_RUN			run_func,			/* function to run target */
+	void*			param,				/* parameter for functions */
+	slb_uint_t		measurements		/* number of measurements */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef CTCHECK_H */
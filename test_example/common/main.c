@@ -2,6 +2,8 @@
  test example for libslbsss
  -------------------------------------------------------------------------------
  "-m" option: Start in measurement mode
+ "-c" option: Use constant-time layout of stream
+ "-t" option: Start in timing leakage check mode
  *******************************************************************************/
 #include <stdlib.h>
 
@@ -10,6 +12,7 @@
 #include <time.h>
 #include <string.h>
 #include <stdarg.h>
+#include <immintrin.h>
 
 #if defined(_MSC_VER)
 #	include <crtdbg.h>
@@ -20,6 +23,7 @@
 #elif defined(__GNUC__)
 #	include <unistd.h>
 #	include <sys/syscall.h>
+#	include <sys/stat.h>
 #	define TID_T		pid_t
 #	define GetCurrentThreadId()		(TID_T)syscall(SYS_gettid)
 #	define InterlockedIncrement(p)	__atomic_add_fetch(p, 1, __ATOMIC_RELAXED)
@@ -28,11 +32,37 @@
 
 #include "main.h"
 #include "cpuinfo.h"
+#include "ctcheck.h"
+#include "sss_gfp.h"
+#include "sss_gf256.h"
+#include "sss_gf65536.h"
+#include "sss_ntt.h"
+#include "sss_interp.h"
+#include "sss_gemm.h"
+#include "sss_plan.h"
+#include "sss_packed.h"
+#include "sss_res.h"
+#include "sss_step.h"
+#include "sss_online.h"
+#include "sss_partial.h"
+#include "sss_bytes.h"
+#include "sss_wipe.h"
+#include "sss_pool.h"
+#include "sss_tune.h"
+#include "sss_topo.h"
+#include "sss_team.h"
+#include "sss_metrics.h"
+#include "sss_clock.h"
+#include "sss_lz.h"
+#include "sss_robust.h"
 
 #define ASSERT(f)	if (!(f)) {printf("\n!!! Assertion Failed !!!  %s (%d)\n", __FILE__, __LINE__); \
 								exit(0);} else ((void)0)
 
-slb_bool_t	g_measure;	/* =SLB_TRUE: measurement mode */
+slb_bool_t	g_measure;		/* =SLB_TRUE: measurement mode */
+slb_bool_t	g_const_time;	/* =SLB_TRUE: constant-time layout of stream */
+slb_bool_t	g_stream_avx2;	/* =SLB_TRUE: AVX2 is used for constant-time layout and share tags */
+slb_bool_t	g_timing;		/* =SLB_TRUE: timing leakage check mode */
 
 int		g_mem_callback_param;	/* Parameter for alloc and  free callback function (verify only address value) */
 int		g_rand_callback_param;	/* Parameter for get random number callback function (verify only address value) */
@@ -40,8 +70,13 @@ int		g_user_callback_param;	/* Parameter for contribution callback function (ver
 
 TID_T	g_MyThreadId;			/* My thread ID */
 
+slb_uint_t	g_alloc2_size[4];		/* Bytes allocated by the extended callback for each usage */
+slb_uint_t	g_alloc2_peak[4];		/* Peak of g_alloc2_size */
+
 #define	CODING_MAX_CHUNK	1024	/* Maximum number of data processed in one encoding/decoding */
 
+#define DECODE_RES_FILE		"sss_decode.res"	/* File of the decode resource of the example modules */
+
 #define F_SSE2		0x1U	/* SIMD flag: SSE2 */
 #define F_AVX2		0x2U	/* SIMD flag: AVX2 */
 #define F_AVX512	0x4U	/* SIMD flag: AVX-512 */
@@ -49,13 +84,24 @@ TID_T	g_MyThreadId;			/* My thread ID */
 
 #define MAX_PLAYERS			100			/* Maximum players */
 #define MAX_PLAIN_BYTES		0x300000	/* Maximum plain bytes */
-slb_uint8_t	g_stream_mem[MAX_PLAYERS][ ( sizeof(slb_uint16_t) * MAX_PLAIN_BYTES ) + MAX_PLAIN_BYTES ];
+#define ROBUST_SPARSE_PERIOD	4		/* Period of the corrupted words of a share (sparse robust decode) */
+#define STREAM_MIN_CHUNK	64			/* Minimum number of data of a chunk in stream */
+#define POOL_TASK_BLOCKS	4U			/* Blocks cached by a worker thread (pool example) */
+#define MAX_TAG_BYTES		( ( ( MAX_PLAIN_BYTES + STREAM_MIN_CHUNK - 1 ) / STREAM_MIN_CHUNK ) * ( sizeof(slb_uint16_t) + 1 ) )
+										/* Maximum share tag bytes (one 3-byte tag per chunk) */
+slb_uint8_t	g_stream_mem[MAX_PLAYERS][ ( sizeof(slb_uint16_t) * MAX_PLAIN_BYTES ) + MAX_PLAIN_BYTES + MAX_TAG_BYTES ];
 										/* Allocation memory for each stream */
 
+#define TIMING_K				5		/* Threshold for timing leakage check */
+#define TIMING_N				10		/* Number of shares for timing leakage check */
+#define TIMING_NMB				256		/* Number of data for timing leakage check */
+#define TIMING_MEASUREMENTS		20000	/* Number of measurements for timing leakage check */
+
 /* Main function */
 int main(int argc, char* argv[])
 {
 	slb_int_t plainsize, n, k_min, k_max;
+	int i;
 
 	/* Get number of CPU logical cores */
 	slb_int_t cores = slb_get_nmb_of_cores();
@@ -68,8 +114,20 @@ int main(int argc, char* argv[])
 	/* Display library version and max players */
 	const char* lib_version = libslbsss_get_version();
 
-	/* Get measurement mode */
-	g_measure = ( (1 < argc) && ( strcmp(argv[1], "-m") == 0 ) );
+	/* Get options */
+	for (i = 1; i < argc; ++i) {
+		if ( strcmp(argv[i], "-m") == 0 ) {
+			g_measure = SLB_TRUE;
+		}
+		else if ( strcmp(argv[i], "-c") == 0 ) {
+			g_const_time = SLB_TRUE;
+		}
+		else if ( strcmp(argv[i], "-t") == 0 ) {
+			g_timing = SLB_TRUE;
+		}
+	}
+
+	g_stream_avx2 = bAVX2;
 
 	/* Start message */
 	printf("\n############################ start\n");
@@ -84,6 +142,12 @@ int main(int argc, char* argv[])
 	/* Initialize the common resource for decryption */
 	slb_sss_init_decode_res();
 
+	/* Map the decode resource of the example modules (if not, it is built) */
+	if ( SLB_R_FAILED( sss_res_map(DECODE_RES_FILE) ) ) {
+		printf_detail("Decode resource is not mapped\n");
+		ASSERT( SLB_R_SUCCEEDED( sss_res_prepare() ) );
+	}
+
 	/* Display this computer spec */
 	printf("Number of logical cores = %d\n", cores);
 	printf("Implemented SIMD =");
@@ -96,6 +160,16 @@ int main(int argc, char* argv[])
 	/* Initialize random numbers */
 	srand(1);
 
+	/* Timing leakage check mode */
+	if (g_timing) {
+		sss_example_timing();
+		sss_res_release();
+		printf("############################ end\n");
+		return 0;
+	}
+
+	printf("Constant-time layout of stream = %d\n", g_const_time);
+
 	/* Normal mode */
 	if (g_measure == SLB_FALSE) {
 		plainsize = 0x10000;
@@ -157,6 +231,14 @@ int main(int argc, char* argv[])
 		}
 	}
 
+	/* Examples of the modules (not in the measurement mode) */
+	if (g_measure == SLB_FALSE) {
+		sss_example_modules( plainsize, n, k_min, bAVX2, bAVX512 );
+	}
+
+	/* Release the decode resource */
+	sss_res_release();
+
 	/* End message */
 	printf("############################ end\n");
 
@@ -167,6 +249,136 @@ int main(int argc, char* argv[])
 	return 0;
 }
 
+/* Examples of the modules */
+void sss_example_modules(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k_min,			/* minimum threshold */
+	slb_bool_t			bAVX2,			/* =SLB_TRUE: AVX2 is available */
+	slb_bool_t			bAVX512			/* =SLB_TRUE: AVX512 is available */
+)
+{
+	/* GF(2^8) field mode (the plain data is of odd bytes) */
+	sss_example_gf256( plainsize + 1, n, k_min, SLB_FALSE, SLB_FALSE );
+	if ( IsSimdAvailableSSSE3() ) {
+		sss_example_gf256( plainsize + 1, n, k_min, SLB_TRUE, SLB_FALSE );
+	}
+	if ( bAVX512 && IsSimdAvailableGFNI() ) {
+		sss_example_gf256( plainsize + 1, n, k_min, SLB_FALSE, SLB_TRUE );
+	}
+
+	/* GF(2^16) field mode */
+	sss_example_gf65536( plainsize, n, k_min, SLB_FALSE, SLB_FALSE );
+	if ( IsSimdAvailableSSSE3() ) {
+		sss_example_gf65536( plainsize, n, k_min, SLB_TRUE, SLB_FALSE );
+	}
+	if ( bAVX512 && IsSimdAvailableGFNI() ) {
+		sss_example_gf65536( plainsize, n, k_min, SLB_FALSE, SLB_TRUE );
+	}
+
+	/* NTT encoding */
+	sss_ntt_set_simd(SLB_FALSE);
+	sss_example_ntt( plainsize, n, k_min );
+	if (bAVX2) {
+		sss_ntt_set_simd(SLB_TRUE);
+		sss_example_ntt( plainsize, n, k_min );
+	}
+
+	/* Fast interpolation decoding (the subproduct tree is used with the larger k) */
+	sss_interp_set_simd(bAVX2);
+	sss_example_interp( n, k_min );
+	sss_example_interp( 2048, (slb_int_t)SSS_INTERP_TREE_MIN_K + 64 );
+
+	/* GEMM encoding */
+	sss_gemm_set_simd(SLB_FALSE, SLB_FALSE);
+	sss_example_gemm( plainsize, n, k_min );
+	if (bAVX2) {
+		sss_gemm_set_simd(SLB_TRUE, SLB_FALSE);
+		sss_example_gemm( plainsize, n, k_min );
+	}
+	if (bAVX512) {
+		sss_gemm_set_simd(SLB_FALSE, SLB_TRUE);
+		sss_example_gemm( plainsize, n, k_min );
+	}
+
+	/* Non-temporal share output */
+	if (bAVX2) {
+		sss_gemm_set_simd(SLB_TRUE, SLB_FALSE);
+		sss_example_stream( n, k_min );
+	}
+	if (bAVX512) {
+		sss_gemm_set_simd(SLB_FALSE, SLB_TRUE);
+		sss_example_stream( n, k_min );
+	}
+
+	/* Encode plan shared by GEMM encoding handles */
+	sss_example_plan( plainsize, n, k_min );
+
+	/* Multi-policy encoding */
+	sss_example_multi( plainsize );
+
+	/* Packed secret sharing (each share is 1/4 of the plain data) */
+	if (k_min + 3 <= n) {
+		sss_example_packed( plainsize, n, k_min, 4 );
+	}
+
+	/* Step encoding/decoding */
+	sss_example_step( plainsize, n, k_min );
+
+	/* Online decoding */
+	sss_example_online( n, k_min );
+
+	/* Partial reconstruction */
+	sss_example_partial( n, k_min, SLB_FALSE, SLB_FALSE );
+	if (bAVX2) {
+		sss_example_partial( n, k_min, SLB_TRUE, SLB_FALSE );
+	}
+	if (bAVX512) {
+		sss_example_partial( n, k_min, SLB_FALSE, SLB_TRUE );
+	}
+
+	/* Byte API */
+	sss_example_bytes( n, k_min, SLB_FALSE );
+	if (bAVX2) {
+		sss_example_bytes( n, k_min, SLB_TRUE );
+	}
+
+	/* Compression before splitting */
+	sss_example_lz( plainsize, n, k_min );
+
+	/* Secure wipe */
+	sss_example_wipe( n, SLB_FALSE );
+	if (bAVX2) {
+		sss_example_wipe( n, SLB_TRUE );
+	}
+
+	/* Pool allocator */
+	sss_example_pool( n, k_min );
+
+	/* Extended memory management callback */
+	sss_example_mem( plainsize, n, k_min );
+
+	/* Chunk size tuning */
+	sss_example_tune( plainsize, n, k_min );
+
+	/* CPU topology */
+	sss_example_topo( plainsize, n, k_min );
+
+	/* Thread team */
+	sss_example_team( n, k_min );
+
+	/* Metrics */
+	sss_example_metrics( n, k_min );
+
+	/* Share tag lanes */
+	if (bAVX2) {
+		sss_example_tag();
+	}
+
+	/* Decode resource */
+	sss_example_res();
+}
+
 /* Example subroutine */
 void sss_example_sub(
 	slb_int_t			plainsize,		/* plain size */
@@ -193,6 +405,8 @@ void sss_example_sub(
 	STREAM_BUFF*const stream = slb_alloc( &g_mem_callback_param, sizeof(STREAM_BUFF) * (slb_uint_t)n );
 
 	for (i = 0; i < n; ++i) {
+		stream[i].tag_key = 0;
+		stream[i].const_time = g_const_time;
 		stream[i].data = g_stream_mem[i];
 	}
 
@@ -290,7 +504,7 @@ void sss_example_sub(
 
 		/* Decode */
 		printf_detail("--- decode: k=%d\n", cur_k);
-		sss_example_decode( hDecode, plainsize, n, cur_k, plain, stream, SLB_TRUE );
+		sss_example_decode( hDecode, plainsize, n, cur_k, plain, stream, SLB_TRUE, SLB_TRUE );
 
 		if (g_measure) {
 			continue;
@@ -299,13 +513,33 @@ void sss_example_sub(
 		/* Decode success (= cur_k + 1) */
 		if (cur_k < n) {
 			printf_detail("--- decode: k=%d\n", cur_k + 1);
-			sss_example_decode( hDecode, plainsize, n, cur_k + 1, plain, stream, SLB_TRUE );
+			sss_example_decode( hDecode, plainsize, n, cur_k + 1, plain, stream, SLB_TRUE, SLB_TRUE );
 		}
 
 		/* Decode fail (= cur_k - 1) */
 		if ((slb_int_t)SLB_SSS_MIN_PLAYERS < cur_k) {
 			printf_detail("--- decode: k=%d\n", cur_k - 1);
-			sss_example_decode( hDecode, plainsize, n, cur_k - 1, plain, stream, SLB_FALSE );
+			sss_example_decode( hDecode, plainsize, n, cur_k - 1, plain, stream, SLB_FALSE, SLB_TRUE );
+		}
+
+		/* Decode fail (corrupted share is detected by share tag) */
+		{
+			slb_uint8_t saved[ sizeof(slb_uint16_t) + 1 ];
+			memcpy(saved, stream[0].data, sizeof(saved));
+			sss_corrupt_stream(&stream[0]);
+
+			printf_detail("--- decode: k=%d (corrupted share)\n", cur_k);
+			sss_example_decode( hDecode, plainsize, n, cur_k, plain, stream, SLB_TRUE, SLB_FALSE );
+
+			memcpy(stream[0].data, saved, sizeof(saved));
+		}
+
+		/* Robust decode (some shares are corrupt) */
+		if (cur_k == k_min) {
+			printf_detail("--- robust decode: k=%d\n", cur_k);
+			sss_example_robust_decode( hDecode, plainsize, n, cur_k, plain, stream, SLB_FALSE );
+			printf_detail("--- robust decode: k=%d (sparse)\n", cur_k);
+			sss_example_robust_decode( hDecode, plainsize, n, cur_k, plain, stream, SLB_TRUE );
 		}
 	}
 
@@ -364,9 +598,15 @@ void sss_example_encode(
 		stream[i].x = x[i];
 	}
 
-	/* Get the best number of data */
+	/* Get the keys of share tag */
+	sss_get_tag_keys(hEncode, n, stream);
+
+	/* Get the best number of data (a share tag is appended for each chunk) */
 	best_nmb = slb_sss_get_bestnmb(hEncode, CODING_MAX_CHUNK);
 	printf_detail("slb_sss_get_bestnmb: best_nmb=%d\n", best_nmb);
+	if (best_nmb < STREAM_MIN_CHUNK) {
+		best_nmb = STREAM_MIN_CHUNK;
+	}
 
 	/* Start statistics update */
 	rc = slb_sss_start_statistics(hEncode, CODING_MAX_CHUNK);
@@ -436,10 +676,12 @@ void sss_example_decode(
 	slb_int_t			cur_k,			/* current threshold */
 	const slb_uint16_t*	plain,			/* plain data */
 	STREAM_BUFF*		stream,			/* stream */
-	slb_bool_t			plain_match		/* =SLB_TRUE: expects plain data match */
+	slb_bool_t			plain_match,	/* =SLB_TRUE: expects plain data match */
+	slb_bool_t			tag_match		/* =SLB_TRUE: expects share tags match */
 )
 {
 	SLB_RC rc;
+	slb_bool_t tag_matched = SLB_TRUE;
 	SLB_SSS_HANDLE_STATE hstate;
 	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
 	slb_int_t i;
@@ -473,9 +715,12 @@ void sss_example_decode(
 	/* Check the information */
 	check_info(hDecode, cur_k, 0, cur_k - 1, x[cur_k-1]);
 
-	/* Get the best number of data */
+	/* Get the best number of data (a share tag is appended for each chunk) */
 	best_nmb = slb_sss_get_bestnmb(hDecode, CODING_MAX_CHUNK);
 	printf_detail("slb_sss_get_bestnmb: best_nmb=%d\n", best_nmb);
+	if (best_nmb < STREAM_MIN_CHUNK) {
+		best_nmb = STREAM_MIN_CHUNK;
+	}
 
 	/* Start statistics update */
 	rc = slb_sss_start_statistics(hDecode, CODING_MAX_CHUNK);
@@ -491,7 +736,7 @@ void sss_example_decode(
 	sss_reset_stream_pos(n, stream);
 
 	/* Process in optimal number units */
-	while ( (offset < plainsize) && SLB_R_SUCCEEDED(rc) ) {
+	while ( (offset < plainsize) && SLB_R_SUCCEEDED(rc) && tag_matched ) {
 
 		/* Determine number of data */
 		slb_int_t nmb = best_nmb;
@@ -499,8 +744,11 @@ void sss_example_decode(
 			nmb = plainsize - offset;
 		}
 
-		/* Reflect stream contents to share */
-		sss_stream_to_share(n, nmb, stream, share);
+		/* Reflect stream contents to share (and verify share tags) */
+		tag_matched = sss_stream_to_share(n, nmb, stream, share);
+		if (tag_matched == SLB_FALSE) {
+			break;
+		}
 
 		/* Decode */
 		rc = slb_sss_decode(hDecode, nmb, (const slb_uint32_t **)share, &plain2[offset]);
@@ -523,8 +771,31 @@ void sss_example_decode(
 	}
 	ASSERT( SLB_R_SUCCEEDED(rc) );
 
+	/* Check share tags */
+	if (tag_match) {
+		if (tag_matched) {
+			printf_detail("share tags matched.\n");
+		}
+		else {
+			printf("!!! share tags unmatched !!!\n");
+			ASSERT(SLB_FALSE);
+		}
+	}
+	else {
+		if (tag_matched) {
+			printf_detail("!!! share tags matched !!!\n");
+			ASSERT(SLB_FALSE);
+		}
+		else {
+			printf("share tags unmatched.\n");
+		}
+	}
+
 	/* Compare plain data */
-	if (plain_match) {
+	if (tag_matched == SLB_FALSE) {
+		/* Decoding was stopped by unmatched share tag */
+	}
+	else if (plain_match) {
 		if ( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) == 0 ) {
 			printf_detail("plain data matched.\n");
 		}
@@ -558,163 +829,3815 @@ void sss_example_decode(
 	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
 }
 
-/* Resets stream position */
-void sss_reset_stream_pos(
-	slb_int_t			n,			/* number of shares */
-	STREAM_BUFF*const	stream		/* stream buffer */
-)
-{
-	slb_int_t i;
-	for (i = 0; i < n; ++i) {
-		stream[i].pos = 0;
-	}
-}
-
-/* Reflects share contents to stream
-	The encoded data has meaning only from the LSB to 17 bits.
-	And the 17th bit is needed only if the lower 16 bit value is zero.
-	Here writes byte values if the lower 16 bit value is zero for simplicity.
-	Since the probability that the lower 16-bit value will be zero is low,
-	this method is practical when encoding plaintext of indeterministic size.
-	However, when encoding plaintext with a fixed size,
-	a structure in which the corresponding 17th bit is placed at a fixed position can be considered.
+/* Robust decode
+	(n - cur_k) / 2 shares are corrupted in all words after reading from stream,
+	or n - cur_k shares are corrupted in every ROBUST_SPARSE_PERIOD-th word (sparse).
+	They are found by robust decoding, and the plain data is decoded with cur_k other shares.
 */
-void sss_share_to_stream(
-	slb_int_t			n,			/* number of shares */
-	slb_int_t			nmb,		/* number of use */
-	slb_uint32_t**const	share,		/* share buffer */
-	STREAM_BUFF*const	stream		/* stream buffer */
+void sss_example_robust_decode(
+	H_SLB_SSS			hDecode,		/* control handle to decode */
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			cur_k,			/* current threshold */
+	const slb_uint16_t*	plain,			/* plain data */
+	STREAM_BUFF*		stream,			/* stream */
+	slb_bool_t			sparse			/* =SLB_TRUE: a few words of each corrupted share are corrupted */
 )
 {
+	SLB_RC rc;
+	SSS_ROBUST robust;
 	slb_int_t i, j;
+	slb_int_t offset;
+	slb_int_t best_nmb = CODING_MAX_CHUNK;
+	slb_int_t nmb_corrupted = 0;
+	slb_bool_t started = SLB_FALSE;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const x_sel = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)cur_k );
+	slb_bool_t*const corrupted = slb_alloc( &g_mem_callback_param, sizeof(slb_bool_t) * (slb_uint_t)n );
+	slb_bool_t*const faulty = slb_alloc( &g_mem_callback_param, sizeof(slb_bool_t) * (slb_uint_t)n );
+	slb_bool_t*const hit = slb_alloc( &g_mem_callback_param, sizeof(slb_bool_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t**) * (slb_uint_t)n );
+	const slb_uint32_t**const share_sel = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t**) * (slb_uint_t)cur_k );
 
-	/* Reflect share contents to stream */
 	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * CODING_MAX_CHUNK );
+	}
+	memset( x_sel, 0, sizeof(slb_uint16_t) * (slb_uint_t)cur_k );
 
-		/* Get write position of stream */
-		slb_uint_t pos = stream[i].pos;
+	/* Copy stream-x to x and select the shares to corrupt (including the first shares)
+		In sparse mode, a word has at most ceil((n - cur_k) / ROBUST_SPARSE_PERIOD) faulty shares,
+		which is not more than (n - cur_k) / 2.
+	*/
+	for (i = 0; i < n; ++i) {
+		x[i] = stream[i].x;
+		if (sparse) {
+			corrupted[i] = (slb_bool_t)( ( i < n - cur_k ) && ( 2 <= n - cur_k ) );
+		}
+		else {
+			corrupted[i] = (slb_bool_t)( ( (i % 2) == 0 ) && ( nmb_corrupted < (n - cur_k) / 2 ) );
+		}
+		if (corrupted[i]) {
+			++nmb_corrupted;
+		}
+	}
+
+	/* Open robust decoding context */
+	rc = sss_robust_open( &robust, (slb_uint_t)n, (slb_uint_t)cur_k, x, CODING_MAX_CHUNK, &g_mem_callback_param );
+	printf_detail("sss_robust_open: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
 
-		for (j = 0; j < nmb; ++j) {
+	/* Decode loop */
+	offset = 0;
 
-			/* Get the low value of share and write it to stream */
-			slb_uint16_t low = (slb_uint16_t)share[i][j];
-			SLB_WRITE16( &stream[i].data[pos], low );
-			pos += sizeof(slb_uint16_t);
+	/* Reset position in stream */
+	sss_reset_stream_pos(n, stream);
 
-			/* Value unknown at that low width */
-			if (low == 0) {
+	while ( (offset < plainsize) && SLB_R_SUCCEEDED(rc) ) {
+		slb_int_t nmb_sel = 0;
+		slb_bool_t changed = SLB_FALSE;
 
-				/* Get high value and write to stream */
-				slb_uint8_t high = (slb_uint8_t)( share[i][j] >> SLB_SHIFT_OF_2B );
-				stream[i].data[pos] = high;
-				++pos;
-			}
+		/* Determine number of data */
+		slb_int_t nmb = best_nmb;
+		if ( (plainsize - offset) < nmb ) {
+			nmb = plainsize - offset;
 		}
 
-		/* Update position of stream */
-		stream[i].pos = pos;
-	}
-}
+		/* Reflect stream contents to share */
+		ASSERT( sss_stream_to_share(n, nmb, stream, share) );
+
+		/* Corrupt shares (a share is faulty in the chunk if a word is corrupted) */
+		for (i = 0; i < n; ++i) {
+			hit[i] = SLB_FALSE;
+			for (j = 0; corrupted[i] && (j < nmb); ++j) {
+				if ( !sparse || ( ( i + j ) % ROBUST_SPARSE_PERIOD == 0 ) ) {
+					slb_uint32_t err = ( (slb_uint32_t)rand() % ( SSS_GFP_PRIME - 1U ) ) + 1U;
+					share[i][j] = SSS_GFP_ADD(share[i][j], err);
+					hit[i] = SLB_TRUE;
+				}
+			}
+		}
 
-/* Reflects stream contents to share */
-void sss_stream_to_share(
-	slb_int_t			n,			/* number of shares */
-	slb_int_t			nmb,		/* number of use */
-	STREAM_BUFF*const	stream,		/* stream buffer */
-	slb_uint32_t**const	share		/* share buffer */
-)
-{
-	slb_int_t i, j;
+		/* Find faulty shares */
+		ASSERT( sss_robust_check( &robust, nmb, (const slb_uint32_t **)share, faulty ) );
 
-	/* Reflect stream contents to share */
-	for (i = 0; i < n; ++i) {
+		/* Select the shares not faulty */
+		for (i = 0; i < n; ++i) {
+			ASSERT( faulty[i] == hit[i] );
 
-		/* Get the reading position of the stream */
-		slb_uint_t pos = stream[i].pos;
+			if ( (faulty[i] == SLB_FALSE) && (nmb_sel < cur_k) ) {
+				if (x_sel[nmb_sel] != x[i]) {
+					changed = SLB_TRUE;
+				}
+				x_sel[nmb_sel] = x[i];
+				share_sel[nmb_sel] = share[i];
+				++nmb_sel;
+			}
+		}
 
-		for (j = 0; j < nmb; ++j) {
+		/* Start decoding when the selected x coordinates are changed */
+		if ( (started == SLB_FALSE) || changed ) {
+			rc = slb_sss_start_decode(hDecode, (slb_uint_t)cur_k, x_sel);
+			printf_detail("slb_sss_start_decode: rc=0x%04x\n", rc);
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+			started = SLB_TRUE;
+		}
 
-			/* Get the low value of stream */
-			slb_uint16_t low;
-			SLB_READ16( &stream[i].data[pos], &low );
+		/* Decode */
+		rc = slb_sss_decode(hDecode, nmb, share_sel, &plain2[offset]);
 
-			/* Write low value to share */
-			share[i][j] = (slb_uint32_t)low;
-			pos += sizeof(slb_uint16_t);
+		/* Prepare for next loop */
+		offset += nmb;
+	}
 
-			/* Value unknown in low width */
-			if (low == 0) {
+	printf_detail("slb_sss_decode: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
 
-				/* Reflect high value to share */
-				slb_uint32_t high = (slb_uint32_t)stream[i].data[pos] << SLB_SHIFT_OF_2B;
-				share[i][j] |= high;
-				++pos;
-			}
+	/* Display faulty x coordinates */
+	printf_detail("faulty x =");
+	for (i = 0; i < n; ++i) {
+		if (faulty[i]) {
+			printf_detail(" %u", x[i]);
 		}
-
-		/* Update position of stream */
-		stream[i].pos = pos;
 	}
-}
+	printf_detail("\n");
 
-/* Gets random x coordinates */
-void sss_get_random_x(H_SLB_SSS hEncode, slb_int_t n, slb_uint16_t x[])
-{
-	const slb_int_t max_players = (slb_int_t)slb_sss_get_max_players_decode();
-	const slb_uint_t x_src_size = sizeof(slb_uint16_t) * (slb_uint_t)max_players;
-	slb_uint16_t* x_src = (slb_uint16_t*)slb_alloc( &g_mem_callback_param, x_src_size );
-	const slb_uint_t rand_val_size = sizeof(slb_uint_t) * (slb_uint_t)n;
-	slb_uint_t* rand_val = (slb_uint_t*)slb_alloc( &g_mem_callback_param, rand_val_size );
-	slb_int_t i, j;
-
-	for (i = 0; i < max_players; ++i) {
-		x_src[i] = (slb_uint16_t)(i + 1);
+	/* Compare plain data */
+	if ( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) == 0 ) {
+		printf_detail("plain data matched.\n");
+	}
+	else {
+		printf("!!! plain data unmatched !!!\n");
+		ASSERT(SLB_FALSE);
 	}
 
-	ASSERT( slb_sss_rand(hEncode, rand_val_size, rand_val) == R_SUCCESS );
+	/* Free resources */
+	sss_robust_close(&robust);
 
 	for (i = 0; i < n; ++i) {
-		j = (slb_int_t)( rand_val[i] % (slb_uint_t)(max_players - i) );
-		j += i;
-		x[i] = x_src[j];
-		x_src[j] =  x_src[i];
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
 	}
 
-	slb_free( &g_mem_callback_param, x_src, SLB_FALSE );
-	slb_free( &g_mem_callback_param, rand_val, SLB_FALSE );
+	slb_free( &g_mem_callback_param, x, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x_sel, SLB_TRUE );
+	slb_free( &g_mem_callback_param, corrupted, SLB_TRUE );
+	slb_free( &g_mem_callback_param, faulty, SLB_TRUE );
+	slb_free( &g_mem_callback_param, hit, SLB_TRUE );
+	slb_free( &g_mem_callback_param, share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, (void*)share_sel, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
 }
 
-/* Checks information */
-void check_max(H_SLB_SSS handle, slb_int_t k_max, slb_int_t n_max)
+/* GF(2^8) field mode
+	The shares are exactly the size of the plain data, and are written directly to the streams.
+	The plain data is decoded with the last k shares, and is not decoded with k - 1 shares.
+*/
+void sss_example_gf256(
+	slb_int_t			plainsize,		/* plain size (bytes) */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k,				/* threshold */
+	slb_bool_t			ssse3,			/* =SLB_TRUE: SSSE3 is used */
+	slb_bool_t			gfni			/* =SLB_TRUE: GFNI is used */
+)
 {
-	slb_uint_t info_val;
+	SSS_GF256 gfEncode, gfDecode;
+	SLB_RC rc;
+	slb_int_t i, cur_k;
+	slb_int_t offset;
+	slb_uint8_t x[SSS_GF256_MAX_PLAYERS];
+	slb_uint8_t* share[SSS_GF256_MAX_PLAYERS];
+	const slb_uint8_t* share_sel[SSS_GF256_MAX_PLAYERS];
+	slb_uint8_t u[131], v[131], ref[131], out[131];
+	slb_uint_t c;
+	time_t tm_start;
+	int elapsed;
 
-	info_val = slb_sss_get_info_k_max(handle);
-	if ( info_val != (slb_uint_t)k_max ) {
-		printf("!!! unexpected k_max\n");
-		ASSERT(SLB_FALSE);
-	}
+	/* Allocate resources */
+	slb_uint8_t*const plain = slb_alloc( &g_mem_callback_param, (slb_uint_t)plainsize );
+	slb_uint8_t*const plain2 = slb_alloc( &g_mem_callback_param, (slb_uint_t)plainsize );
 
-	info_val = slb_sss_get_info_n_max(handle);
-	if ( info_val != (slb_uint_t)n_max ) {
-		printf("!!! unexpected n_max\n");
-		ASSERT(SLB_FALSE);
-	}
-}
+	/* Set SIMD usage */
+	sss_gf256_set_simd(ssse3, gfni);
 
-void check_info(H_SLB_SSS handle, slb_int_t k, slb_int_t n, slb_int_t index, slb_uint16_t xval)
-{
-	slb_uint_t info_val;
-	slb_uint16_t info_x;
+	/* Start message */
+	printf("\n===== GF(2^8) ssse3=%d gfni=%d\n", ssse3, gfni);
 
-	info_val = slb_sss_get_info_k(handle);
-	if ( info_val != (slb_uint_t)k ) {
-		printf("!!! unexpected k\n");
-		ASSERT(SLB_FALSE);
+	/* Kernel against the scalar kernel (with 0 and 0xff, and the tail of the SIMD blocks) */
+	for (i = 0; i < 131; ++i) {
+		u[i] = (i % 3 == 0) ? 0U : (i % 3 == 1) ? SLB_MASK_OF_UINT8 : (slb_uint8_t)rand();
+		v[i] = (i % 4 == 0) ? SLB_MASK_OF_UINT8 : (i % 4 == 1) ? 0U : (slb_uint8_t)rand();
+	}
+	for (c = 0; c <= SLB_MASK_OF_UINT8; ++c) {
+		sss_gf256_set_simd(SLB_FALSE, SLB_FALSE);
+		sss_gf256_mul_region( 131, u, (slb_uint8_t)c, v, ref );
+		sss_gf256_set_simd(ssse3, gfni);
+		sss_gf256_mul_region( 131, u, (slb_uint8_t)c, v, out );
+		ASSERT( memcmp(ref, out, sizeof(out)) == 0 );
+	}
+	for (i = 0; i < 131; ++i) {
+		ASSERT( ref[i] == (slb_uint8_t)( sss_gf256_mul(u[i], (slb_uint8_t)SLB_MASK_OF_UINT8) ^ v[i] ) );
 	}
 
-	info_val = slb_sss_get_info_n(handle);
-	if ( info_val != (slb_uint_t)n ) {
+	/* Store random values in plain data */
+	ASSERT( rand_callback(&g_rand_callback_param, (slb_uint_t)plainsize, plain) );
+
+	/* Open */
+	rc = sss_gf256_open_as_encode( &gfEncode, (slb_uint_t)k, CODING_MAX_CHUNK,
+								   &g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	printf_detail("sss_gf256_open_as_encode: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	rc = sss_gf256_open_as_decode( &gfDecode, (slb_uint_t)k, &g_mem_callback_param );
+	printf_detail("sss_gf256_open_as_decode: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Invalid x coordinates */
+	x[0] = 1U;
+	x[1] = 0U;
+	ASSERT( sss_gf256_start_decode(&gfDecode, SLB_SSS_MIN_PLAYERS, x) == R_SSS_INVALID_X );
+	x[1] = 1U;
+	ASSERT( sss_gf256_start_decode(&gfDecode, SLB_SSS_MIN_PLAYERS, x) == R_SSS_IDENTIC_X );
+	ASSERT( sss_gf256_decode(&gfDecode, 1, share_sel, plain2) == R_SSS_NOT_STARTED );
+
+	/* Encode (the shares are written directly to the streams) */
+	for (i = 0; i < n; ++i) {
+		x[i] = (slb_uint8_t)( n - i );
+	}
+	rc = sss_gf256_start_encode( &gfEncode, (slb_uint_t)k, (slb_uint_t)n, x );
+	printf_detail("sss_gf256_start_encode: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	tm_start = time(SLB_NULL);
+	for (offset = 0; (offset < plainsize) && SLB_R_SUCCEEDED(rc); offset += CODING_MAX_CHUNK) {
+		slb_int_t nmb = CODING_MAX_CHUNK;
+		if ( (plainsize - offset) < nmb ) {
+			nmb = plainsize - offset;
+		}
+		for (i = 0; i < n; ++i) {
+			share[i] = &g_stream_mem[i][offset];
+		}
+		rc = sss_gf256_encode( &gfEncode, nmb, &plain[offset], share );
+	}
+	elapsed = (int)( time(SLB_NULL) - tm_start );
+	printf_detail("sss_gf256_encode: rc=0x%04x share bytes=%d\n", rc, plainsize);
+	if (g_measure) {
+		printf("Encode %3d sec,  ", elapsed);
+	}
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Decode with k shares (success) and k - 1 shares (fail) */
+	for (cur_k = k; ( (slb_int_t)SLB_SSS_MIN_PLAYERS <= cur_k ) && ( k - 1 <= cur_k ); --cur_k) {
+		rc = sss_gf256_start_decode( &gfDecode, (slb_uint_t)cur_k, &x[n - cur_k] );
+		printf_detail("sss_gf256_start_decode: k=%d rc=0x%04x\n", cur_k, rc);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+
+		tm_start = time(SLB_NULL);
+		for (offset = 0; (offset < plainsize) && SLB_R_SUCCEEDED(rc); offset += CODING_MAX_CHUNK) {
+			slb_int_t nmb = CODING_MAX_CHUNK;
+			if ( (plainsize - offset) < nmb ) {
+				nmb = plainsize - offset;
+			}
+			for (i = 0; i < cur_k; ++i) {
+				share_sel[i] = &g_stream_mem[n - cur_k + i][offset];
+			}
+			rc = sss_gf256_decode( &gfDecode, nmb, share_sel, &plain2[offset] );
+		}
+		elapsed = (int)( time(SLB_NULL) - tm_start );
+		printf_detail("sss_gf256_decode: rc=0x%04x\n", rc);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+
+		if (cur_k == k) {
+			if (g_measure) {
+				printf("Decode %3d sec\n", elapsed);
+			}
+			ASSERT( memcmp(plain, plain2, (size_t)plainsize) == 0 );
+			printf_detail("plain data matched.\n");
+		}
+		else {
+			ASSERT( memcmp(plain, plain2, (size_t)plainsize) != 0 );
+			printf_detail("plain data unmatched.\n");
+		}
+	}
+
+	/* Close */
+	sss_gf256_close(&gfEncode);
+	sss_gf256_close(&gfDecode);
+
+	/* Free resources */
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+}
+
+/* GF(2^16) field mode
+	Each share value is 16 bits, and the shares are written to the streams by memcpy.
+	The plain data is decoded with the last k shares, and is not decoded with k - 1 shares.
+*/
+void sss_example_gf65536(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k,				/* threshold */
+	slb_bool_t			ssse3,			/* =SLB_TRUE: SSSE3 is used */
+	slb_bool_t			gfni			/* =SLB_TRUE: GFNI is used */
+)
+{
+	SSS_GF65536 gfEncode, gfDecode;
+	SLB_RC rc;
+	slb_int_t i, cur_k;
+	slb_int_t offset;
+	slb_uint16_t u[131], v[131], ref[131], out[131];
+	slb_uint16_t c;
+	slb_uint_t j;
+	const slb_uint16_t edge[8] = { 0U, 1U, 2U, 0xffU, 0x100U, 0x1234U, 0x8000U, SLB_MASK_OF_UINT16 };
+	time_t tm_start;
+	int elapsed;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint16_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * CODING_MAX_CHUNK );
+	}
+
+	/* Set SIMD usage */
+	sss_gf65536_set_simd(ssse3, gfni);
+
+	/* Start message */
+	printf("\n===== GF(2^16) ssse3=%d gfni=%d\n", ssse3, gfni);
+
+	/* Kernel against the scalar kernel (with 0 and 0xffff, and the tail of the SIMD blocks) */
+	for (i = 0; i < 131; ++i) {
+		u[i] = (i % 3 == 0) ? 0U : (i % 3 == 1) ? SLB_MASK_OF_UINT16 : (slb_uint16_t)( ( (slb_uint_t)rand() << 8 ) ^ (slb_uint_t)rand() );
+		v[i] = (i % 4 == 0) ? SLB_MASK_OF_UINT16 : (i % 4 == 1) ? 0U : (slb_uint16_t)( ( (slb_uint_t)rand() << 8 ) ^ (slb_uint_t)rand() );
+	}
+	for (j = 0; j < 72U; ++j) {
+		c = (j < 8U) ? edge[j] : (slb_uint16_t)( ( (slb_uint_t)rand() << 8 ) ^ (slb_uint_t)rand() );
+		sss_gf65536_set_simd(SLB_FALSE, SLB_FALSE);
+		sss_gf65536_mul_region( 131, u, c, v, ref );
+		sss_gf65536_set_simd(ssse3, gfni);
+		sss_gf65536_mul_region( 131, u, c, v, out );
+		ASSERT( memcmp(ref, out, sizeof(out)) == 0 );
+	}
+	for (i = 0; i < 131; ++i) {
+		ASSERT( ref[i] == (slb_uint16_t)( sss_gf65536_mul(u[i], c) ^ v[i] ) );
+	}
+
+	/* Store random values in plain data */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize, plain) );
+
+	/* Open */
+	rc = sss_gf65536_open_as_encode( &gfEncode, (slb_uint_t)k, (slb_uint_t)n, CODING_MAX_CHUNK,
+									 &g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	printf_detail("sss_gf65536_open_as_encode: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	rc = sss_gf65536_open_as_decode( &gfDecode, (slb_uint_t)k, &g_mem_callback_param );
+	printf_detail("sss_gf65536_open_as_decode: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Invalid x coordinates */
+	x[0] = 1U;
+	x[1] = 0U;
+	ASSERT( sss_gf65536_start_decode(&gfDecode, SLB_SSS_MIN_PLAYERS, x) == R_SSS_INVALID_X );
+	x[1] = 1U;
+	ASSERT( sss_gf65536_start_decode(&gfDecode, SLB_SSS_MIN_PLAYERS, x) == R_SSS_IDENTIC_X );
+
+	/* Encode (x coordinates above the range of libslbsss are also available) */
+	for (i = 0; i < n; ++i) {
+		x[i] = (slb_uint16_t)( 0xffffU - (slb_uint_t)i * 0x100U );
+	}
+	rc = sss_gf65536_start_encode( &gfEncode, (slb_uint_t)k, (slb_uint_t)n, x );
+	printf_detail("sss_gf65536_start_encode: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	tm_start = time(SLB_NULL);
+	for (offset = 0; (offset < plainsize) && SLB_R_SUCCEEDED(rc); offset += CODING_MAX_CHUNK) {
+		slb_int_t nmb = CODING_MAX_CHUNK;
+		if ( (plainsize - offset) < nmb ) {
+			nmb = plainsize - offset;
+		}
+		rc = sss_gf65536_encode( &gfEncode, nmb, &plain[offset], share );
+
+		/* Reflect share contents to stream */
+		for (i = 0; i < n; ++i) {
+			memcpy( &g_stream_mem[i][ sizeof(slb_uint16_t) * (slb_uint_t)offset ], share[i], sizeof(slb_uint16_t) * (slb_uint_t)nmb );
+		}
+	}
+	elapsed = (int)( time(SLB_NULL) - tm_start );
+	printf_detail("sss_gf65536_encode: rc=0x%04x share bytes=%d\n", rc, (int)sizeof(slb_uint16_t) * plainsize);
+	if (g_measure) {
+		printf("Encode %3d sec,  ", elapsed);
+	}
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Decode with k shares (success) and k - 1 shares (fail) */
+	for (cur_k = k; ( (slb_int_t)SLB_SSS_MIN_PLAYERS <= cur_k ) && ( k - 1 <= cur_k ); --cur_k) {
+		rc = sss_gf65536_start_decode( &gfDecode, (slb_uint_t)cur_k, &x[n - cur_k] );
+		printf_detail("sss_gf65536_start_decode: k=%d rc=0x%04x\n", cur_k, rc);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+
+		tm_start = time(SLB_NULL);
+		for (offset = 0; (offset < plainsize) && SLB_R_SUCCEEDED(rc); offset += CODING_MAX_CHUNK) {
+			slb_int_t nmb = CODING_MAX_CHUNK;
+			if ( (plainsize - offset) < nmb ) {
+				nmb = plainsize - offset;
+			}
+
+			/* Reflect stream contents to share */
+			for (i = 0; i < cur_k; ++i) {
+				memcpy( share[i], &g_stream_mem[n - cur_k + i][ sizeof(slb_uint16_t) * (slb_uint_t)offset ], sizeof(slb_uint16_t) * (slb_uint_t)nmb );
+			}
+			rc = sss_gf65536_decode( &gfDecode, nmb, (const slb_uint16_t**)share, &plain2[offset] );
+		}
+		elapsed = (int)( time(SLB_NULL) - tm_start );
+		printf_detail("sss_gf65536_decode: rc=0x%04x\n", rc);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+
+		if (cur_k == k) {
+			if (g_measure) {
+				printf("Decode %3d sec\n", elapsed);
+			}
+			ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) == 0 );
+			printf_detail("plain data matched.\n");
+		}
+		else {
+			ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) != 0 );
+			printf_detail("plain data unmatched.\n");
+		}
+	}
+
+	/* Close */
+	sss_gf65536_close(&gfEncode);
+	sss_gf65536_close(&gfDecode);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+
+	slb_free( &g_mem_callback_param, x, SLB_TRUE );
+	slb_free( &g_mem_callback_param, share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+}
+
+/* NTT encoding
+	The shares are written to the streams, and all of them are checked to be on one polynomial
+	by robust decoding. Since the x coordinates are above the range of slb_sss_decode,
+	the plain data is decoded by the Lagrange coefficients at 0 of the last k shares.
+*/
+void sss_example_ntt(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	SSS_NTT ntt;
+	SSS_ROBUST robust;
+	SLB_RC rc;
+	slb_int_t i, j, d;
+	slb_int_t offset;
+	slb_uint_t unmatched = 0;
+	time_t tm_start;
+	int elapsed;
+	double ms, ms_method[2];
+	const slb_int_t nmb_one = ( plainsize < CODING_MAX_CHUNK ) ? plainsize : CODING_MAX_CHUNK;
+
+	/* Allocate resources */
+	slb_uint32_t*const xs = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)k );
+	slb_uint32_t*const lambda = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)k );
+	slb_uint32_t*const lambda2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)k );
+	slb_bool_t*const faulty = slb_alloc( &g_mem_callback_param, sizeof(slb_bool_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	STREAM_BUFF*const stream = slb_alloc( &g_mem_callback_param, sizeof(STREAM_BUFF) * (slb_uint_t)n );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * CODING_MAX_CHUNK );
+	}
+
+	/* Start message */
+	printf("\n===== NTT encoding effective=%d\n", sss_ntt_effective( (slb_uint_t)k, (slb_uint_t)n ));
+
+	/* Store random values in plain data */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize, plain) );
+
+	/* Open */
+	rc = sss_ntt_open( &ntt, (slb_uint_t)k, (slb_uint_t)n, CODING_MAX_CHUNK,
+					   &g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	printf_detail("sss_ntt_open: rc=0x%04x L=%u cosets=%u use_ntt=%d\n", rc, ntt.l, ntt.ncoset, ntt.use_ntt);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	for (i = 0; i < n; ++i) {
+		stream[i].x = ntt.x[i];
+		stream[i].tag_key = 0;
+		stream[i].const_time = g_const_time;
+		stream[i].data = g_stream_mem[i];
+	}
+
+	/* Encode */
+	sss_reset_stream_pos(n, stream);
+	tm_start = time(SLB_NULL);
+	for (offset = 0; (offset < plainsize) && SLB_R_SUCCEEDED(rc); offset += CODING_MAX_CHUNK) {
+		slb_int_t nmb = CODING_MAX_CHUNK;
+		if ( (plainsize - offset) < nmb ) {
+			nmb = plainsize - offset;
+		}
+		rc = sss_ntt_encode( &ntt, nmb, &plain[offset], share );
+		sss_share_to_stream(n, nmb, share, stream);
+	}
+	elapsed = (int)( time(SLB_NULL) - tm_start );
+	printf_detail("sss_ntt_encode: rc=0x%04x\n", rc);
+	if (g_measure) {
+		printf("Encode %3d sec\n", elapsed);
+	}
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Lagrange coefficients of the last k shares and the last k - 1 shares */
+	for (i = 0; i < k; ++i) {
+		xs[i] = ntt.x[n - k + i];
+	}
+	sss_gfp_lagrange( (slb_uint_t)k, xs, 0U, lambda );
+	sss_gfp_lagrange( (slb_uint_t)k - 1U, &xs[1], 0U, lambda2 );
+
+	/* Decode */
+	rc = sss_robust_open( &robust, (slb_uint_t)n, (slb_uint_t)k, ntt.x, CODING_MAX_CHUNK, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	sss_reset_stream_pos(n, stream);
+	for (offset = 0; offset < plainsize; offset += CODING_MAX_CHUNK) {
+		slb_int_t nmb = CODING_MAX_CHUNK;
+		if ( (plainsize - offset) < nmb ) {
+			nmb = plainsize - offset;
+		}
+		ASSERT( sss_stream_to_share(n, nmb, stream, share) );
+
+		/* All shares are on one polynomial of degree k - 1 */
+		ASSERT( sss_robust_check( &robust, nmb, (const slb_uint32_t**)share, faulty ) );
+		for (i = 0; i < n; ++i) {
+			ASSERT( faulty[i] == SLB_FALSE );
+		}
+
+		for (d = 0; d < nmb; ++d) {
+			slb_uint64_t acc = 0U;
+			slb_uint64_t acc2 = 0U;
+			for (i = 0; i < k; ++i) {
+				acc += (slb_uint64_t)lambda[i] * share[n - k + i][d];
+				if (0 < i) {
+					acc2 += (slb_uint64_t)lambda2[i - 1] * share[n - k + i][d];
+				}
+			}
+			ASSERT( sss_gfp_reduce(acc) == plain[offset + d] );
+			if ( sss_gfp_reduce(acc2) != plain[offset + d] ) {
+				++unmatched;
+			}
+		}
+	}
+	printf_detail("plain data matched (k), unmatched %u (k - 1).\n", unmatched);
+	ASSERT( unmatched != 0U );
+
+	/* The other method gives the shares of the same x coordinates */
+	for (i = 0; i < 2; ++i) {
+		ntt.use_ntt = (slb_bool_t)!ntt.use_ntt;
+		ms = sss_clock_ms();
+		rc = sss_ntt_encode( &ntt, nmb_one, plain, share );
+		ms_method[ntt.use_ntt ? 1 : 0] = sss_clock_ms() - ms;
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		ASSERT( sss_robust_check( &robust, nmb_one, (const slb_uint32_t**)share, faulty ) );
+		for (d = 0; d < nmb_one; ++d) {
+			slb_uint64_t acc = 0U;
+			for (j = 0; j < k; ++j) {
+				acc += (slb_uint64_t)lambda[j] * share[n - k + j][d];
+			}
+			ASSERT( sss_gfp_reduce(acc) == plain[d] );
+		}
+	}
+	printf_detail("use_ntt=%d: Horner %.3f ms, NTT %.3f ms (%d words)\n",
+				  ntt.use_ntt, ms_method[0], ms_method[1], nmb_one);
+
+	/* Close */
+	sss_robust_close(&robust);
+	sss_ntt_close(&ntt);
+	ASSERT( sss_ntt_encode( &ntt, nmb_one, plain, share ) == R_INVALID_PARAM );
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+
+	slb_free( &g_mem_callback_param, xs, SLB_TRUE );
+	slb_free( &g_mem_callback_param, lambda, SLB_TRUE );
+	slb_free( &g_mem_callback_param, lambda2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, faulty, SLB_TRUE );
+	slb_free( &g_mem_callback_param, share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, stream, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+}
+
+/* Fast interpolation decoding
+	The shares by NTT encoding are decoded with the first L shares (a whole coset),
+	and with the last k shares by the subproduct tree and directly.
+*/
+void sss_example_interp(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	SSS_NTT ntt;
+	SSS_INTERP interp, interp2;
+	SLB_RC rc;
+	slb_int_t i;
+	slb_int_t offset;
+	const slb_int_t plainsize = CODING_MAX_CHUNK * 4;
+
+	/* Allocate resources */
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+	const slb_uint32_t**const share_sel = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)plainsize );
+	}
+
+	/* Start message */
+	printf("\n===== Interpolation decoding n=%d k=%d\n", n, k);
+
+	/* Store random values in plain data */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize, plain) );
+
+	/* Encode */
+	rc = sss_ntt_open( &ntt, (slb_uint_t)k, (slb_uint_t)n, CODING_MAX_CHUNK,
+					   &g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	for (offset = 0; offset < plainsize; offset += CODING_MAX_CHUNK) {
+		for (i = 0; i < n; ++i) {
+			share_sel[i] = &share[i][offset];
+		}
+		rc = sss_ntt_encode( &ntt, CODING_MAX_CHUNK, &plain[offset], (slb_uint32_t**)share_sel );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+
+	/* Open */
+	rc = sss_interp_open( &interp, (slb_uint_t)n, plainsize, &g_mem_callback_param );
+	printf_detail("sss_interp_open: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_open( &interp2, (slb_uint_t)n, plainsize, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Whole coset */
+	rc = sss_interp_start( &interp, ntt.l, ntt.x, 0U );
+	printf_detail("sss_interp_start: k=%u rc=0x%04x coset=%d\n", ntt.l, rc, interp.coset);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( interp.coset );
+
+	rc = sss_interp_decode( &interp, plainsize, (const slb_uint32_t**)share, plain2 );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) == 0 );
+	printf_detail("plain data matched.\n");
+
+	/* Last k shares (subproduct tree or direct by the threshold, and direct) */
+	for (i = 0; i < k; ++i) {
+		share_sel[i] = share[n - k + i];
+	}
+	rc = sss_interp_start( &interp, (slb_uint_t)k, &ntt.x[n - k], 0U );
+	printf_detail("sss_interp_start: k=%d rc=0x%04x coset=%d tree=%d\n", k, rc, interp.coset, interp.tree);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( interp.coset == SLB_FALSE );
+	ASSERT( interp.tree == ( (slb_uint_t)k >= SSS_INTERP_TREE_MIN_K ) );
+
+	rc = sss_interp_start( &interp2, (slb_uint_t)k, &ntt.x[n - k], SSS_INTERP_MAX_PLAYERS + 1U );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( interp2.tree == SLB_FALSE );
+	ASSERT( memcmp(interp.lambda, interp2.lambda, sizeof(slb_uint32_t) * (slb_uint_t)k) == 0 );
+
+	rc = sss_interp_decode( &interp, plainsize, share_sel, plain2 );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) == 0 );
+	printf_detail("plain data matched.\n");
+
+	/* Last k - 1 shares */
+	rc = sss_interp_start( &interp, (slb_uint_t)k - 1U, &ntt.x[n - k + 1], 0U );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_decode( &interp, plainsize, &share_sel[1], plain2 );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) != 0 );
+	printf_detail("plain data unmatched.\n");
+
+	/* Invalid x coordinates */
+	ntt.x[1] = ntt.x[0];
+	ASSERT( sss_interp_start( &interp, 2U, ntt.x, 0U ) == R_SSS_IDENTIC_X );
+	ntt.x[1] = 0U;
+	ASSERT( sss_interp_start( &interp, 2U, ntt.x, 0U ) == R_SSS_INVALID_X );
+	ASSERT( sss_interp_decode( &interp, plainsize, share_sel, plain2 ) == R_SSS_NOT_STARTED );
+
+	/* Close */
+	sss_interp_close(&interp);
+	sss_interp_close(&interp2);
+	sss_ntt_close(&ntt);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+
+	slb_free( &g_mem_callback_param, share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, (void*)share_sel, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+}
+
+/* GEMM encoding
+	The shares are decoded by slb_sss_decode, so they are in the same format as slb_sss_encode.
+	The products over more than one k-block are checked by fast interpolation decoding.
+*/
+void sss_example_gemm(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	H_SLB_SSS hDecode;
+	SLB_SSS_DECODE_OPEN_PARAM decode_param;
+	SSS_GEMM gemm;
+	SSS_INTERP interp;
+	SLB_RC rc;
+	slb_int_t i;
+	slb_int_t offset;
+	slb_int_t best_nmb;
+	time_t tm_start;
+	int elapsed;
+	const slb_int_t k_large = (slb_int_t)SSS_GEMM_KBLOCK + 4;
+	const slb_int_t nmb_large = 32;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)k_large );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	STREAM_BUFF*const stream = slb_alloc( &g_mem_callback_param, sizeof(STREAM_BUFF) * (slb_uint_t)n );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)k_large );
+
+	for (i = 0; i < k_large; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * CODING_MAX_CHUNK );
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+
+	/* Start message */
+	printf("\n===== GEMM encoding\n");
+
+	/* Store random values in plain data */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize, plain) );
+
+	/* Open as decode (the data is encoded in the units of the decoding) */
+	decode_param.k_max = (slb_uint_t)n;
+	decode_param.mem_param = &g_mem_callback_param;
+	hDecode = slb_sss_open_as_decode(&decode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_decode(hDecode, (slb_uint_t)k, x);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	best_nmb = slb_sss_get_bestnmb(hDecode, CODING_MAX_CHUNK);
+
+	/* Open */
+	rc = sss_gemm_open( &gemm, (slb_uint_t)k_large, (slb_uint_t)k_large, CODING_MAX_CHUNK,
+						&g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	printf_detail("sss_gemm_open: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( sss_gemm_encode( &gemm, best_nmb, plain, share ) == R_SSS_NOT_STARTED );
+
+	/* Invalid x coordinates */
+	x[1] = x[0];
+	ASSERT( sss_gemm_start( &gemm, (slb_uint_t)k, (slb_uint_t)n, x ) == R_SSS_IDENTIC_X );
+	x[1] = 0U;
+	ASSERT( sss_gemm_start( &gemm, (slb_uint_t)k, (slb_uint_t)n, x ) == R_SSS_INVALID_X );
+	x[1] = 2U;
+
+	/* Start encoding */
+	rc = sss_gemm_start( &gemm, (slb_uint_t)k, (slb_uint_t)n, x );
+	printf_detail("sss_gemm_start: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	for (i = 0; i < n; ++i) {
+		stream[i].x = x[i];
+		stream[i].tag_key = 0;
+		stream[i].const_time = g_const_time;
+		stream[i].data = g_stream_mem[i];
+	}
+
+	/* Encode */
+	sss_reset_stream_pos(n, stream);
+	tm_start = time(SLB_NULL);
+	for (offset = 0; (offset < plainsize) && SLB_R_SUCCEEDED(rc); offset += best_nmb) {
+		slb_int_t nmb = best_nmb;
+		if ( (plainsize - offset) < nmb ) {
+			nmb = plainsize - offset;
+		}
+		rc = sss_gemm_encode( &gemm, nmb, &plain[offset], share );
+		sss_share_to_stream(n, nmb, share, stream);
+	}
+	elapsed = (int)( time(SLB_NULL) - tm_start );
+	printf_detail("sss_gemm_encode: rc=0x%04x\n", rc);
+	if (g_measure) {
+		printf("Encode %3d sec,  ", elapsed);
+	}
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Decode by libslbsss */
+	sss_example_decode( hDecode, plainsize, n, k, plain, stream, SLB_TRUE, SLB_TRUE );
+	if ( (g_measure == SLB_FALSE) && ((slb_int_t)SLB_SSS_MIN_PLAYERS < k) ) {
+		sss_example_decode( hDecode, plainsize, n, k - 1, plain, stream, SLB_FALSE, SLB_TRUE );
+	}
+
+	/* More than one k-block */
+	if (g_measure == SLB_FALSE) {
+		slb_uint16_t plain2[32];
+
+		rc = sss_gemm_start( &gemm, (slb_uint_t)k_large, (slb_uint_t)k_large, x );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = sss_gemm_encode( &gemm, nmb_large, plain, share );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+
+		rc = sss_interp_open( &interp, (slb_uint_t)k_large, nmb_large, &g_mem_callback_param );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = sss_interp_start( &interp, (slb_uint_t)k_large, x, 0U );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = sss_interp_decode( &interp, nmb_large, (const slb_uint32_t**)share, plain2 );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)nmb_large) == 0 );
+		printf_detail("plain data matched (k=%d).\n", k_large);
+		sss_interp_close(&interp);
+	}
+
+	/* Close */
+	sss_gemm_close(&gemm);
+	slb_sss_close(hDecode);
+
+	/* Free resources */
+	for (i = 0; i < k_large; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+
+	slb_free( &g_mem_callback_param, share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, stream, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_TRUE );
+}
+
+/* Encode plan
+	Two GEMM encoding handles share one encode plan, and the shares of each handle
+	are decoded by slb_sss_decode. Then many small secrets are encoded with
+	sss_gemm_start for each secret and with the shared plan, to show the setup cost.
+*/
+void sss_example_plan(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	H_SLB_SSS hDecode;
+	SLB_SSS_DECODE_OPEN_PARAM decode_param;
+	SSS_ENCODE_PLAN plan;
+	SSS_GEMM gemm[2];
+	SLB_RC rc;
+	slb_int_t i, h, s;
+	slb_int_t offset;
+	slb_int_t best_nmb;
+	double clk_start;
+	double ms_start, ms_plan;
+	const slb_int_t secrets = 1000;
+	const slb_int_t secret_nmb = 16;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	STREAM_BUFF*const stream = slb_alloc( &g_mem_callback_param, sizeof(STREAM_BUFF) * (slb_uint_t)n );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * CODING_MAX_CHUNK );
+		x[i] = (slb_uint16_t)( n - i );
+	}
+
+	/* Start message */
+	printf("\n===== Encode plan\n");
+
+	/* Build */
+	x[1] = x[0];
+	ASSERT( sss_plan_build( &plan, (slb_uint_t)k, (slb_uint_t)n, x, &g_mem_callback_param ) == R_SSS_IDENTIC_X );
+	x[1] = (slb_uint16_t)( n - 1 );
+	rc = sss_plan_build( &plan, (slb_uint_t)k, (slb_uint_t)n, x, &g_mem_callback_param );
+	printf_detail("sss_plan_build: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Open as decode */
+	decode_param.k_max = (slb_uint_t)n;
+	decode_param.mem_param = &g_mem_callback_param;
+	hDecode = slb_sss_open_as_decode(&decode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_decode(hDecode, (slb_uint_t)k, x);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	best_nmb = slb_sss_get_bestnmb(hDecode, CODING_MAX_CHUNK);
+
+	for (i = 0; i < n; ++i) {
+		stream[i].x = x[i];
+		stream[i].tag_key = 0;
+		stream[i].const_time = g_const_time;
+		stream[i].data = g_stream_mem[i];
+	}
+
+	/* Encode by the handles sharing the plan */
+	for (h = 0; h < 2; ++h) {
+		rc = sss_gemm_open( &gemm[h], (slb_uint_t)k, (slb_uint_t)n, CODING_MAX_CHUNK,
+							&g_mem_callback_param, rand_callback, &g_rand_callback_param );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = sss_gemm_start_plan( &gemm[h], &plan );
+		printf_detail("sss_gemm_start_plan: rc=0x%04x\n", rc);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+
+	for (h = 0; h < 2; ++h) {
+		ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize, plain) );
+
+		sss_reset_stream_pos(n, stream);
+		for (offset = 0; (offset < plainsize) && SLB_R_SUCCEEDED(rc); offset += best_nmb) {
+			slb_int_t nmb = best_nmb;
+			if ( (plainsize - offset) < nmb ) {
+				nmb = plainsize - offset;
+			}
+			rc = sss_gemm_encode( &gemm[h], nmb, &plain[offset], share );
+			sss_share_to_stream(n, nmb, share, stream);
+		}
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+
+		sss_example_decode( hDecode, plainsize, n, k, plain, stream, SLB_TRUE, SLB_TRUE );
+	}
+
+	/* Small secrets (sss_gemm_start for each secret) */
+	clk_start = sss_clock_ms();
+	for (s = 0; s < secrets; ++s) {
+		rc = sss_gemm_start( &gemm[0], (slb_uint_t)k, (slb_uint_t)n, x );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = sss_gemm_encode( &gemm[0], secret_nmb, &plain[s % (plainsize - secret_nmb)], share );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+	ms_start = sss_clock_ms() - clk_start;
+
+	/* Small secrets (shared plan) */
+	clk_start = sss_clock_ms();
+	for (s = 0; s < secrets; ++s) {
+		rc = sss_gemm_encode( &gemm[1], secret_nmb, &plain[s % (plainsize - secret_nmb)], share );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+	ms_plan = sss_clock_ms() - clk_start;
+	printf_detail("%d secrets of %d data: start each %.1f ms, shared plan %.1f ms\n",
+					secrets, secret_nmb, ms_start, ms_plan);
+
+	/* Close */
+	sss_gemm_close(&gemm[0]);
+	sss_gemm_close(&gemm[1]);
+	sss_plan_free(&plan);
+	slb_sss_close(hDecode);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+
+	slb_free( &g_mem_callback_param, share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, stream, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_TRUE );
+}
+
+/* Packed secret sharing
+	The plain data is encoded by GEMM encoding with a packed plan, and each share is 1/l of the
+	plain data. The last k + l - 1 shares give the plain data, and k + l - 2 shares do not.
+	The first row of each chunk is also decoded by slb_sss_decode with the threshold k + l - 1.
+*/
+void sss_example_packed(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k,				/* privacy threshold */
+	slb_int_t			l				/* number of plain data of a polynomial */
+)
+{
+	H_SLB_SSS hDecode;
+	SLB_SSS_DECODE_OPEN_PARAM decode_param;
+	SSS_ENCODE_PLAN plan;
+	SSS_GEMM gemm;
+	SSS_PACKED packed;
+	SLB_RC rc;
+	slb_int_t i;
+	slb_int_t offset;
+	const slb_int_t m = k + l - 1;
+	const slb_int_t chunk = CODING_MAX_CHUNK * l;
+	const slb_int_t padded = ( plainsize + chunk - 1 ) / chunk * chunk;
+	const slb_int_t sharesize = padded / l;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)padded );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)padded );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+	const slb_uint32_t**const share_sel = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)sharesize );
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+
+	/* Start message */
+	printf("\n===== Packed secret sharing k=%d l=%d\n", k, l);
+	printf_detail("plain data %d, share %d x %d\n", padded, sharesize, n);
+
+	/* Store random values in plain data */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)padded, plain) );
+
+	/* Build */
+	rc = sss_plan_build_packed( &plan, (slb_uint_t)k, (slb_uint_t)l, (slb_uint_t)n, x, &g_mem_callback_param );
+	printf_detail("sss_plan_build_packed: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Encode */
+	rc = sss_gemm_open( &gemm, (slb_uint_t)m, (slb_uint_t)n, CODING_MAX_CHUNK,
+						&g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_gemm_start_plan( &gemm, &plan );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	for (offset = 0; offset < sharesize; offset += CODING_MAX_CHUNK) {
+		for (i = 0; i < n; ++i) {
+			share_sel[i] = &share[i][offset];
+		}
+		rc = sss_gemm_encode( &gemm, CODING_MAX_CHUNK, &plain[offset * l], (slb_uint32_t**)share_sel );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+	printf_detail("sss_gemm_encode: rc=0x%04x\n", rc);
+
+	/* Decode (last k + l - 1 shares) */
+	rc = sss_packed_open( &packed, (slb_uint_t)k, (slb_uint_t)l, CODING_MAX_CHUNK, &g_mem_callback_param );
+	printf_detail("sss_packed_open: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_packed_start( &packed, (slb_uint_t)k, (slb_uint_t)l, &x[n - m] );
+	printf_detail("sss_packed_start: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	for (offset = 0; offset < sharesize; offset += CODING_MAX_CHUNK) {
+		for (i = 0; i < m; ++i) {
+			share_sel[i] = &share[n - m + i][offset];
+		}
+		rc = sss_packed_decode( &packed, CODING_MAX_CHUNK, share_sel, &plain2[offset * l] );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+	ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)padded) == 0 );
+	printf_detail("plain data matched.\n");
+
+	/* Decode (last k + l - 2 shares as the privacy threshold k - 1) */
+	rc = sss_packed_start( &packed, (slb_uint_t)k - 1U, (slb_uint_t)l, &x[n - m + 1] );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	for (i = 0; i < m - 1; ++i) {
+		share_sel[i] = share[n - m + 1 + i];
+	}
+	rc = sss_packed_decode( &packed, CODING_MAX_CHUNK, share_sel, plain2 );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * CODING_MAX_CHUNK * (slb_uint_t)l) != 0 );
+	printf_detail("plain data unmatched.\n");
+
+	/* Decode the first rows by libslbsss */
+	decode_param.k_max = (slb_uint_t)n;
+	decode_param.mem_param = &g_mem_callback_param;
+	hDecode = slb_sss_open_as_decode(&decode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_decode(hDecode, (slb_uint_t)m, &x[n - m]);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	for (offset = 0; offset < sharesize; offset += CODING_MAX_CHUNK) {
+		for (i = 0; i < m; ++i) {
+			share_sel[i] = &share[n - m + i][offset];
+		}
+		rc = slb_sss_decode( hDecode, CODING_MAX_CHUNK, share_sel, plain2 );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		ASSERT( memcmp(&plain[offset * l], plain2, sizeof(slb_uint16_t) * CODING_MAX_CHUNK) == 0 );
+	}
+	printf_detail("first rows matched (slb_sss_decode).\n");
+
+	/* Invalid x coordinates */
+	x[n - 1] = x[n - 2];
+	ASSERT( sss_packed_start( &packed, (slb_uint_t)k, (slb_uint_t)l, &x[n - m] ) == R_SSS_IDENTIC_X );
+	x[n - 1] = 0U;
+	ASSERT( sss_packed_start( &packed, (slb_uint_t)k, (slb_uint_t)l, &x[n - m] ) == R_SSS_INVALID_X );
+	ASSERT( sss_packed_decode( &packed, CODING_MAX_CHUNK, share_sel, plain2 ) == R_SSS_NOT_STARTED );
+
+	/* Close */
+	slb_sss_close(hDecode);
+	sss_packed_close(&packed);
+	sss_gemm_close(&gemm);
+	sss_plan_free(&plan);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+
+	slb_free( &g_mem_callback_param, share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, (void*)share_sel, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_TRUE );
+}
+
+/* Decode resource
+	The resource is saved to the file and mapped, and the inverses are checked.
+	A corrupt file is not mapped, and the resource is built instead.
+*/
+void sss_example_res(void)
+{
+	static const char bad_file[] = DECODE_RES_FILE ".bad";
+	slb_uint32_t a;
+	double clk_start;
+	double ms_build, ms_map;
+	FILE* fp;
+	SLB_RC rc;
+
+	/* Start message */
+	printf("\n===== Decode resource\n");
+
+	/* Build */
+	sss_res_release();
+	clk_start = sss_clock_ms();
+	rc = sss_res_prepare();
+	ms_build = sss_clock_ms() - clk_start;
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( sss_res_is_mapped() == SLB_FALSE );
+
+	/* Save and map */
+	rc = sss_res_save(DECODE_RES_FILE);
+	printf_detail("sss_res_save: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	sss_res_release();
+	clk_start = sss_clock_ms();
+	rc = sss_res_map(DECODE_RES_FILE);
+	ms_map = sss_clock_ms() - clk_start;
+	printf_detail("sss_res_map: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( sss_res_is_mapped() );
+	printf_detail("build %.2f ms, map (with checksum) %.2f ms\n", ms_build, ms_map);
+
+	for (a = 1; a < SSS_GFP_PRIME; a += 97U) {
+		ASSERT( SSS_GFP_MUL( a, sss_gfp_inv(a) ) == 1U );
+	}
+	ASSERT( sss_gfp_inv(SSS_GFP_PRIME - 1U) == SSS_GFP_PRIME - 1U );
+
+	/* Corrupt file */
+	fp = fopen(bad_file, "wb");
+	ASSERT( fp != SLB_NULL );
+	{
+		SSS_RES_HEADER header;
+		memset(&header, 0, sizeof(header));
+		memcpy( header.magic, SSS_RES_MAGIC, sizeof(header.magic) );
+		ASSERT( fwrite(&header, sizeof(header), 1, fp) == 1 );
+		for (a = 0; a < SSS_RES_COUNT; ++a) {
+			ASSERT( fwrite(&a, sizeof(a), 1, fp) == 1 );
+		}
+	}
+	fclose(fp);
+
+	sss_res_release();
+	rc = sss_res_map(bad_file);
+	printf_detail("sss_res_map (corrupt): rc=0x%04x\n", rc);
+	ASSERT( rc == R_SSS_NOT_INIT );
+	ASSERT( sss_res_map("") == R_SSS_NOT_INIT );
+	ASSERT( sss_res_save("") == R_SSS_RES_IO );
+	remove(bad_file);
+
+	/* Built (without it, the inverse is the exponentiation) */
+	ASSERT( SSS_GFP_MUL( 12345U, sss_gfp_inv(12345U) ) == 1U );
+	ASSERT( SLB_R_SUCCEEDED( sss_res_prepare() ) );
+	ASSERT( sss_res_is_mapped() == SLB_FALSE );
+	ASSERT( SSS_GFP_MUL( 12345U, sss_gfp_inv(12345U) ) == 1U );
+
+	/* Map again for the following examples */
+	sss_res_release();
+	ASSERT( SLB_R_SUCCEEDED( sss_res_map(DECODE_RES_FILE) ) );
+}
+
+/* Step encoding/decoding
+	The plain data is encoded and decoded by steps with the time budget, as in an event loop.
+	The loop counts the steps, and each step must return for the loop to continue.
+*/
+void sss_example_step(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	H_SLB_SSS hEncode, hDecode;
+	SLB_SSS_ENCODE_OPEN_PARAM encode_param;
+	SLB_SSS_DECODE_OPEN_PARAM decode_param;
+	SSS_STEP step;
+	SLB_RC rc;
+	slb_int_t i;
+	slb_int_t progress, last;
+	slb_int_t best_nmb;
+	slb_uint_t steps;
+	const slb_uint64_t budget_ns = 2000000U;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)plainsize );
+	}
+
+	/* Start message */
+	printf("\n===== Step encoding/decoding budget=%u ns\n", (slb_uint_t)budget_ns);
+
+	/* Open and start */
+	encode_param.k_max = (slb_uint_t)k;
+	encode_param.n_max = (slb_uint_t)n;
+	encode_param.mem_param = &g_mem_callback_param;
+	encode_param.rand_func = rand_callback;
+	encode_param.rand_param = &g_rand_callback_param;
+	hEncode = slb_sss_open_as_encode(&encode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_encode(hEncode, (slb_uint_t)k, (slb_uint_t)n, SLB_FALSE, x);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	best_nmb = slb_sss_get_bestnmb(hEncode, CODING_MAX_CHUNK);
+
+	decode_param.k_max = (slb_uint_t)k;
+	decode_param.mem_param = &g_mem_callback_param;
+	hDecode = slb_sss_open_as_decode(&decode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_decode(hDecode, (slb_uint_t)k, &x[n - k]);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	rc = slb_sss_rand(hEncode, (slb_uint_t)plainsize, plain);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Encode by steps */
+	rc = sss_step_open_encode( &step, hEncode, (slb_uint_t)n, plainsize, plain, share, best_nmb, &g_mem_callback_param );
+	printf_detail("sss_step_open_encode: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	steps = 0;
+	last = 0;
+	do {
+		rc = sss_step_run( &step, budget_ns, &progress );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		ASSERT( last < progress );
+		last = progress;
+		++steps;
+	} while (rc != R_COMPLETE);
+	ASSERT( progress == plainsize );
+	ASSERT( sss_step_run( &step, budget_ns, &progress ) == R_COMPLETE );
+	sss_step_close(&step);
+	printf_detail("encoded by %u steps\n", steps);
+
+	/* Decode by steps (budget 0: one chunk per step) */
+	rc = sss_step_open_decode( &step, hDecode, (slb_uint_t)k, plainsize, (const slb_uint32_t**)&share[n - k], plain2,
+							   best_nmb, &g_mem_callback_param );
+	printf_detail("sss_step_open_decode: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	steps = 0;
+	do {
+		rc = sss_step_run( &step, 0U, &progress );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		++steps;
+	} while (rc != R_COMPLETE);
+	sss_step_close(&step);
+	printf_detail("decoded by %u steps\n", steps);
+	ASSERT( steps == (slb_uint_t)( ( plainsize + best_nmb - 1 ) / best_nmb ) );
+	ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) == 0 );
+	printf_detail("plain data matched.\n");
+
+	/* Closed step */
+	ASSERT( sss_step_run( &step, budget_ns, &progress ) == R_INVALID_HANDLE );
+
+	/* Close SSS control handles */
+	slb_sss_close(hEncode);
+	slb_sss_close(hDecode);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+
+	slb_free( &g_mem_callback_param, share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_TRUE );
+}
+
+/* Online decoding
+	The shares arrive one by one in a random order, and the plain data is ready at the k-th share.
+	The time of the last share is compared with the decoding of the k shares by libslbsss.
+*/
+void sss_example_online(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	H_SLB_SSS hEncode, hDecode;
+	SLB_SSS_ENCODE_OPEN_PARAM encode_param;
+	SLB_SSS_DECODE_OPEN_PARAM decode_param;
+	SSS_STEP step;
+	SSS_ONLINE online;
+	SLB_RC rc;
+	slb_int_t i, j;
+	double clk_start;
+	double ms_last = 0.0;
+	double ms_decode;
+	const slb_int_t plainsize = CODING_MAX_CHUNK * 16;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const x_sel = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)k );
+	slb_int_t*const order = slb_alloc( &g_mem_callback_param, sizeof(slb_int_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+	slb_uint32_t**const share_sel = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)k );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)plainsize );
+		order[i] = i;
+	}
+
+	/* Start message */
+	printf("\n===== Online decoding\n");
+
+	/* Encode with random x coordinates */
+	encode_param.k_max = (slb_uint_t)k;
+	encode_param.n_max = (slb_uint_t)n;
+	encode_param.mem_param = &g_mem_callback_param;
+	encode_param.rand_func = rand_callback;
+	encode_param.rand_param = &g_rand_callback_param;
+	hEncode = slb_sss_open_as_encode(&encode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	sss_get_random_x(hEncode, n, x);
+	rc = slb_sss_start_encode(hEncode, (slb_uint_t)k, (slb_uint_t)n, SLB_TRUE, x);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_rand(hEncode, (slb_uint_t)plainsize, plain);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	rc = sss_step_open_encode( &step, hEncode, (slb_uint_t)n, plainsize, plain, share, CODING_MAX_CHUNK, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( sss_step_run( &step, SLB_ULLONG_MAX, SLB_NULL ) == R_COMPLETE );
+	sss_step_close(&step);
+
+	/* Arrival order */
+	for (i = n - 1; 0 < i; --i) {
+		const slb_int_t r = rand() % (i + 1);
+		const slb_int_t t = order[i];
+		order[i] = order[r];
+		order[r] = t;
+	}
+
+	/* Open and start */
+	rc = sss_online_open( &online, (slb_uint_t)n, plainsize, &g_mem_callback_param );
+	printf_detail("sss_online_open: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( sss_online_add( &online, x[0], share[0], plain2 ) == R_SSS_NOT_STARTED );
+	rc = sss_online_start( &online, (slb_uint_t)k, (slb_uint_t)n, x, plainsize );
+	printf_detail("sss_online_start: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Shares arrive */
+	for (i = 0; i < k; ++i) {
+		j = order[i];
+		x_sel[i] = x[j];
+		share_sel[i] = share[j];
+
+		clk_start = sss_clock_ms();
+		rc = sss_online_add( &online, x[j], share[j], plain2 );
+		ms_last = sss_clock_ms() - clk_start;
+
+		if (i < k - 1) {
+			ASSERT( rc == R_SUCCESS );
+			if (i == 0) {
+				ASSERT( sss_online_add( &online, x[j], share[j], plain2 ) == R_SSS_IDENTIC_X );
+			}
+		}
+		else {
+			ASSERT( rc == R_COMPLETE );
+		}
+	}
+	ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) == 0 );
+	printf_detail("plain data matched.\n");
+	ASSERT( sss_online_add( &online, x[order[k]], share[order[k]], plain2 ) == R_SSS_NOT_STARTED );
+
+	/* Unknown x coordinate */
+	rc = sss_online_start( &online, (slb_uint_t)k, (slb_uint_t)n - 1U, x, plainsize );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( sss_online_add( &online, x[n - 1], share[n - 1], plain2 ) == R_SSS_INVALID_X );
+
+	/* Decoding by libslbsss after all the shares */
+	decode_param.k_max = (slb_uint_t)k;
+	decode_param.mem_param = &g_mem_callback_param;
+	hDecode = slb_sss_open_as_decode(&decode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	clk_start = sss_clock_ms();
+	rc = slb_sss_start_decode(hDecode, (slb_uint_t)k, x_sel);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_step_open_decode( &step, hDecode, (slb_uint_t)k, plainsize, (const slb_uint32_t**)share_sel, plain2,
+							   CODING_MAX_CHUNK, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( sss_step_run( &step, SLB_ULLONG_MAX, SLB_NULL ) == R_COMPLETE );
+	ms_decode = sss_clock_ms() - clk_start;
+	sss_step_close(&step);
+	ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) == 0 );
+	printf_detail("after the last share: online %.2f ms, slb_sss_decode %.2f ms\n", ms_last, ms_decode);
+
+	/* Close */
+	sss_online_close(&online);
+	slb_sss_close(hEncode);
+	slb_sss_close(hDecode);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+
+	slb_free( &g_mem_callback_param, share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, share_sel, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, order, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x_sel, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_TRUE );
+}
+
+/* Partial reconstruction
+	Each holder of the chosen k shares scales its share by the exported coefficient, and
+	the partials are summed in a reduction tree, as a local stand-in for the nodes.
+	The kernels of each SIMD are checked against the scalar values, including 65536.
+*/
+void sss_example_partial(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k,				/* threshold */
+	slb_bool_t			avx2,			/* =SLB_TRUE: AVX2 is used */
+	slb_bool_t			avx512			/* =SLB_TRUE: AVX-512 is used */
+)
+{
+	H_SLB_SSS hEncode;
+	SLB_SSS_ENCODE_OPEN_PARAM encode_param;
+	SSS_STEP step;
+	SSS_INTERP interp;
+	SLB_RC rc;
+	slb_int_t i, stride;
+	slb_uint_t c;
+	slb_uint32_t y[37], z[37];
+	const slb_uint32_t lambdas[3] = { 1U, SSS_GFP_PRIME - 1U, 12345U };
+	const slb_int_t plainsize = CODING_MAX_CHUNK * 4;
+	const slb_int_t sel = ( 2 * k - 1 <= n ) ? 2 : 1;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const x_sel = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)k );
+	slb_uint32_t*const lambda = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)k );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+	slb_uint32_t**const partial = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)k );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)plainsize );
+	}
+	for (i = 0; i < k; ++i) {
+		partial[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)plainsize );
+	}
+
+	/* Start message */
+	printf("\n===== Partial reconstruction avx2=%d avx512=%d\n", avx2, avx512);
+	sss_partial_set_simd(avx2, avx512);
+
+	/* Kernels */
+	for (i = 0; i < 37; ++i) {
+		y[i] = (i % 5 == 0) ? SSS_GFP_PRIME - 1U : (slb_uint32_t)rand() % SSS_GFP_PRIME;
+	}
+	for (c = 0; c < 3U; ++c) {
+		sss_partial_scale( 37, y, lambdas[c], z );
+		for (i = 0; i < 37; ++i) {
+			ASSERT( z[i] == SSS_GFP_MUL(y[i], lambdas[c]) );
+		}
+	}
+	memcpy(z, y, sizeof(z));
+	sss_partial_add( 37, z, y );
+	for (i = 0; i < 37; ++i) {
+		ASSERT( z[i] == SSS_GFP_ADD(y[i], y[i]) );
+	}
+
+	/* Encode */
+	encode_param.k_max = (slb_uint_t)k;
+	encode_param.n_max = (slb_uint_t)n;
+	encode_param.mem_param = &g_mem_callback_param;
+	encode_param.rand_func = rand_callback;
+	encode_param.rand_param = &g_rand_callback_param;
+	hEncode = slb_sss_open_as_encode(&encode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_encode(hEncode, (slb_uint_t)k, (slb_uint_t)n, SLB_FALSE, x);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_rand(hEncode, (slb_uint_t)plainsize, plain);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_step_open_encode( &step, hEncode, (slb_uint_t)n, plainsize, plain, share, CODING_MAX_CHUNK, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( sss_step_run( &step, SLB_ULLONG_MAX, SLB_NULL ) == R_COMPLETE );
+	sss_step_close(&step);
+
+	/* Export coefficients of every other share (if enough) */
+	for (i = 0; i < k; ++i) {
+		x_sel[i] = x[sel * i];
+	}
+	rc = sss_partial_coef( (slb_uint_t)k, x_sel, lambda, &g_mem_callback_param );
+	printf_detail("sss_partial_coef: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	rc = sss_interp_open( &interp, (slb_uint_t)k, plainsize, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_start( &interp, (slb_uint_t)k, x_sel, 0U );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( memcmp(interp.lambda, lambda, sizeof(slb_uint32_t) * (slb_uint_t)k) == 0 );
+	sss_interp_close(&interp);
+
+	/* Holders */
+	for (i = 0; i < k; ++i) {
+		sss_partial_scale( plainsize, share[sel * i], lambda[i], partial[i] );
+	}
+
+	/* Reduction tree */
+	for (stride = 1; stride < k; stride *= 2) {
+		for (i = 0; i + stride < k; i += 2 * stride) {
+			sss_partial_add( plainsize, partial[i], partial[i + stride] );
+		}
+	}
+	sss_partial_to_plain( plainsize, partial[0], plain2 );
+	ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)plainsize) == 0 );
+	printf_detail("plain data matched.\n");
+
+	/* Invalid x coordinates */
+	x_sel[1] = x_sel[0];
+	ASSERT( sss_partial_coef( (slb_uint_t)k, x_sel, lambda, &g_mem_callback_param ) == R_SSS_IDENTIC_X );
+	x_sel[1] = 0U;
+	ASSERT( sss_partial_coef( (slb_uint_t)k, x_sel, lambda, &g_mem_callback_param ) == R_SSS_INVALID_X );
+
+	/* Close SSS control handle */
+	slb_sss_close(hEncode);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+	for (i = 0; i < k; ++i) {
+		slb_free( &g_mem_callback_param, partial[i], SLB_TRUE );
+	}
+
+	slb_free( &g_mem_callback_param, share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, partial, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, lambda, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x_sel, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_TRUE );
+}
+
+/* Byte API
+	The plain bytes of odd length are encoded by GEMM encoding and decoded by
+	interpolation decoding without an intermediate buffer of 16-bit words.
+*/
+void sss_example_bytes(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k,				/* threshold */
+	slb_bool_t			avx2			/* =SLB_TRUE: AVX2 is used */
+)
+{
+	SSS_GEMM gemm;
+	SSS_INTERP interp;
+	SLB_RC rc;
+	slb_int_t i, len, nmb;
+	double clk_start;
+	double ms_bytes, ms_words;
+	const slb_int_t len_max = CODING_MAX_CHUNK * 2 - 45;	/* odd */
+	const slb_int_t loop = 200;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint8_t*const bytes = slb_alloc( &g_mem_callback_param, (slb_uint_t)len_max + 1U );
+	slb_uint8_t*const bytes2 = slb_alloc( &g_mem_callback_param, (slb_uint_t)len_max + 1U );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * CODING_MAX_CHUNK );
+	slb_uint32_t*const words = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * CODING_MAX_CHUNK );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * CODING_MAX_CHUNK );
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+
+	/* Start message */
+	printf("\n===== Byte API (%s)\n", avx2 ? "AVX2" : "no SIMD");
+	sss_bytes_set_simd(avx2);
+
+	/* Store random values in plain bytes */
+	ASSERT( rand_callback(&g_rand_callback_param, (slb_uint_t)len_max, bytes) );
+
+	/* Byte order of all lengths of the SIMD loop and the tail */
+	for (len = 1; len <= 80; ++len) {
+		memset( bytes2, 0xa5, (slb_uint_t)len + 1U );
+		sss_bytes_load( len, bytes, words );
+		for (i = 0; i < len / 2; ++i) {
+			ASSERT( words[i] == ( ( (slb_uint32_t)bytes[2 * i] << 8 ) | bytes[2 * i + 1] ) );
+		}
+		if (len % 2 != 0) {
+			ASSERT( words[len / 2] == ( (slb_uint32_t)bytes[len - 1] << 8 ) );
+		}
+		sss_bytes_store( len, words, bytes2 );
+		ASSERT( memcmp(bytes, bytes2, (slb_uint_t)len) == 0 );
+		ASSERT( bytes2[len] == 0xa5 );
+	}
+	printf_detail("byte order matched.\n");
+
+	/* Open and start */
+	rc = sss_gemm_open( &gemm, (slb_uint_t)k, (slb_uint_t)n, CODING_MAX_CHUNK,
+						&g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( sss_gemm_encode_bytes( &gemm, len_max, bytes, &nmb, share ) == R_SSS_NOT_STARTED );
+	rc = sss_gemm_start( &gemm, (slb_uint_t)k, (slb_uint_t)n, x );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_open( &interp, (slb_uint_t)k, CODING_MAX_CHUNK, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_start( &interp, (slb_uint_t)k, &x[n - k], 0U );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Invalid parameters */
+	ASSERT( sss_gemm_encode_bytes( &gemm, 0, bytes, &nmb, share ) == R_INVALID_PARAM );
+	ASSERT( sss_gemm_encode_bytes( &gemm, CODING_MAX_CHUNK * 2 + 1, bytes, &nmb, share ) == R_INVALID_PARAM );
+	ASSERT( sss_interp_decode_bytes( &interp, CODING_MAX_CHUNK * 2 + 1, (const slb_uint32_t**)share, bytes2 ) == R_INVALID_PARAM );
+
+	/* Encode bytes, and decode as 16-bit words and as bytes */
+	rc = sss_gemm_encode_bytes( &gemm, len_max, bytes, &nmb, share );
+	printf_detail("sss_gemm_encode_bytes: rc=0x%04x, nmb=%d\n", rc, nmb);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( nmb == SSS_BYTES_WORDS(len_max) );
+
+	rc = sss_interp_decode( &interp, nmb, (const slb_uint32_t**)&share[n - k], plain );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	sss_bytes_load( len_max, bytes, words );
+	for (i = 0; i < nmb; ++i) {
+		ASSERT( plain[i] == words[i] );
+	}
+
+	memset( bytes2, 0xa5, (slb_uint_t)len_max + 1U );
+	rc = sss_interp_decode_bytes( &interp, len_max, (const slb_uint32_t**)&share[n - k], bytes2 );
+	printf_detail("sss_interp_decode_bytes: rc=0x%04x\n", rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( memcmp(bytes, bytes2, (slb_uint_t)len_max) == 0 );
+	ASSERT( bytes2[len_max] == 0xa5 );
+	printf_detail("plain bytes matched (%d bytes).\n", len_max);
+
+	/* Compare with the byte swap into 16-bit words and the padding */
+	clk_start = sss_clock_ms();
+	for (i = 0; i < loop; ++i) {
+		rc = sss_gemm_encode_bytes( &gemm, len_max, bytes, &nmb, share );
+	}
+	ms_bytes = sss_clock_ms() - clk_start;
+	clk_start = sss_clock_ms();
+	for (i = 0; i < loop; ++i) {
+		slb_int_t d;
+		for (d = 0; d + 1 < len_max; d += 2) {
+			plain[d / 2] = (slb_uint16_t)( ( bytes[d] << 8 ) | bytes[d + 1] );
+		}
+		plain[d / 2] = (slb_uint16_t)( bytes[d] << 8 );
+		rc = sss_gemm_encode( &gemm, nmb, plain, share );
+	}
+	ms_words = sss_clock_ms() - clk_start;
+	printf_detail("encode %d x %d bytes: bytes %.1f ms, swap and words %.1f ms\n", loop, len_max, ms_bytes, ms_words);
+
+	/* Close */
+	sss_interp_close(&interp);
+	sss_gemm_close(&gemm);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+	slb_free( &g_mem_callback_param, share, SLB_FALSE );
+	slb_free( &g_mem_callback_param, words, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, bytes2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, bytes, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_FALSE );
+}
+
+/* Secure wipe
+	The close/reopen of an online decoding handle is timed with each wipe policy.
+*/
+void sss_example_wipe(
+	slb_int_t			n,				/* number of shares */
+	slb_bool_t			avx2			/* =SLB_TRUE: AVX2 is used */
+)
+{
+	SSS_ONLINE online;
+	SLB_RC rc;
+	slb_uint_t i;
+	double clk_start;
+	double ms_lib, ms_all, ms_plain;
+	const slb_uint_t size[] = { 1U, 31U, 4096U + 3U, SSS_WIPE_NT_MIN + 45U };
+	const slb_int_t nmb = 0x10000;
+	const slb_int_t loop = 20;
+
+	/* Allocate resources */
+	slb_uint8_t*const mem = slb_alloc( &g_mem_callback_param, SSS_WIPE_NT_MIN + 64U );
+
+	/* Start message */
+	printf("\n===== Secure wipe (%s)\n", avx2 ? "AVX2" : "no SIMD");
+	sss_wipe_set_simd(avx2);
+
+	/* Unaligned regions, and the non-temporal stores */
+	for (i = 0; i < sizeof(size) / sizeof(size[0]); ++i) {
+		memset( mem, 0xa5, SSS_WIPE_NT_MIN + 64U );
+		sss_wipe( &mem[i + 1U], size[i] );
+		ASSERT( is_mem_cleared( &mem[i + 1U], size[i] ) );
+		ASSERT( ( mem[i] == 0xa5 ) && ( mem[i + 1U + size[i]] == 0xa5 ) );
+	}
+	printf_detail("regions cleared.\n");
+
+	/* Policy: share buffers are optional */
+	memset( mem, 0xa5, 64U );
+	sss_wipe_set_policy(SLB_FALSE);
+	sss_wipe_class( SSS_WIPE_SHARE, mem, 64U );
+	ASSERT( mem[0] == 0xa5 );
+	sss_wipe_class( SSS_WIPE_PLAIN, mem, 32U );
+	sss_wipe_class( SSS_WIPE_COEF, &mem[32], 32U );
+	ASSERT( is_mem_cleared( mem, 64U ) );
+	sss_wipe_set_policy(SLB_TRUE);
+	sss_wipe_class( SSS_WIPE_SHARE, mem, 64U );
+	printf_detail("policy matched.\n");
+
+	/* Close/reopen: the library clear, the wipe of all classes, and of plain data only */
+	clk_start = sss_clock_ms();
+	for (i = 0; i < (slb_uint_t)loop; ++i) {
+		slb_uint32_t*const value = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)n * (slb_uint_t)nmb );
+		ASSERT( value != SLB_NULL );
+		value[0] = 1U;
+		slb_free( &g_mem_callback_param, value, SLB_TRUE );
+	}
+	ms_lib = sss_clock_ms() - clk_start;
+
+	clk_start = sss_clock_ms();
+	for (i = 0; i < (slb_uint_t)loop; ++i) {
+		rc = sss_online_open( &online, (slb_uint_t)n, nmb, &g_mem_callback_param );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		sss_online_close(&online);
+	}
+	ms_all = sss_clock_ms() - clk_start;
+
+	sss_wipe_set_policy(SLB_FALSE);
+	clk_start = sss_clock_ms();
+	for (i = 0; i < (slb_uint_t)loop; ++i) {
+		rc = sss_online_open( &online, (slb_uint_t)n, nmb, &g_mem_callback_param );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		sss_online_close(&online);
+	}
+	ms_plain = sss_clock_ms() - clk_start;
+	sss_wipe_set_policy(SLB_TRUE);
+
+	printf_detail("close/reopen %d x %d KB: slb_free %.1f ms, wipe all %.1f ms, wipe plain %.1f ms\n",
+				  loop, n * nmb * 4 / 1024, ms_lib, ms_all, ms_plain);
+
+	/* Free resources */
+	slb_free( &g_mem_callback_param, mem, SLB_FALSE );
+}
+
+/* Pool allocator
+	The open/close cycles of the handles are run with the pool and with the malloc callbacks.
+	No other memory of libslbsss is freed while the pool is configured.
+*/
+void sss_example_pool(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	SSS_POOL_STAT stat, stat2;
+	SSS_TEAM team;
+	slb_uint8_t* mem[4];
+	slb_uint_t i;
+	double ms_pool, ms_malloc;
+	const slb_int_t loop = 200;
+
+	/* Start message */
+	printf("\n===== Pool allocator\n");
+
+	slb_config(sss_pool_alloc, sss_pool_free);
+	sss_pool_init( SSS_POOL_LOCK | SSS_POOL_HUGE );
+
+	/* Size classes: a freed block is reused by the same class */
+	for (i = 0; i < 4U; ++i) {
+		mem[i] = slb_alloc( &g_mem_callback_param, 100U << ( i * 6U ) );
+		ASSERT( mem[i] != SLB_NULL );
+		memset( mem[i], 0xa5, 100U << ( i * 6U ) );
+	}
+	for (i = 0; i < 4U; ++i) {
+		slb_free( &g_mem_callback_param, mem[i], SLB_TRUE );
+	}
+	for (i = 0; i < 4U; ++i) {
+		slb_uint8_t*const mem2 = slb_alloc( &g_mem_callback_param, ( 100U << ( i * 6U ) ) - 4U );
+		ASSERT( mem2 == mem[i] );
+		slb_free( &g_mem_callback_param, mem2, SLB_FALSE );
+	}
+
+	/* A block freed without the clearing is wiped by the pool (except the link of the list) */
+	mem[0] = slb_alloc( &g_mem_callback_param, 1000U );
+	ASSERT( mem[0] != SLB_NULL );
+	memset( mem[0], 0x5a, 1000U );
+	slb_free( &g_mem_callback_param, mem[0], SLB_FALSE );
+	mem[1] = slb_alloc( &g_mem_callback_param, 1000U );
+	ASSERT( mem[1] == mem[0] );
+	ASSERT( is_mem_cleared( mem[1] + sizeof(void*), 1000U - sizeof(void*) ) );
+	slb_free( &g_mem_callback_param, mem[1], SLB_FALSE );
+
+	/* The caches of the workers are returned when the threads exit */
+	sss_pool_get_stat(&stat);
+	ASSERT( SLB_R_SUCCEEDED( sss_team_open( &team, 4U, SLB_TRUE, SLB_FALSE ) ) );
+	ASSERT( SLB_R_SUCCEEDED( sss_team_run( &team, pool_task, SLB_NULL, 4, 1 ) ) );
+	i = team.nthread;
+	sss_team_close(&team);
+	sss_pool_get_stat(&stat2);
+	printf_detail("blocks flushed at the thread exit: %u\n", (slb_uint_t)( stat2.flushed - stat.flushed ));
+	ASSERT( stat2.flushed - stat.flushed == (slb_uint64_t)( POOL_TASK_BLOCKS * ( i - 1U ) ) );
+
+	/* Open/close cycles (the regions are mapped by the first cycle only) */
+	pool_cycle( n, k, 1 );
+	sss_pool_get_stat(&stat);
+	ms_pool = pool_cycle( n, k, loop );
+	sss_pool_get_stat(&stat2);
+	printf_detail("regions %u (locked %u, huge %u), %u KB, system calls %u\n", stat2.regions, stat2.locked,
+				  stat2.huge, (slb_uint_t)( stat2.mapped / 1024U ), (slb_uint_t)stat2.system_calls);
+	ASSERT( stat2.system_calls == stat.system_calls );
+
+	/* malloc callbacks */
+	slb_config(alloc_callback, free_callback);
+	ms_malloc = pool_cycle( n, k, loop );
+	printf_detail("open/encode/decode/close %d cycles: pool %.1f ms, malloc %.1f ms\n", loop, ms_pool, ms_malloc);
+
+	sss_pool_release();
+	sss_pool_get_stat(&stat);
+	ASSERT( stat.regions == 0U );
+}
+
+/* Allocates and frees blocks in the cache of a worker thread */
+void pool_task(void* param, slb_uint_t thread, slb_int_t start, slb_int_t end)
+{
+	void* mem[POOL_TASK_BLOCKS];
+	slb_uint_t i;
+
+	(void)param;
+	(void)start;
+	(void)end;
+
+	if (thread == 0U) {
+		return;
+	}
+	for (i = 0; i < POOL_TASK_BLOCKS; ++i) {
+		mem[i] = sss_pool_alloc( SLB_NULL, 256U );
+		ASSERT( mem[i] != SLB_NULL );
+	}
+	for (i = 0; i < POOL_TASK_BLOCKS; ++i) {
+		sss_pool_free( SLB_NULL, mem[i], 256U, SLB_FALSE );
+	}
+}
+
+/* Runs open/encode/decode/close cycles, and returns the time in ms */
+double pool_cycle(slb_int_t n, slb_int_t k, slb_int_t loop)
+{
+	H_SLB_SSS hEncode, hDecode;
+	SLB_SSS_ENCODE_OPEN_PARAM encode_param;
+	SLB_SSS_DECODE_OPEN_PARAM decode_param;
+	SLB_RC rc;
+	slb_int_t i, j;
+	slb_uint16_t x[MAX_PLAYERS];
+	slb_uint16_t plain[CODING_MAX_CHUNK];
+	slb_uint16_t plain2[CODING_MAX_CHUNK];
+	double clk_start;
+
+	for (i = 0; i < n; ++i) {
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(plain), plain) );
+
+	encode_param.k_max = (slb_uint_t)k;
+	encode_param.n_max = (slb_uint_t)n;
+	encode_param.mem_param = &g_mem_callback_param;
+	encode_param.rand_func = rand_callback;
+	encode_param.rand_param = &g_rand_callback_param;
+	decode_param.k_max = (slb_uint_t)k;
+	decode_param.mem_param = &g_mem_callback_param;
+
+	clk_start = sss_clock_ms();
+	for (j = 0; j < loop; ++j) {
+		slb_uint32_t** share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+		ASSERT( share != SLB_NULL );
+		for (i = 0; i < n; ++i) {
+			share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * CODING_MAX_CHUNK );
+			ASSERT( share[i] != SLB_NULL );
+		}
+
+		hEncode = slb_sss_open_as_encode(&encode_param, &rc);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = slb_sss_start_encode(hEncode, (slb_uint_t)k, (slb_uint_t)n, SLB_TRUE, x);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = slb_sss_encode(hEncode, CODING_MAX_CHUNK, plain, share);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		slb_sss_close(hEncode);
+
+		hDecode = slb_sss_open_as_decode(&decode_param, &rc);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = slb_sss_start_decode(hDecode, (slb_uint_t)k, x);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = slb_sss_decode(hDecode, CODING_MAX_CHUNK, (const slb_uint32_t**)share, plain2);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		ASSERT( memcmp(plain, plain2, sizeof(plain)) == 0 );
+		slb_sss_close(hDecode);
+
+		for (i = 0; i < n; ++i) {
+			slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+		}
+		slb_free( &g_mem_callback_param, share, SLB_FALSE );
+	}
+	return sss_clock_ms() - clk_start;
+}
+
+/* Extended memory management callback
+	The buffers of the modules are counted for each usage, and the alignment is checked.
+*/
+void sss_example_mem(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	SSS_GEMM gemm;
+	SSS_INTERP interp;
+	SSS_ONLINE online;
+	SSS_ENCODE_PLAN plan;
+	SLB_RC rc;
+	slb_int_t i;
+	slb_uint_t u;
+	static const char*const usage_name[] = { "plain", "share", "coef", "table" };
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * CODING_MAX_CHUNK );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * CODING_MAX_CHUNK );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * CODING_MAX_CHUNK );
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+
+	/* Start message */
+	printf("\n===== Extended memory management callback\n");
+
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * CODING_MAX_CHUNK, plain) );
+	memset( g_alloc2_size, 0, sizeof(g_alloc2_size) );
+	memset( g_alloc2_peak, 0, sizeof(g_alloc2_peak) );
+	sss_mem_config(alloc2_callback, free2_callback);
+
+	/* Open the modules */
+	rc = sss_gemm_open( &gemm, (slb_uint_t)k, (slb_uint_t)n, CODING_MAX_CHUNK,
+						&g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( ( (size_t)gemm.coef % SSS_MEM_ALIGN ) == 0U );
+	rc = sss_interp_open( &interp, (slb_uint_t)k, CODING_MAX_CHUNK, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( ( (size_t)interp.acc % SSS_MEM_ALIGN ) == 0U );
+	rc = sss_online_open( &online, (slb_uint_t)n, plainsize, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_plan_build( &plan, (slb_uint_t)k, (slb_uint_t)n, x, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Encode and decode */
+	rc = sss_gemm_start_plan( &gemm, &plan );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_gemm_encode( &gemm, CODING_MAX_CHUNK, plain, share );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_start( &interp, (slb_uint_t)k, x, 0U );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_decode( &interp, CODING_MAX_CHUNK, (const slb_uint32_t**)share, plain2 );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * CODING_MAX_CHUNK) == 0 );
+	printf_detail("plain data matched.\n");
+
+	/* Close (the wiped buffers are not cleared again) */
+	sss_plan_free(&plan);
+	sss_online_close(&online);
+	sss_interp_close(&interp);
+	sss_gemm_close(&gemm);
+	for (u = 0; u < 4U; ++u) {
+		printf_detail("%-5s: peak %7u bytes\n", usage_name[u], g_alloc2_peak[u]);
+		ASSERT( g_alloc2_size[u] == 0U );
+	}
+	ASSERT( ( g_alloc2_peak[SSS_MEM_PLAIN] != 0U ) && ( g_alloc2_peak[SSS_MEM_SHARE] != 0U ) &&
+			( g_alloc2_peak[SSS_MEM_COEF] != 0U ) && ( g_alloc2_peak[SSS_MEM_TABLE] != 0U ) );
+
+	sss_mem_config(SLB_NULL, SLB_NULL);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+	slb_free( &g_mem_callback_param, share, SLB_FALSE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_FALSE );
+}
+
+/* Chunk size tuning
+	The plain data is encoded by chunks of CODING_MAX_CHUNK and by the tuned chunks.
+*/
+void sss_example_tune(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	H_SLB_SSS hEncode, hDecode;
+	SLB_SSS_ENCODE_OPEN_PARAM encode_param;
+	SLB_SSS_DECODE_OPEN_PARAM decode_param;
+	SSS_TUNE tune;
+	SLB_RC rc;
+	slb_int_t i, r, offset, nmb, hint;
+	double clk_start;
+	double ms_fixed, ms_tuned;
+	const slb_int_t maxnmb = 8192;
+	const slb_int_t round = 4;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * CODING_MAX_CHUNK );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+	slb_uint32_t**const chunk = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)plainsize );
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+
+	/* Start message */
+	printf("\n===== Chunk size tuning\n");
+	printf_detail("cache: L1 %u KB, L2 %u KB, L3 %u KB\n", GetCacheSize(1U) / 1024U, GetCacheSize(2U) / 1024U, GetCacheSize(3U) / 1024U);
+
+	/* Open and start */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize, plain) );
+	encode_param.k_max = (slb_uint_t)k;
+	encode_param.n_max = (slb_uint_t)n;
+	encode_param.mem_param = &g_mem_callback_param;
+	encode_param.rand_func = rand_callback;
+	encode_param.rand_param = &g_rand_callback_param;
+	hEncode = slb_sss_open_as_encode(&encode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_encode(hEncode, (slb_uint_t)k, (slb_uint_t)n, SLB_TRUE, x);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	hint = slb_sss_get_bestnmb(hEncode, maxnmb);
+	sss_tune_start( &tune, (slb_uint_t)k, (slb_uint_t)n, maxnmb, hint );
+	printf_detail("model nmb=%d, slb_sss_get_bestnmb=%d\n", sss_tune_model( (slb_uint_t)k, (slb_uint_t)n, maxnmb ), hint);
+
+	/* Chunks of CODING_MAX_CHUNK */
+	clk_start = sss_clock_ms();
+	for (r = 0; r < round; ++r) {
+		for (offset = 0; offset < plainsize; offset += nmb) {
+			nmb = ( plainsize - offset < CODING_MAX_CHUNK ) ? plainsize - offset : CODING_MAX_CHUNK;
+			for (i = 0; i < n; ++i) {
+				chunk[i] = &share[i][offset];
+			}
+			rc = slb_sss_encode(hEncode, nmb, &plain[offset], chunk);
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+		}
+	}
+	ms_fixed = sss_clock_ms() - clk_start;
+
+	/* Tuned chunks (the candidates are timed in the first round) */
+	clk_start = sss_clock_ms();
+	for (r = 0; r < round; ++r) {
+		for (offset = 0; offset < plainsize; offset += nmb) {
+			nmb = sss_tune_begin(&tune);
+			if (plainsize - offset < nmb) {
+				nmb = plainsize - offset;
+			}
+			for (i = 0; i < n; ++i) {
+				chunk[i] = &share[i][offset];
+			}
+			rc = slb_sss_encode(hEncode, nmb, &plain[offset], chunk);
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+			sss_tune_end( &tune, nmb );
+		}
+	}
+	ms_tuned = sss_clock_ms() - clk_start;
+	ASSERT( tune.ncand <= tune.cur );
+	for (i = 0; i < (slb_int_t)tune.ncand; ++i) {
+		printf_detail("nmb=%5d: %.2f ns per data\n", tune.cand[i], tune.ns[i]);
+	}
+	printf_detail("encode %d x %d: nmb=%d %.1f ms, tuned nmb=%d %.1f ms\n",
+				  round, plainsize, CODING_MAX_CHUNK, ms_fixed, tune.nmb, ms_tuned);
+
+	/* Decode the shares of the tuned chunks */
+	decode_param.k_max = (slb_uint_t)k;
+	decode_param.mem_param = &g_mem_callback_param;
+	hDecode = slb_sss_open_as_decode(&decode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_decode(hDecode, (slb_uint_t)k, &x[n - k]);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	for (offset = 0; offset < plainsize; offset += CODING_MAX_CHUNK) {
+		nmb = ( plainsize - offset < CODING_MAX_CHUNK ) ? plainsize - offset : CODING_MAX_CHUNK;
+		for (i = 0; i < k; ++i) {
+			chunk[i] = &share[n - k + i][offset];
+		}
+		rc = slb_sss_decode(hDecode, nmb, (const slb_uint32_t**)chunk, plain2);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		ASSERT( memcmp(&plain[offset], plain2, sizeof(slb_uint16_t) * (slb_uint_t)nmb) == 0 );
+	}
+	printf_detail("plain data matched.\n");
+
+	/* Close */
+	slb_sss_close(hDecode);
+	slb_sss_close(hEncode);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_FALSE );
+	}
+	slb_free( &g_mem_callback_param, chunk, SLB_FALSE );
+	slb_free( &g_mem_callback_param, share, SLB_FALSE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_FALSE );
+}
+
+/* CPU topology
+	Reads the topology of the system, and checks the selection and the partition
+	with a mock sysfs of a hybrid CPU (4 P-cores with 2 threads and 4 E-cores).
+*/
+void sss_example_topo(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	H_SLB_SSS hEncode;
+	SLB_SSS_ENCODE_OPEN_PARAM encode_param;
+	SSS_TOPO topo;
+	SLB_RC rc;
+	slb_uint_t index[SSS_TOPO_MAX_CPUS];
+	slb_int_t start[SSS_TOPO_MAX_CPUS + 1U];
+	slb_uint_t count, t;
+	slb_int_t i, r;
+	double ms_start, ms[2];
+	const slb_int_t round = 4;
+#if defined(__GNUC__)
+	char mock[] = "/tmp/sss_topo_XXXXXX";
+#endif
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)plainsize );
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+
+	/* Start message */
+	printf("\n===== CPU topology\n");
+
+	/* Topology of the system */
+	rc = sss_topo_read( &topo, SLB_NULL );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( (0U < topo.physical) && (topo.physical <= topo.logical) && (0U < topo.classes) );
+	printf_detail("system: %u logical CPUs, %u physical cores, %u classes\n", topo.logical, topo.physical, topo.classes);
+	count = sss_topo_select( &topo, SLB_TRUE, SSS_TOPO_MAX_CPUS, index );
+	ASSERT( count == topo.physical );
+
+#if defined(__GNUC__)
+	/* Mock sysfs: CPUs 0 to 7 are 4 P-cores with 2 threads, and CPUs 8 to 11 are E-cores */
+	ASSERT( mkdtemp(mock) != SLB_NULL );
+	ASSERT( topo_mock( mock, SLB_TRUE ) );
+	rc = sss_topo_read( &topo, mock );
+	ASSERT( topo_mock( mock, SLB_FALSE ) );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( (topo.logical == 12U) && (topo.physical == 8U) && (topo.classes == 2U) );
+	ASSERT( (topo.core[0] == topo.core[4]) && (topo.thread[0] == 0U) && (topo.thread[4] == 1U) );
+
+	count = sss_topo_select( &topo, SLB_FALSE, SSS_TOPO_MAX_CPUS, index );
+	ASSERT( count == 12U );
+	count = sss_topo_select( &topo, SLB_TRUE, SSS_TOPO_MAX_CPUS, index );
+	ASSERT( count == 8U );
+	for (t = 0; t < count; ++t) {
+		ASSERT( topo.cpu[index[t]] == ( (t < 4U) ? t : t + 4U ) );
+	}
+
+	sss_topo_partition( &topo, count, index, 65536, 64, start );
+	for (t = 0; t < count; ++t) {
+		ASSERT( start[t + 1U] - start[t] == ( (t < 4U) ? 10240 : 6144 ) );
+		ASSERT( start[t] % 64 == 0 );
+	}
+	ASSERT( start[count] == 65536 );
+	printf_detail("mock: 12 logical CPUs, 8 physical cores, P-core 10240 and E-core 6144 of 65536 data\n");
+#endif
+
+	/* Pin to the first CPU, and unpin */
+	rc = sss_topo_read( &topo, SLB_NULL );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( SLB_R_SUCCEEDED( sss_topo_pin( topo.cpu[0] ) ) );
+	ASSERT( SLB_R_SUCCEEDED( sss_topo_pin( SSS_TOPO_ANY ) ) );
+
+	/* Threads of libslbsss: all logical CPUs, and one per physical core */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize, plain) );
+	encode_param.k_max = (slb_uint_t)k;
+	encode_param.n_max = (slb_uint_t)n;
+	encode_param.mem_param = &g_mem_callback_param;
+	encode_param.rand_func = rand_callback;
+	encode_param.rand_param = &g_rand_callback_param;
+	hEncode = slb_sss_open_as_encode(&encode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_encode(hEncode, (slb_uint_t)k, (slb_uint_t)n, SLB_TRUE, x);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	for (t = 0; t < 2U; ++t) {
+		sss_topo_set_mp( &topo, ( t == 1U ) ? SLB_TRUE : SLB_FALSE );
+		ms_start = sss_clock_ms();
+		for (r = 0; r < round; ++r) {
+			rc = slb_sss_encode(hEncode, plainsize, plain, share);
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+		}
+		ms[t] = sss_clock_ms() - ms_start;
+	}
+	slb_sss_set_mp( MP_OMP, 0 );
+	printf_detail("encode %d x %d: %u threads %.1f ms, %u threads %.1f ms\n",
+				  round, plainsize, topo.logical, ms[0], topo.physical, ms[1]);
+
+	/* Close */
+	slb_sss_close(hEncode);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_FALSE );
+	}
+	slb_free( &g_mem_callback_param, share, SLB_FALSE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_FALSE );
+}
+
+#if defined(__GNUC__)
+/* Creates or removes a mock sysfs of sss_topo_read
+	The root is an empty directory made by the caller (mkdtemp), and is removed with the mock.
+*/
+slb_bool_t topo_mock(const char* root, slb_bool_t create)
+{
+	static const char* const dir[] = { "", "/topology", "/cpufreq" };
+	static const char* const file[] = { "topology/physical_package_id", "topology/core_id", "cpufreq/cpuinfo_max_freq" };
+	char path[256];
+	FILE* fp;
+	slb_uint_t cpu, i, value;
+	slb_bool_t ok = SLB_TRUE;
+
+	sprintf(path, "%s/online", root);
+	if (create) {
+		if ( ( fp = fopen(path, "w") ) == SLB_NULL ) {
+			return SLB_FALSE;
+		}
+		fprintf(fp, "0-11\n");
+		fclose(fp);
+	}
+	else {
+		remove(path);
+	}
+
+	for (cpu = 0; cpu < 12U; ++cpu) {
+		for (i = 0; create && (i < 3U); ++i) {
+			sprintf(path, "%s/cpu%u%s", root, cpu, dir[i]);
+			ok &= ( mkdir(path, 0755) == 0 ) ? SLB_TRUE : SLB_FALSE;
+		}
+		for (i = 0; i < 3U; ++i) {
+			sprintf(path, "%s/cpu%u/%s", root, cpu, file[i]);
+			if (create) {
+				value = ( i == 0U ) ? 0U : ( i == 1U ) ? ( ( cpu < 8U ) ? cpu % 4U : cpu ) : ( ( cpu < 8U ) ? 5000000U : 3000000U );
+				if ( ( fp = fopen(path, "w") ) == SLB_NULL ) {
+					return SLB_FALSE;
+				}
+				fprintf(fp, "%u\n", value);
+				fclose(fp);
+			}
+			else {
+				remove(path);
+			}
+		}
+		for (i = 3U; !create && (0U < i); --i) {
+			sprintf(path, "%s/cpu%u%s", root, cpu, dir[i - 1U]);
+			ok &= ( remove(path) == 0 ) ? SLB_TRUE : SLB_FALSE;
+		}
+	}
+	if (!create) {
+		ok &= ( remove(root) == 0 ) ? SLB_TRUE : SLB_FALSE;
+	}
+	return ok;
+}
+#endif
+
+/* Thread team
+	Measures the dispatch latency of a team, and decodes chunks of 4 to 64 KB
+	with the threads of a team, each with its own interpolation decoding handle.
+*/
+void sss_example_team(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	H_SLB_SSS hEncode, hDecode;
+	SLB_SSS_ENCODE_OPEN_PARAM encode_param;
+	SLB_SSS_DECODE_OPEN_PARAM decode_param;
+	SSS_TEAM team;
+	SSS_INTERP interp[SSS_TEAM_MAX_THREADS];
+	TEAM_DECODE_PARAM param;
+	SLB_RC rc;
+	slb_uint_t t, nthread;
+	slb_int_t i, c, r, nmb;
+	double start, ms_omp, ms_team;
+	const slb_int_t maxnmb = 32768;		/* 64 KB */
+	const slb_int_t round = 200;
+	const slb_int_t runs = 10000;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)maxnmb );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)maxnmb );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)maxnmb );
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+
+	/* Start message */
+	printf("\n===== Thread team\n");
+
+	/* Open a team (at least 4 threads, so that the workers run on any PC) */
+	rc = sss_team_open( &team, 0U, SLB_TRUE, SLB_FALSE );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	nthread = team.nthread;
+	if (nthread < 4U) {
+		sss_team_close(&team);
+		rc = sss_team_open( &team, 4U, SLB_TRUE, SLB_FALSE );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+	nthread = team.nthread;
+	printf_detail("%u threads (%u logical CPUs), spin %u\n", nthread, team.topo.logical, team.spin);
+
+	/* Dispatch latency */
+	start = sss_clock_ms();
+	for (r = 0; r < runs; ++r) {
+		rc = sss_team_run( &team, team_empty_task, SLB_NULL, (slb_int_t)nthread, 1 );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+	printf_detail("dispatch: %.2f us per task\n", ( sss_clock_ms() - start ) * 1000.0 / (double)runs);
+
+	/* Encode */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)maxnmb, plain) );
+	encode_param.k_max = (slb_uint_t)k;
+	encode_param.n_max = (slb_uint_t)n;
+	encode_param.mem_param = &g_mem_callback_param;
+	encode_param.rand_func = rand_callback;
+	encode_param.rand_param = &g_rand_callback_param;
+	hEncode = slb_sss_open_as_encode(&encode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_encode(hEncode, (slb_uint_t)k, (slb_uint_t)n, SLB_TRUE, x);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_encode(hEncode, maxnmb, plain, share);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Decode handles */
+	decode_param.k_max = (slb_uint_t)k;
+	decode_param.mem_param = &g_mem_callback_param;
+	hDecode = slb_sss_open_as_decode(&decode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_decode(hDecode, (slb_uint_t)k, &x[n - k]);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	for (t = 0; t < nthread; ++t) {
+		rc = sss_interp_open( &interp[t], (slb_uint_t)k, maxnmb, &g_mem_callback_param );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = sss_interp_start( &interp[t], (slb_uint_t)k, &x[n - k], 0U );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+	param.interp = interp;
+	param.k = k;
+	param.share = (const slb_uint32_t**)&share[n - k];
+	param.plain = plain2;
+
+	/* Chunks of 4, 16 and 64 KB */
+	for (nmb = 2048; nmb <= maxnmb; nmb *= 4) {
+		start = sss_clock_ms();
+		for (r = 0; r < round; ++r) {
+			rc = slb_sss_decode(hDecode, nmb, (const slb_uint32_t**)&share[n - k], plain2);
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+		}
+		ms_omp = sss_clock_ms() - start;
+		ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)nmb) == 0 );
+
+		memset( plain2, 0, sizeof(slb_uint16_t) * (slb_uint_t)nmb );
+		start = sss_clock_ms();
+		for (r = 0; r < round; ++r) {
+			param.rc = R_SUCCESS;
+			rc = sss_team_run( &team, team_decode_task, &param, nmb, 64 );
+			ASSERT( SLB_R_SUCCEEDED(rc) && SLB_R_SUCCEEDED(param.rc) );
+		}
+		ms_team = sss_clock_ms() - start;
+		ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)nmb) == 0 );
+
+		c = nmb * 2 / 1024;
+		printf_detail("%2d KB: slb_sss_decode (MP_OMP) %.1f us, team %.1f us\n",
+					  c, ms_omp * 1000.0 / round, ms_team * 1000.0 / round);
+	}
+	printf_detail("plain data matched.\n");
+
+	/* Close */
+	for (t = 0; t < nthread; ++t) {
+		sss_interp_close(&interp[t]);
+	}
+	sss_team_close(&team);
+	slb_sss_close(hDecode);
+	slb_sss_close(hEncode);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_FALSE );
+	}
+	slb_free( &g_mem_callback_param, share, SLB_FALSE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_FALSE );
+}
+
+/* Task of a team: nothing */
+void team_empty_task(void* param, slb_uint_t thread, slb_int_t start, slb_int_t end)
+{
+	(void)param;
+	(void)thread;
+	(void)start;
+	(void)end;
+}
+
+/* Task of a team: decodes a partition with the handle of the thread */
+void team_decode_task(void* p, slb_uint_t thread, slb_int_t start, slb_int_t end)
+{
+	TEAM_DECODE_PARAM*const param = (TEAM_DECODE_PARAM*)p;
+	const slb_uint32_t* part[MAX_PLAYERS];
+	slb_int_t i;
+	SLB_RC rc;
+
+	for (i = 0; i < param->k; ++i) {
+		part[i] = &param->share[i][start];
+	}
+	rc = sss_interp_decode( &param->interp[thread], end - start, part, &param->plain[start] );
+	if ( SLB_R_FAILED(rc) ) {
+		param->rc = rc;
+	}
+}
+
+
+/* Metrics
+	Counts GEMM encoding, interpolation decoding, wiping and a thread team,
+	and writes the metrics in the Prometheus text format and JSON.
+*/
+void sss_example_metrics(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	SSS_GEMM gemm;
+	SSS_NTT ntt;
+	SSS_INTERP interp;
+	SSS_TEAM team;
+	SSS_METRICS_SNAPSHOT snap;
+	SLB_RC rc;
+	slb_int_t i, r, len;
+	slb_uint64_t start;
+	char* text;
+	const slb_int_t nmb = CODING_MAX_CHUNK;
+	const slb_int_t round = 10;
+	const slb_int_t calls = 1000000;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)nmb );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)nmb );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)nmb );
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+
+	/* Start message */
+	printf("\n===== Metrics\n");
+	sss_metrics_reset();
+
+	/* Encode and decode */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)nmb, plain) );
+	rc = sss_gemm_open( &gemm, (slb_uint_t)k, (slb_uint_t)n, nmb, &g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_gemm_start( &gemm, (slb_uint_t)k, (slb_uint_t)n, x );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_open( &interp, (slb_uint_t)k, nmb, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_start( &interp, (slb_uint_t)k, &x[n - k], 0U );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	for (r = 0; r < round; ++r) {
+		rc = sss_gemm_encode( &gemm, nmb, plain, share );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = sss_interp_decode( &interp, nmb, (const slb_uint32_t**)&share[n - k], plain2 );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)nmb) == 0 );
+	}
+	sss_interp_close(&interp);
+	sss_gemm_close(&gemm);
+
+	/* Counters of the threads of a team are summed */
+	rc = sss_team_open( &team, 4U, SLB_TRUE, SLB_FALSE );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	for (r = 0; r < round; ++r) {
+		rc = sss_team_run( &team, metrics_task, SLB_NULL, 4096, 64 );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+	sss_team_close(&team);
+
+	sss_metrics_snapshot(&snap);
+	ASSERT( snap.counter[SSS_METRIC_ENCODE_CALLS] == (slb_uint64_t)round );
+	ASSERT( snap.counter[SSS_METRIC_ENCODE_BYTES] == sizeof(slb_uint16_t) * (slb_uint64_t)( round * nmb ) );
+	ASSERT( snap.counter[SSS_METRIC_DECODE_CALLS] == (slb_uint64_t)round );
+	ASSERT( snap.counter[SSS_METRIC_DECODE_BYTES] == sizeof(slb_uint16_t) * (slb_uint64_t)( round * nmb ) );
+	ASSERT( snap.counter[SSS_METRIC_SIMD_NONE] + snap.counter[SSS_METRIC_SIMD_AVX2] + snap.counter[SSS_METRIC_SIMD_AVX512]
+			== 2U * (slb_uint64_t)round );
+	ASSERT( snap.counter[SSS_METRIC_RNG_BYTES] == sizeof(slb_uint64_t) * (slb_uint64_t)( round * nmb * ( k - 1 ) ) );
+	ASSERT( 0U < snap.counter[SSS_METRIC_WIPE_BYTES] );
+	ASSERT( snap.counter[SSS_METRIC_PARALLEL_REGIONS] == (slb_uint64_t)( round * 4097 ) );
+	for (i = 0; i < (slb_int_t)SSS_METRICS_BUCKETS; ++i) {
+		r = (slb_int_t)( snap.bucket[SSS_METRIC_OP_ENCODE][i] + snap.bucket[SSS_METRIC_OP_DECODE][i] );
+		len = ( i == 0 ) ? r : len + r;
+	}
+	ASSERT( len == 2 * round );
+
+	/* Export */
+	len = sss_metrics_export( &snap, SSS_METRICS_PROMETHEUS, SLB_NULL, 0 );
+	text = slb_alloc( &g_mem_callback_param, (slb_uint_t)len + 1U );
+	ASSERT( sss_metrics_export( &snap, SSS_METRICS_PROMETHEUS, text, len + 1 ) == len );
+	ASSERT( strstr(text, "sss_encode_calls_total 10\n") != SLB_NULL );
+	ASSERT( strstr(text, "sss_latency_seconds_count{op=\"decode\"} 10\n") != SLB_NULL );
+	printf_detail("Prometheus: %d bytes\n", len);
+	slb_free( &g_mem_callback_param, text, SLB_FALSE );
+
+	len = sss_metrics_export( &snap, SSS_METRICS_JSON, SLB_NULL, 0 );
+	text = slb_alloc( &g_mem_callback_param, (slb_uint_t)len + 1U );
+	ASSERT( sss_metrics_export( &snap, SSS_METRICS_JSON, text, len + 1 ) == len );
+	ASSERT( sss_metrics_export( &snap, SSS_METRICS_JSON, text, 16 ) == len );
+	ASSERT( strlen(text) == 15U );
+	ASSERT( sss_metrics_export( &snap, SSS_METRICS_JSON, text, len + 1 ) == len );
+	printf_detail("JSON: %s", text);
+	slb_free( &g_mem_callback_param, text, SLB_FALSE );
+
+	/* The SIMD level is of the kernel run (less than 4 shares of GEMM, and Horner of NTT, are scalar) */
+	sss_metrics_reset();
+	rc = sss_gemm_open( &gemm, 2U, 3U, nmb, &g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_gemm_start( &gemm, 2U, 3U, x );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( SLB_R_SUCCEEDED( sss_gemm_encode( &gemm, nmb, plain, share ) ) );
+	sss_gemm_close(&gemm);
+	rc = sss_ntt_open( &ntt, 2U, 3U, nmb, &g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ntt.use_ntt = SLB_FALSE;
+	ASSERT( SLB_R_SUCCEEDED( sss_ntt_encode( &ntt, nmb, plain, share ) ) );
+	sss_ntt_close(&ntt);
+	sss_metrics_snapshot(&snap);
+	ASSERT( snap.counter[SSS_METRIC_SIMD_NONE] == 2U );
+
+	/* Cost of counting a call */
+	start = sss_clock_ns();
+	for (r = 0; r < calls; ++r) {
+		sss_metrics_call( SSS_METRIC_OP_ENCODE, 2U, SSS_METRIC_SIMD_NONE, start );
+	}
+	printf_detail("sss_metrics_call: %.1f ns\n", (double)( sss_clock_ns() - start ) / (double)calls);
+	sss_metrics_reset();
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_FALSE );
+	}
+	slb_free( &g_mem_callback_param, share, SLB_FALSE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_FALSE );
+}
+
+/* Task of a team: counts a parallel region for each data */
+void metrics_task(void* param, slb_uint_t thread, slb_int_t start, slb_int_t end)
+{
+	slb_int_t d;
+
+	(void)param;
+	(void)thread;
+	for (d = start; d < end; ++d) {
+		sss_metrics_add( SSS_METRIC_PARALLEL_REGIONS, 1U );
+	}
+}
+
+/* Non-temporal share output
+	Encodes a chunk of which the shares are twice the last level cache (up to 64 MB),
+	with normal stores, non-temporal stores and the automatic choice (SIMD in use of sss_gemm_set_simd).
+*/
+void sss_example_stream(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	static const SSS_GEMM_STREAM mode[3] = { SSS_GEMM_STREAM_OFF, SSS_GEMM_STREAM_ON, SSS_GEMM_STREAM_AUTO };
+	static const char* const name[3] = { "normal", "non-temporal", "auto" };
+	SSS_GEMM gemm;
+	SSS_INTERP interp;
+	SSS_METRICS_SNAPSHOT snap;
+	SLB_RC rc;
+	slb_uint16_t* x;
+	slb_uint16_t* plain;
+	slb_uint16_t* plain2;
+	slb_uint32_t** share;
+	slb_uint64_t streamed;
+	slb_int_t i, m, r, nmb;
+	double start;
+	const slb_int_t round = 4;
+	const slb_uint_t max_share = 64U * 1024U * 1024U;
+	slb_uint_t llc = GetCacheSize(3U);
+	slb_uint_t size;
+
+	if (llc == 0U) {
+		llc = SSS_GEMM_LLC_DEFAULT;
+	}
+	size = ( llc < max_share / 2U ) ? 2U * llc : max_share;
+	nmb = (slb_int_t)( size / ( sizeof(slb_uint32_t) * (slb_uint_t)n ) );
+	nmb = nmb / 1024 * 1024;
+	size = (slb_uint_t)sizeof(slb_uint32_t) * (slb_uint_t)( n * nmb );
+
+	/* Allocate resources (the share rows are aligned to 64 bytes) */
+	x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)nmb );
+	plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)nmb );
+	share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc_aligned( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)nmb, SSS_MEM_ALIGN );
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+
+	/* Start message */
+	printf("\n===== Non-temporal share output\n");
+	printf_detail("LLC %u KB, shares %u KB per call\n", llc / 1024U, size / 1024U);
+
+	/* Open and start */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)nmb, plain) );
+	rc = sss_gemm_open( &gemm, (slb_uint_t)k, (slb_uint_t)n, nmb, &g_mem_callback_param, rand_callback, &g_rand_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_gemm_start( &gemm, (slb_uint_t)k, (slb_uint_t)n, x );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_open( &interp, (slb_uint_t)k, nmb, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_start( &interp, (slb_uint_t)k, &x[n - k], 0U );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	for (m = 0; m < 3; ++m) {
+		sss_gemm_set_stream( &gemm, mode[m] );
+		sss_metrics_snapshot(&snap);
+		streamed = snap.counter[SSS_METRIC_STREAM_BYTES];
+
+		start = sss_clock_ms();
+		for (r = 0; r < round; ++r) {
+			rc = sss_gemm_encode( &gemm, nmb, plain, share );
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+		}
+		start = sss_clock_ms() - start;
+
+		sss_metrics_snapshot(&snap);
+		streamed = snap.counter[SSS_METRIC_STREAM_BYTES] - streamed;
+		ASSERT( ( streamed != 0U ) == ( (mode[m] == SSS_GEMM_STREAM_ON) ||
+										( (mode[m] == SSS_GEMM_STREAM_AUTO) && (llc <= size) ) ) );
+
+		rc = sss_interp_decode( &interp, nmb, (const slb_uint32_t**)&share[n - k], plain2 );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		ASSERT( memcmp(plain, plain2, sizeof(slb_uint16_t) * (slb_uint_t)nmb) == 0 );
+		printf_detail("%-12s: %.1f ms per call (%.0f MB/s of shares), %llu bytes streamed\n", name[m], start / round,
+					  (double)size * round / start / 1000.0,
+					  (unsigned long long)streamed);
+	}
+	printf_detail("plain data matched.\n");
+
+	/* Close */
+	sss_interp_close(&interp);
+	sss_gemm_close(&gemm);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_FALSE );
+	}
+	slb_free( &g_mem_callback_param, share, SLB_FALSE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_FALSE );
+}
+
+/* Multi-policy encoding
+	Encodes the plain data for the policies of 3-of-5 and 10-of-20 in one pass,
+	compared with encoding for each policy, and decodes the shares of each policy.
+	The random numbers are of fast_rand_callback, so that rand() does not dominate the time.
+*/
+void sss_example_multi(
+	slb_int_t			plainsize		/* plain size */
+)
+{
+	static const slb_uint_t k[2] = { 3U, 10U };
+	static const slb_uint_t n[2] = { 5U, 20U };
+	SSS_ENCODE_PLAN plan[2];
+	SSS_ENCODE_PLAN multi;
+	SSS_GEMM gemm;
+	H_SLB_SSS hDecode;
+	SLB_SSS_DECODE_OPEN_PARAM decode_param;
+	SLB_RC rc;
+	const slb_uint16_t* x[2];
+	slb_uint32_t* chunk[MAX_PLAYERS];
+	slb_uint_t p, i, first;
+	slb_int_t offset, nmb, r;
+	double start, ms_each, ms_multi;
+	const slb_uint_t nt = 25U;
+	const slb_int_t round = 4;
+
+	/* Allocate resources */
+	slb_uint16_t*const xs = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * nt );
+	slb_uint16_t*const plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize );
+	slb_uint16_t*const plain2 = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * CODING_MAX_CHUNK );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * nt );
+
+	for (i = 0; i < nt; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)plainsize );
+	}
+	for (i = 0; i < n[0]; ++i) {
+		xs[i] = (slb_uint16_t)( i + 1U );
+	}
+	for (i = 0; i < n[1]; ++i) {
+		xs[n[0] + i] = (slb_uint16_t)( 101U + i );
+	}
+	x[0] = &xs[0];
+	x[1] = &xs[n[0]];
+
+	/* Start message */
+	printf("\n===== Multi-policy encoding\n");
+
+	/* Plans */
+	ASSERT( rand_callback(&g_rand_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)plainsize, plain) );
+	for (p = 0; p < 2U; ++p) {
+		rc = sss_plan_build( &plan[p], k[p], n[p], x[p], &g_mem_callback_param );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+	}
+	rc = sss_plan_build_multi( &multi, 2U, k, n, x, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( (multi.m == 13U) && (multi.n == nt) );
+	rc = sss_gemm_open( &gemm, multi.m, nt, CODING_MAX_CHUNK, &g_mem_callback_param, fast_rand_callback, SLB_NULL );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Each policy */
+	start = sss_clock_ms();
+	for (r = 0; r < round; ++r) {
+		for (p = 0, first = 0; p < 2U; first += n[p], ++p) {
+			rc = sss_gemm_start_plan( &gemm, &plan[p] );
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+			for (offset = 0; offset < plainsize; offset += nmb) {
+				nmb = ( plainsize - offset < CODING_MAX_CHUNK ) ? plainsize - offset : CODING_MAX_CHUNK;
+				for (i = 0; i < n[p]; ++i) {
+					chunk[i] = &share[first + i][offset];
+				}
+				rc = sss_gemm_encode( &gemm, nmb, &plain[offset], chunk );
+				ASSERT( SLB_R_SUCCEEDED(rc) );
+			}
+		}
+	}
+	ms_each = sss_clock_ms() - start;
+
+	/* All policies in one pass */
+	rc = sss_gemm_start_plan( &gemm, &multi );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	start = sss_clock_ms();
+	for (r = 0; r < round; ++r) {
+		for (offset = 0; offset < plainsize; offset += nmb) {
+			nmb = ( plainsize - offset < CODING_MAX_CHUNK ) ? plainsize - offset : CODING_MAX_CHUNK;
+			for (i = 0; i < nt; ++i) {
+				chunk[i] = &share[i][offset];
+			}
+			rc = sss_gemm_encode( &gemm, nmb, &plain[offset], chunk );
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+		}
+	}
+	ms_multi = sss_clock_ms() - start;
+	printf_detail("3-of-5 and 10-of-20, %d data x %d: each policy %.1f ms, one pass %.1f ms\n",
+				  plainsize, round, ms_each, ms_multi);
+
+	/* Decode the last k shares of each policy */
+	for (p = 0, first = 0; p < 2U; first += n[p], ++p) {
+		decode_param.k_max = k[p];
+		decode_param.mem_param = &g_mem_callback_param;
+		hDecode = slb_sss_open_as_decode(&decode_param, &rc);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = slb_sss_start_decode(hDecode, k[p], &x[p][n[p] - k[p]]);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		for (offset = 0; offset < plainsize; offset += nmb) {
+			nmb = ( plainsize - offset < CODING_MAX_CHUNK ) ? plainsize - offset : CODING_MAX_CHUNK;
+			for (i = 0; i < k[p]; ++i) {
+				chunk[i] = &share[first + n[p] - k[p] + i][offset];
+			}
+			rc = slb_sss_decode(hDecode, nmb, (const slb_uint32_t**)chunk, plain2);
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+			ASSERT( memcmp(&plain[offset], plain2, sizeof(slb_uint16_t) * (slb_uint_t)nmb) == 0 );
+		}
+		slb_sss_close(hDecode);
+	}
+	printf_detail("plain data matched.\n");
+
+	/* Close */
+	sss_gemm_close(&gemm);
+	sss_plan_free(&multi);
+	sss_plan_free(&plan[1]);
+	sss_plan_free(&plan[0]);
+
+	/* Free resources */
+	for (i = 0; i < nt; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_FALSE );
+	}
+	slb_free( &g_mem_callback_param, share, SLB_FALSE );
+	slb_free( &g_mem_callback_param, plain2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, xs, SLB_FALSE );
+}
+
+/* Compression before splitting
+	Log lines are compressed into frames aligned to the coding chunks of
+	slb_sss_get_bestnmb, encoded by the byte API, decoded chunk by chunk and
+	decompressed, compared with encoding the plain bytes.
+*/
+void sss_example_lz(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+)
+{
+	static const char* const level[4] = { "INFO ", "INFO ", "WARN ", "ERROR" };
+	static const char* const path[4] = { "/api/v1/items", "/api/v1/users", "/api/v1/orders", "/healthz" };
+	H_SLB_SSS hEncode;
+	SLB_SSS_ENCODE_OPEN_PARAM encode_param;
+	SSS_GEMM gemm;
+	SSS_INTERP interp;
+	SLB_RC rc;
+	slb_uint32_t* chunk[MAX_PLAYERS];
+	slb_int_t i, d, r, len, packed_len, out, raw, padded, offset, nmb, best_nmb, unit;
+	double start, ms_plain_enc, ms_lz_enc, ms_plain_dec, ms_lz_dec;
+	char line[160];
+	const slb_int_t len_max = plainsize * 2;
+	const slb_int_t pack_max = SSS_LZ_PACK_BOUND(len_max, SSS_LZ_FRAME_MAX, CODING_MAX_CHUNK * 2);
+	const slb_int_t words_max = SSS_BYTES_WORDS(pack_max);
+	const slb_int_t round = 4;
+
+	/* Allocate resources */
+	slb_uint16_t*const x = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * (slb_uint_t)n );
+	slb_uint8_t*const bytes = slb_alloc( &g_mem_callback_param, (slb_uint_t)len_max );
+	slb_uint8_t*const bytes2 = slb_alloc( &g_mem_callback_param, (slb_uint_t)len_max );
+	slb_uint8_t*const packed = slb_alloc( &g_mem_callback_param, (slb_uint_t)pack_max );
+	slb_uint8_t*const packed2 = slb_alloc( &g_mem_callback_param, (slb_uint_t)pack_max );
+	slb_uint32_t**const share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t*) * (slb_uint_t)n );
+
+	for (i = 0; i < n; ++i) {
+		share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * (slb_uint_t)words_max );
+		x[i] = (slb_uint16_t)( i + 1 );
+	}
+
+	/* Start message */
+	printf("\n===== Compression before splitting\n");
+
+	/* Log lines */
+	for (len = 0, i = 0; len < len_max; len += raw, ++i) {
+		raw = sprintf( line, "2026-10-19T%02d:%02d:%02d.%03dZ %s [worker-%d] request id=%08x status=%d bytes=%d path=%s/%d\n",
+					   ( i / 3600000 ) % 24, ( i / 60000 ) % 60, ( i / 1000 ) % 60, i % 1000, level[rand() % 4], rand() % 8,
+					   (unsigned)rand() * 2654435761U, ( rand() % 16 == 0 ) ? 404 : 200, rand() % 65536, path[rand() % 4], rand() % 10000 );
+		if (len_max - len < raw) {
+			raw = len_max - len;
+		}
+		memcpy( &bytes[len], line, (size_t)raw );
+	}
+
+	/* Round trip of short data (the tails and the last literals) */
+	for (len = 0; len <= 300; ++len) {
+		rc = sss_lz_compress( len, bytes, SSS_LZ_BOUND(len), packed, &out );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		rc = sss_lz_decompress( out, packed, len, bytes2, &raw );
+		ASSERT( SLB_R_SUCCEEDED(rc) && (raw == len) );
+		ASSERT( memcmp(bytes, bytes2, (size_t)len) == 0 );
+	}
+	memset( packed2, 0, 1000 );
+	rc = sss_lz_compress( 1000, packed2, SSS_LZ_BOUND(1000), packed, &out );
+	ASSERT( SLB_R_SUCCEEDED(rc) && (out < 16) );
+	rc = sss_lz_decompress( out, packed, 1000, bytes2, &raw );
+	ASSERT( SLB_R_SUCCEEDED(rc) && (raw == 1000) && (memcmp(packed2, bytes2, 1000) == 0) );
+
+	/* Broken data is rejected */
+	rc = sss_lz_compress( 4096, bytes, SSS_LZ_BOUND(4096), packed, &out );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	ASSERT( sss_lz_decompress( out, packed, 4095, bytes2, &raw ) == R_INVALID_PARAM );
+	for (i = 1; i < out; i += 7) {
+		rc = sss_lz_decompress( i, packed, 4096, bytes2, &raw );
+		ASSERT( SLB_R_FAILED(rc) || (raw < 4096) );
+	}
+	ASSERT( sss_lz_compress( 4096, bytes, out - 1, packed, &out ) == R_INVALID_PARAM );
+
+	/* Random data is stored */
+	ASSERT( rand_callback(&g_rand_callback_param, 4096U, bytes2) );
+	rc = sss_lz_pack( 4096, bytes2, SSS_LZ_FRAME_MAX, 64, pack_max, packed, &out );
+	ASSERT( SLB_R_SUCCEEDED(rc) && (out == 4096 + 64) );
+	rc = sss_lz_frame( out, packed, 64, &raw, &padded );
+	ASSERT( SLB_R_SUCCEEDED(rc) && (raw == 4096) && (padded == out) );
+	printf_detail("random 4096 bytes: stored in %d bytes\n", out);
+
+	/* Open and start (the chunk is of slb_sss_get_bestnmb) */
+	encode_param.k_max = (slb_uint_t)k;
+	encode_param.n_max = (slb_uint_t)n;
+	encode_param.mem_param = &g_mem_callback_param;
+	encode_param.rand_func = rand_callback;
+	encode_param.rand_param = &g_rand_callback_param;
+	hEncode = slb_sss_open_as_encode(&encode_param, &rc);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = slb_sss_start_encode(hEncode, (slb_uint_t)k, (slb_uint_t)n, SLB_TRUE, x);
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	best_nmb = slb_sss_get_bestnmb(hEncode, CODING_MAX_CHUNK);
+	slb_sss_close(hEncode);
+	unit = best_nmb * 2;
+
+	rc = sss_gemm_open( &gemm, (slb_uint_t)k, (slb_uint_t)n, CODING_MAX_CHUNK, &g_mem_callback_param, fast_rand_callback, SLB_NULL );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_gemm_start( &gemm, (slb_uint_t)k, (slb_uint_t)n, x );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_open( &interp, (slb_uint_t)k, CODING_MAX_CHUNK, &g_mem_callback_param );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+	rc = sss_interp_start( &interp, (slb_uint_t)k, &x[n - k], 0U );
+	ASSERT( SLB_R_SUCCEEDED(rc) );
+
+	/* Encode the plain bytes */
+	start = sss_clock_ms();
+	for (r = 0; r < round; ++r) {
+		for (offset = 0; offset < len_max; offset += unit) {
+			for (i = 0; i < n; ++i) {
+				chunk[i] = &share[i][offset / 2];
+			}
+			rc = sss_gemm_encode_bytes( &gemm, ( len_max - offset < unit ) ? len_max - offset : unit, &bytes[offset], &nmb, chunk );
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+		}
+	}
+	ms_plain_enc = ( sss_clock_ms() - start ) / round;
+
+	start = sss_clock_ms();
+	for (r = 0; r < round; ++r) {
+		for (offset = 0; offset < len_max; offset += unit) {
+			for (i = 0; i < k; ++i) {
+				chunk[i] = &share[n - k + i][offset / 2];
+			}
+			rc = sss_interp_decode_bytes( &interp, ( len_max - offset < unit ) ? len_max - offset : unit,
+										  (const slb_uint32_t**)chunk, &bytes2[offset] );
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+		}
+	}
+	ms_plain_dec = ( sss_clock_ms() - start ) / round;
+	ASSERT( memcmp(bytes, bytes2, (size_t)len_max) == 0 );
+
+	/* Compress and encode the frames (each frame is of whole chunks) */
+	start = sss_clock_ms();
+	for (r = 0; r < round; ++r) {
+		rc = sss_lz_pack( len_max, bytes, SSS_LZ_FRAME_MAX, unit, pack_max, packed, &packed_len );
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		ASSERT( packed_len % unit == 0 );
+		for (offset = 0; offset < packed_len; offset += unit) {
+			for (i = 0; i < n; ++i) {
+				chunk[i] = &share[i][offset / 2];
+			}
+			rc = sss_gemm_encode_bytes( &gemm, unit, &packed[offset], &nmb, chunk );
+			ASSERT( SLB_R_SUCCEEDED(rc) );
+		}
+	}
+	ms_lz_enc = ( sss_clock_ms() - start ) / round;
+
+	/* Decode the chunks, and decompress each frame when its chunks are decoded */
+	memset( bytes2, 0, (size_t)len_max );
+	start = sss_clock_ms();
+	for (r = 0; r < round; ++r) {
+		for (offset = 0, len = 0; offset < packed_len; offset += padded, len += raw) {
+			padded = unit;
+			for (d = offset; d < offset + padded; d += unit) {
+				for (i = 0; i < k; ++i) {
+					chunk[i] = &share[n - k + i][d / 2];
+				}
+				rc = sss_interp_decode_bytes( &interp, unit, (const slb_uint32_t**)chunk, &packed2[d] );
+				ASSERT( SLB_R_SUCCEEDED(rc) );
+				if (d == offset) {
+					rc = sss_lz_frame( packed_len - offset, &packed2[offset], unit, &raw, &padded );
+					ASSERT( SLB_R_SUCCEEDED(rc) );
+				}
+			}
+			rc = sss_lz_unpack( padded, &packed2[offset], unit, len_max - len, &bytes2[len], &out );
+			ASSERT( SLB_R_SUCCEEDED(rc) && (out == raw) );
+		}
+	}
+	ms_lz_dec = ( sss_clock_ms() - start ) / round;
+	ASSERT( len == len_max );
+	ASSERT( memcmp(bytes, bytes2, (size_t)len_max) == 0 );
+
+	printf_detail("%d bytes of log lines in frames of %d bytes, chunk %d bytes: packed %d bytes (ratio %.2f)\n",
+				  len_max, SSS_LZ_FRAME_MAX, unit, packed_len, (double)len_max / packed_len);
+	printf_detail("share bytes: %d x %d -> %d x %d\n", n, len_max, n, packed_len);
+	printf_detail("encode: plain %.2f ms, compress and encode %.2f ms\n", ms_plain_enc, ms_lz_enc);
+	printf_detail("decode: plain %.2f ms, decode and decompress %.2f ms\n", ms_plain_dec, ms_lz_dec);
+
+	/* Close */
+	sss_interp_close(&interp);
+	sss_gemm_close(&gemm);
+
+	/* Free resources */
+	for (i = 0; i < n; ++i) {
+		slb_free( &g_mem_callback_param, share[i], SLB_TRUE );
+	}
+	slb_free( &g_mem_callback_param, share, SLB_FALSE );
+	slb_free( &g_mem_callback_param, packed2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, packed, SLB_TRUE );
+	slb_free( &g_mem_callback_param, bytes2, SLB_TRUE );
+	slb_free( &g_mem_callback_param, bytes, SLB_TRUE );
+	slb_free( &g_mem_callback_param, x, SLB_FALSE );
+}
+
+/* Random number callback for timing (splitmix64, not for secrets) */
+slb_bool_t fast_rand_callback(void* param, slb_uint_t len, void* rnd_buff)
+{
+	static slb_uint64_t s_state = 0x9e3779b97f4a7c15U;
+	slb_uint8_t* buff8 = (slb_uint8_t*)rnd_buff;
+	slb_uint64_t z;
+	slb_uint_t i;
+
+	(void)param;
+	for (i = 0; i < len; i += (slb_uint_t)sizeof(z)) {
+		s_state += 0x9e3779b97f4a7c15U;
+		z = s_state;
+		z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9U;
+		z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebU;
+		z ^= z >> 31;
+		memcpy( &buff8[i], &z, ( len - i < sizeof(z) ) ? len - i : sizeof(z) );
+	}
+	return SLB_TRUE;
+}
+
+/* Share tag lanes
+	The constant-time layout and the share tag of AVX2 (8 lanes with key^8) are compared
+	with those of no SIMD, and the loops are timed.
+*/
+void sss_example_tag(void)
+{
+	slb_uint32_t value[CODING_MAX_CHUNK], value2[CODING_MAX_CHUNK];
+	slb_uint8_t data[CODING_MAX_CHUNK * 3], data2[CODING_MAX_CHUNK * 3];
+	slb_uint32_t tag, tag2, ref;
+	slb_uint_t pos, pos2;
+	slb_int_t i, nmb, r;
+	double start, ms_scalar, ms_avx2;
+	const slb_uint32_t key = 40503U;
+	const slb_int_t loop = 2000;
+
+	/* Start message */
+	printf("\n===== Share tag lanes (AVX2)\n");
+
+	/* Values of 0 to 65536 */
+	for (i = 0; i < CODING_MAX_CHUNK; ++i) {
+		value[i] = ( i % 37 == 5 ) ? SSS_GFP_PRIME - 1U : (slb_uint32_t)rand() % SSS_GFP_PRIME;
+	}
+
+	/* Same layout and tag of all lengths of the lanes and the tail */
+	for (nmb = 0; nmb <= CODING_MAX_CHUNK; nmb = ( nmb < 40 ) ? nmb + 1 : nmb * 2) {
+		ref = 7U;
+		for (i = 0; i < nmb; ++i) {
+			ref = SSS_GFP_MUL( ref + value[i], key );
+		}
+
+		g_stream_avx2 = SLB_FALSE;
+		tag = 7U;
+		pos = sss_put_values_ct( data, 0, nmb, value, key, &tag );
+		g_stream_avx2 = SLB_TRUE;
+		tag2 = 7U;
+		pos2 = sss_put_values_ct( data2, 0, nmb, value, key, &tag2 );
+		ASSERT( (pos == pos2) && (memcmp(data, data2, pos) == 0) );
+		ASSERT( (tag == ref) && (tag2 == ref) );
+
+		tag2 = 7U;
+		pos2 = sss_get_values_ct( data2, 0, nmb, value2, key, &tag2 );
+		ASSERT( (pos == pos2) && (tag2 == ref) );
+		ASSERT( memcmp(value, value2, sizeof(slb_uint32_t) * (slb_uint_t)nmb) == 0 );
+	}
+	printf_detail("layout and tags matched.\n");
+
+	/* Write and read a chunk with share tag */
+	for (r = 0; r < 2; ++r) {
+		g_stream_avx2 = ( r != 0 ) ? SLB_TRUE : SLB_FALSE;
+		start = sss_clock_ms();
+		for (i = 0; i < loop; ++i) {
+			tag = 0;
+			pos = sss_put_values_ct( data, 0, CODING_MAX_CHUNK, value, key, &tag );
+			tag2 = 0;
+			(void)sss_get_values_ct( data, 0, CODING_MAX_CHUNK, value2, key, &tag2 );
+			ASSERT( tag == tag2 );
+		}
+		if (r == 0) {
+			ms_scalar = sss_clock_ms() - start;
+		}
+		else {
+			ms_avx2 = sss_clock_ms() - start;
+		}
+	}
+	printf_detail("%d x %d values written and read with share tag: no SIMD %.2f ms, AVX2 %.2f ms\n",
+				  loop, CODING_MAX_CHUNK, ms_scalar, ms_avx2);
+
+	g_stream_avx2 = SLB_TRUE;
+}
+
+/* Timing leakage check
+	Checks that the processing time does not depend on the plain data or the share values.
+	The result of libslbsss depends on the SIMD in use, and it is measured with all available SIMD.
+*/
+void sss_example_timing(void)
+{
+	TIMING_PARAM param;
+	SLB_RC rc;
+	slb_uint16_t x[TIMING_N];
+	slb_int_t i;
+
+	/* Open as encode and decode */
+	{
+		SLB_SSS_ENCODE_OPEN_PARAM encode_param;
+		SLB_SSS_DECODE_OPEN_PARAM decode_param;
+
+		encode_param.k_max = TIMING_K;
+		encode_param.n_max = TIMING_N;
+		encode_param.mem_param = &g_mem_callback_param;
+		encode_param.rand_func = rand_callback;
+		encode_param.rand_param = &g_rand_callback_param;
+
+		decode_param.k_max = TIMING_K;
+		decode_param.mem_param = &g_mem_callback_param;
+
+		slb_sss_set_simd( IsSimdAvailableSSE2(), IsSimdAvailableAVX2(), IsSimdAvailableAVX512() );
+		slb_sss_set_mp(MP_NONE, 0);
+
+		param.hEncode = slb_sss_open_as_encode(&encode_param, &rc);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+		param.hDecode = slb_sss_open_as_decode(&decode_param, &rc);
+		ASSERT( SLB_R_SUCCEEDED(rc) );
+
+		ASSERT( slb_sss_start_encode(param.hEncode, TIMING_K, TIMING_N, SLB_FALSE, x) == R_SUCCESS );
+		ASSERT( slb_sss_start_decode(param.hDecode, TIMING_K, x) == R_SUCCESS );
+	}
+
+	/* Allocate resources */
+	param.n = TIMING_N;
+	param.nmb = TIMING_NMB;
+	param.plain = slb_alloc( &g_mem_callback_param, sizeof(slb_uint16_t) * TIMING_NMB );
+	param.value = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * TIMING_NMB );
+	param.share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t**) * TIMING_N );
+	param.fixed_share = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t**) * TIMING_N );
+	param.stream = slb_alloc( &g_mem_callback_param, sizeof(STREAM_BUFF) * TIMING_N );
+
+	for (i = 0; i < TIMING_N; ++i) {
+		param.share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * TIMING_NMB );
+		param.fixed_share[i] = slb_alloc( &g_mem_callback_param, sizeof(slb_uint32_t) * TIMING_NMB );
+		param.stream[i].x = x[i];
+		param.stream[i].tag_key = (slb_uint32_t)i + 1U;
+		param.stream[i].data = g_stream_mem[i];
+	}
+
+	/* Shares of the fixed plain data */
+	memset(param.plain, 0, sizeof(slb_uint16_t) * TIMING_NMB);
+	ASSERT( slb_sss_encode(param.hEncode, TIMING_NMB, param.plain, param.fixed_share) == R_SUCCESS );
+
+	/* Round trip in constant-time layout */
+	for (i = 0; i < TIMING_N; ++i) {
+		param.stream[i].const_time = SLB_TRUE;
+		param.stream[i].pos = 0;
+	}
+	sss_share_to_stream(TIMING_N, TIMING_NMB, param.fixed_share, param.stream);
+	sss_reset_stream_pos(TIMING_N, param.stream);
+	ASSERT( sss_stream_to_share(TIMING_N, TIMING_NMB, param.stream, param.share) );
+	for (i = 0; i < TIMING_N; ++i) {
+		ASSERT( memcmp(param.share[i], param.fixed_share[i], sizeof(slb_uint32_t) * TIMING_NMB) == 0 );
+	}
+
+	printf("Timing leakage check: k = %d, n = %d, nmb = %d, measurements = %d\n",
+				TIMING_K, TIMING_N, TIMING_NMB, TIMING_MEASUREMENTS);
+
+	print_timing( "slb_sss_encode",
+		ct_check(timing_prepare_encode, timing_run_encode, &param, TIMING_MEASUREMENTS) );
+	print_timing( "slb_sss_decode",
+		ct_check(timing_prepare_decode, timing_run_decode, &param, TIMING_MEASUREMENTS) );
+
+	param.const_time = SLB_FALSE;
+	print_timing( "sss_share_to_stream",
+		ct_check(timing_prepare_stream, timing_run_stream, &param, TIMING_MEASUREMENTS) );
+
+	param.const_time = SLB_TRUE;
+	print_timing( "sss_share_to_stream (constant-time)",
+		ct_check(timing_prepare_stream, timing_run_stream, &param, TIMING_MEASUREMENTS) );
+
+	print_timing( "SSS_GFP_MUL",
+		ct_check(timing_prepare_gfp, timing_run_gfp, &param, TIMING_MEASUREMENTS) );
+
+	/* Close SSS control handles */
+	slb_sss_close(param.hEncode);
+	slb_sss_close(param.hDecode);
+
+	/* Free resources */
+	for (i = 0; i < TIMING_N; ++i) {
+		slb_free( &g_mem_callback_param, param.share[i], SLB_TRUE );
+		slb_free( &g_mem_callback_param, param.fixed_share[i], SLB_TRUE );
+	}
+
+	slb_free( &g_mem_callback_param, param.plain, SLB_TRUE );
+	slb_free( &g_mem_callback_param, param.value, SLB_TRUE );
+	slb_free( &g_mem_callback_param, param.share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, param.fixed_share, SLB_TRUE );
+	slb_free( &g_mem_callback_param, param.stream, SLB_TRUE );
+}
+
+/* Prints the result of timing leakage check */
+void print_timing(const char* name, double t)
+{
+	printf( "%-40s |t| = %8.2f : %s\n", name, t,
+				(t < CT_T_THRESHOLD) ? "no leakage detected" : "!!! timing leakage !!!" );
+}
+
+/* Prepares input of timing leakage check: plain data
+	The same work is done for both classes, so that only the input differs in the measurement.
+*/
+void timing_prepare_encode(void* p, slb_uint_t cls)
+{
+	TIMING_PARAM*const param = (TIMING_PARAM*)p;
+	slb_int_t j;
+
+	for (j = 0; j < param->nmb; ++j) {
+		slb_uint16_t rnd = (slb_uint16_t)rand();
+		param->plain[j] = (cls == CT_CLASS_FIXED) ? 0U : rnd;
+	}
+}
+
+void timing_run_encode(void* p)
+{
+	TIMING_PARAM*const param = (TIMING_PARAM*)p;
+	(void)slb_sss_encode(param->hEncode, param->nmb, param->plain, param->share);
+}
+
+/* Prepares input of timing leakage check: shares */
+void timing_prepare_decode(void* p, slb_uint_t cls)
+{
+	TIMING_PARAM*const param = (TIMING_PARAM*)p;
+	slb_int_t i, j;
+
+	for (i = 0; i < param->n; ++i) {
+		for (j = 0; j < param->nmb; ++j) {
+			slb_uint32_t rnd = (slb_uint32_t)rand() % SSS_GFP_PRIME;
+			param->share[i][j] = (cls == CT_CLASS_FIXED) ? param->fixed_share[i][j] : rnd;
+		}
+	}
+}
+
+void timing_run_decode(void* p)
+{
+	TIMING_PARAM*const param = (TIMING_PARAM*)p;
+	(void)slb_sss_decode(param->hDecode, param->nmb, (const slb_uint32_t **)param->share, param->plain);
+}
+
+/* Prepares input of timing leakage check: shares whose lower 16 bits are zero */
+void timing_prepare_stream(void* p, slb_uint_t cls)
+{
+	TIMING_PARAM*const param = (TIMING_PARAM*)p;
+	slb_int_t i, j;
+
+	for (i = 0; i < param->n; ++i) {
+		param->stream[i].const_time = param->const_time;
+		param->stream[i].pos = 0;
+
+		for (j = 0; j < param->nmb; ++j) {
+			slb_uint32_t rnd = (slb_uint32_t)rand() % SSS_GFP_PRIME;
+			param->share[i][j] = (cls == CT_CLASS_FIXED) ? SSS_GFP_PRIME - 1U : rnd;
+		}
+	}
+}
+
+void timing_run_stream(void* p)
+{
+	TIMING_PARAM*const param = (TIMING_PARAM*)p;
+	sss_share_to_stream(param->n, param->nmb, param->share, param->stream);
+}
+
+/* Prepares input of timing leakage check: field values */
+void timing_prepare_gfp(void* p, slb_uint_t cls)
+{
+	TIMING_PARAM*const param = (TIMING_PARAM*)p;
+	slb_int_t j;
+
+	for (j = 0; j < param->nmb; ++j) {
+		slb_uint32_t rnd = (slb_uint32_t)rand() % SSS_GFP_PRIME;
+		param->value[j] = (cls == CT_CLASS_FIXED) ? 0U : rnd;
+	}
+}
+
+void timing_run_gfp(void* p)
+{
+	TIMING_PARAM*const param = (TIMING_PARAM*)p;
+	slb_uint32_t acc = 1U;
+	slb_int_t j;
+
+	for (j = 0; j < param->nmb; ++j) {
+		acc = SSS_GFP_MUL( acc + param->value[j], param->value[j] );
+	}
+
+	param->result = acc;
+}
+
+/* Resets stream position */
+void sss_reset_stream_pos(
+	slb_int_t			n,			/* number of shares */
+	STREAM_BUFF*const	stream		/* stream buffer */
+)
+{
+	slb_int_t i;
+	for (i = 0; i < n; ++i) {
+		stream[i].pos = 0;
+	}
+}
+
+/* Writes a share value to stream
+	The encoded data has meaning only from the LSB to 17 bits.
+	And the 17th bit is needed only if the lower 16 bit value is zero.
+	Here writes byte values if the lower 16 bit value is zero for simplicity.
+	Since the probability that the lower 16-bit value will be zero is low,
+	this method is practical when encoding plaintext of indeterministic size.
+	However, when encoding plaintext with a fixed size,
+	a structure in which the corresponding 17th bit is placed at a fixed position can be considered.
+	Since this method branches on the share value, sss_put_values_ct is used in constant-time mode.
+	The share tag is updated in the same pass (Horner's method), so the tag costs no extra pass.
+*/
+slb_uint_t sss_put_value(
+	slb_uint8_t*		data,		/* stream data */
+	slb_uint_t			pos,		/* write position */
+	slb_uint32_t		value,		/* share value */
+	slb_uint32_t		key,		/* key of share tag */
+	slb_uint32_t*		tag			/* [in/out] share tag (SLB_NULL: not updated) */
+)
+{
+	if (tag != SLB_NULL) {
+		*tag = SSS_GFP_MUL( *tag + value, key );
+	}
+
+	/* Get the low value and write it to stream */
+	slb_uint16_t low = (slb_uint16_t)value;
+	SLB_WRITE16( &data[pos], low );
+	pos += sizeof(slb_uint16_t);
+
+	/* Value unknown at that low width */
+	if (low == 0) {
+
+		/* Get high value and write to stream */
+		slb_uint8_t high = (slb_uint8_t)( value >> SLB_SHIFT_OF_2B );
+		data[pos] = high;
+		++pos;
+	}
+
+	return pos;
+}
+
+/* Reads a share value from stream */
+slb_uint32_t sss_get_value(
+	const slb_uint8_t*	data,		/* stream data */
+	slb_uint_t*			p_pos,		/* read position */
+	slb_uint32_t		key,		/* key of share tag */
+	slb_uint32_t*		tag			/* [in/out] share tag (SLB_NULL: not updated) */
+)
+{
+	slb_uint_t pos = *p_pos;
+	slb_uint32_t value;
+
+	/* Get the low value of stream */
+	slb_uint16_t low;
+	SLB_READ16( &data[pos], &low );
+	value = (slb_uint32_t)low;
+	pos += sizeof(slb_uint16_t);
+
+	/* Value unknown in low width */
+	if (low == 0) {
+
+		/* Reflect high value */
+		value |= (slb_uint32_t)data[pos] << SLB_SHIFT_OF_2B;
+		++pos;
+	}
+
+	if (tag != SLB_NULL) {
+		*tag = SSS_GFP_MUL( *tag + value, key );
+	}
+
+	*p_pos = pos;
+	return value;
+}
+
+/* Multiplies the lanes of 32 bits (a < 2^19, b < 65537) in GF(65537) (AVX2) */
+SIMD_TARGET("avx2")
+static __m256i gfp_mul_avx2(__m256i a, __m256i b)
+{
+	const __m256i mask = _mm256_set1_epi64x(SLB_MASK_OF_UINT16);
+	const __m256i prime = _mm256_set1_epi64x(SSS_GFP_PRIME);
+	const __m256i prime_1 = _mm256_set1_epi64x(SSS_GFP_PRIME - 1U);
+	__m256i r[2];
+	int i;
+
+	/* Products of the even and the odd lanes (less than 2^36) */
+	r[0] = _mm256_mul_epu32( a, b );
+	r[1] = _mm256_mul_epu32( _mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32) );
+
+	/* Fold as sss_gfp_reduce, and correct with a mask */
+	for (i = 0; i < 2; ++i) {
+		r[i] = _mm256_sub_epi64( _mm256_add_epi64( _mm256_add_epi64( _mm256_and_si256(r[i], mask), _mm256_srli_epi64(r[i], 32) ), prime ),
+								 _mm256_and_si256( _mm256_srli_epi64(r[i], 16), mask ) );
+		r[i] = _mm256_sub_epi64( _mm256_add_epi64( _mm256_and_si256(r[i], mask), prime ), _mm256_srli_epi64(r[i], 16) );
+		r[i] = _mm256_sub_epi64( r[i], _mm256_and_si256( _mm256_cmpgt_epi64(r[i], prime_1), prime ) );
+	}
+	return _mm256_blend_epi32( r[0], _mm256_slli_epi64(r[1], 32), 0xaa );
+}
+
+/* Combines the lanes of share tag
+	Lane l has the values 8b + l of nb blocks by Horner's method with key^8,
+	so it is multiplied by key^(8 - l), and the incoming tag by key^(8 nb).
+*/
+static slb_uint32_t tag_combine(slb_uint32_t tag, slb_uint32_t key, slb_int_t nb, const slb_uint32_t lane[8])
+{
+	slb_uint32_t power = key;
+	slb_int_t l;
+
+	tag = SSS_GFP_MUL( tag, sss_gfp_pow( sss_gfp_pow(key, 8U), (slb_uint32_t)nb ) );
+	for (l = 7; 0 <= l; --l) {
+		tag = sss_gfp_reduce( (slb_uint64_t)tag + SSS_GFP_MUL( lane[l], power ) );
+		power = SSS_GFP_MUL( power, key );
+	}
+	return tag;
+}
+
+/* Writes share values in constant-time layout (AVX2, 8 values)
+	The share tag is updated in 8 lanes with the stride of key^8 in the same loop.
+	Returns the number of the values written.
+*/
+SIMD_TARGET("avx2")
+static slb_int_t put_values_ct_avx2(slb_uint8_t* data, slb_uint8_t* bitmap, slb_int_t nmb, const slb_uint32_t* value,
+									slb_uint32_t key, slb_uint32_t* tag)
+{
+	const __m256i swap = _mm256_setr_epi8( 1, 0, 5, 4, 9, 8, 13, 12, -1, -1, -1, -1, -1, -1, -1, -1,
+										   1, 0, 5, 4, 9, 8, 13, 12, -1, -1, -1, -1, -1, -1, -1, -1 );
+	const __m256i key8 = _mm256_set1_epi32( (int)sss_gfp_pow(key, 8U) );
+	__m256i acc = _mm256_setzero_si256();
+	__m256i v;
+	slb_uint32_t lane[8];
+	slb_int_t j;
+
+	for (j = 0; j + 8 <= nmb; j += 8) {
+		v = _mm256_loadu_si256( (const __m256i*)&value[j] );
+		_mm_storeu_si128( (__m128i*)&data[2 * j],
+						  _mm256_castsi256_si128( _mm256_permute4x64_epi64( _mm256_shuffle_epi8(v, swap), 0x08 ) ) );
+		bitmap[j / 8] = (slb_uint8_t)_mm256_movemask_ps( _mm256_castsi256_ps( _mm256_slli_epi32(v, 15) ) );
+		if (tag != SLB_NULL) {
+			acc = _mm256_add_epi32( gfp_mul_avx2(acc, key8), v );
+		}
+	}
+
+	if ( (tag != SLB_NULL) && (0 < j) ) {
+		_mm256_storeu_si256( (__m256i*)lane, acc );
+		*tag = tag_combine( *tag, key, j / 8, lane );
+	}
+	return j;
+}
+
+/* Reads share values in constant-time layout (AVX2, 8 values)
+	Returns the number of the values read.
+*/
+SIMD_TARGET("avx2")
+static slb_int_t get_values_ct_avx2(const slb_uint8_t* data, const slb_uint8_t* bitmap, slb_int_t nmb, slb_uint32_t* value,
+									slb_uint32_t key, slb_uint32_t* tag)
+{
+	const __m128i swap = _mm_setr_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+	const __m256i bit = _mm256_setr_epi32( 1, 2, 4, 8, 16, 32, 64, 128 );
+	const __m256i high = _mm256_set1_epi32( 1 << SLB_SHIFT_OF_2B );
+	const __m256i key8 = _mm256_set1_epi32( (int)sss_gfp_pow(key, 8U) );
+	__m256i acc = _mm256_setzero_si256();
+	__m256i v, b;
+	slb_uint32_t lane[8];
+	slb_int_t j;
+
+	for (j = 0; j + 8 <= nmb; j += 8) {
+		v = _mm256_cvtepu16_epi32( _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*)&data[2 * j] ), swap ) );
+		b = _mm256_and_si256( _mm256_set1_epi32( bitmap[j / 8] ), bit );
+		v = _mm256_or_si256( v, _mm256_and_si256( _mm256_cmpeq_epi32(b, bit), high ) );
+		_mm256_storeu_si256( (__m256i*)&value[j], v );
+		if (tag != SLB_NULL) {
+			acc = _mm256_add_epi32( gfp_mul_avx2(acc, key8), v );
+		}
+	}
+
+	if ( (tag != SLB_NULL) && (0 < j) ) {
+		_mm256_storeu_si256( (__m256i*)lane, acc );
+		*tag = tag_combine( *tag, key, j / 8, lane );
+	}
+	return j;
+}
+
+/* Writes share values to stream in constant-time layout
+	The lower 16 bits of the values are written, and then the 17th bits of the values are written as a bitmap.
+	Neither the layout nor the processing time depends on the values.
+	The share tag is updated in the same loop.
+*/
+slb_uint_t sss_put_values_ct(
+	slb_uint8_t*		data,		/* stream data */
+	slb_uint_t			pos,		/* write position */
+	slb_int_t			nmb,		/* number of values */
+	const slb_uint32_t*	value,		/* share values */
+	slb_uint32_t		key,		/* key of share tag */
+	slb_uint32_t*		tag			/* [in/out] share tag (SLB_NULL: not updated) */
+)
+{
+	slb_uint8_t*const bitmap = &data[ pos + ( sizeof(slb_uint16_t) * (slb_uint_t)nmb ) ];
+	const slb_uint_t bitmap_bytes = ( (slb_uint_t)nmb + SLB_BITS_OF_UINT8 - 1U ) / SLB_BITS_OF_UINT8;
+	slb_int_t j = 0;
+
+	memset(bitmap, 0, bitmap_bytes);
+
+	if (g_stream_avx2) {
+		j = put_values_ct_avx2( &data[pos], bitmap, nmb, value, key, tag );
+		pos += (slb_uint_t)( sizeof(slb_uint16_t) * (slb_uint_t)j );
+	}
+	for (; j < nmb; ++j) {
+		const slb_uint_t high = ( value[j] >> SLB_SHIFT_OF_2B ) & 1U;
+		SLB_WRITE16( &data[pos], value[j] );
+		pos += sizeof(slb_uint16_t);
+		bitmap[ (slb_uint_t)j / SLB_BITS_OF_UINT8 ] |= (slb_uint8_t)( high << ( (slb_uint_t)j % SLB_BITS_OF_UINT8 ) );
+		if (tag != SLB_NULL) {
+			*tag = SSS_GFP_MUL( *tag + value[j], key );
+		}
+	}
+
+	return pos + bitmap_bytes;
+}
+
+/* Reads share values from stream in constant-time layout */
+slb_uint_t sss_get_values_ct(
+	const slb_uint8_t*	data,		/* stream data */
+	slb_uint_t			pos,		/* read position */
+	slb_int_t			nmb,		/* number of values */
+	slb_uint32_t*		value,		/* [out] share values */
+	slb_uint32_t		key,		/* key of share tag */
+	slb_uint32_t*		tag			/* [in/out] share tag (SLB_NULL: not updated) */
+)
+{
+	const slb_uint8_t*const bitmap = &data[ pos + ( sizeof(slb_uint16_t) * (slb_uint_t)nmb ) ];
+	const slb_uint_t bitmap_bytes = ( (slb_uint_t)nmb + SLB_BITS_OF_UINT8 - 1U ) / SLB_BITS_OF_UINT8;
+	slb_int_t j = 0;
+
+	if (g_stream_avx2) {
+		j = get_values_ct_avx2( &data[pos], bitmap, nmb, value, key, tag );
+		pos += (slb_uint_t)( sizeof(slb_uint16_t) * (slb_uint_t)j );
+	}
+	for (; j < nmb; ++j) {
+		const slb_uint_t high = ( (slb_uint_t)bitmap[ (slb_uint_t)j / SLB_BITS_OF_UINT8 ] >> ( (slb_uint_t)j % SLB_BITS_OF_UINT8 ) ) & 1U;
+		slb_uint16_t low;
+		SLB_READ16( &data[pos], &low );
+		pos += sizeof(slb_uint16_t);
+		value[j] = (slb_uint32_t)low | (slb_uint32_t)( high << SLB_SHIFT_OF_2B );
+		if (tag != SLB_NULL) {
+			*tag = SSS_GFP_MUL( *tag + value[j], key );
+		}
+	}
+
+	return pos + bitmap_bytes;
+}
+
+/* Reflects share contents to stream
+	When the stream has a key of share tag, the share tag of the chunk is appended after the share values.
+	The share tag is a polynomial hash over GF(65537) evaluated at the key.
+*/
+void sss_share_to_stream(
+	slb_int_t			n,			/* number of shares */
+	slb_int_t			nmb,		/* number of use */
+	slb_uint32_t**const	share,		/* share buffer */
+	STREAM_BUFF*const	stream		/* stream buffer */
+)
+{
+	slb_int_t i, j;
+
+	/* Reflect share contents to stream */
+	for (i = 0; i < n; ++i) {
+
+		/* Get write position of stream */
+		slb_uint_t pos = stream[i].pos;
+		const slb_uint32_t key = stream[i].tag_key;
+		slb_uint32_t tag = 0;
+		slb_uint32_t*const p_tag = ( key != 0U ) ? &tag : SLB_NULL;
+
+		/* Write share values (and update share tag) */
+		if (stream[i].const_time) {
+			pos = sss_put_values_ct( stream[i].data, pos, nmb, share[i], key, p_tag );
+		}
+		else {
+			for (j = 0; j < nmb; ++j) {
+				pos = sss_put_value( stream[i].data, pos, share[i][j], key, p_tag );
+			}
+		}
+
+		/* Append share tag of the chunk */
+		if (key != 0U) {
+			if (stream[i].const_time) {
+				pos = sss_put_values_ct( stream[i].data, pos, 1, &tag, 0U, SLB_NULL );
+			}
+			else {
+				pos = sss_put_value( stream[i].data, pos, tag, 0U, SLB_NULL );
+			}
+		}
+
+		/* Update position of stream */
+		stream[i].pos = pos;
+	}
+}
+
+/* Reflects stream contents to share
+	Returns SLB_FALSE if a share tag in the stream is unmatched.
+*/
+slb_bool_t sss_stream_to_share(
+	slb_int_t			n,			/* number of shares */
+	slb_int_t			nmb,		/* number of use */
+	STREAM_BUFF*const	stream,		/* stream buffer */
+	slb_uint32_t**const	share		/* share buffer */
+)
+{
+	slb_bool_t tag_matched = SLB_TRUE;
+	slb_int_t i, j;
+
+	/* Reflect stream contents to share */
+	for (i = 0; i < n; ++i) {
+
+		/* Get the reading position of the stream */
+		slb_uint_t pos = stream[i].pos;
+		const slb_uint32_t key = stream[i].tag_key;
+		slb_uint32_t tag = 0, tag_read;
+		slb_uint32_t*const p_tag = ( key != 0U ) ? &tag : SLB_NULL;
+
+		/* Read share values (and update share tag) */
+		if (stream[i].const_time) {
+			pos = sss_get_values_ct( stream[i].data, pos, nmb, share[i], key, p_tag );
+		}
+		else {
+			for (j = 0; j < nmb; ++j) {
+				share[i][j] = sss_get_value( stream[i].data, &pos, key, p_tag );
+			}
+		}
+
+		/* Verify share tag of the chunk */
+		if (key != 0U) {
+			if (stream[i].const_time) {
+				pos = sss_get_values_ct( stream[i].data, pos, 1, &tag_read, 0U, SLB_NULL );
+			}
+			else {
+				tag_read = sss_get_value( stream[i].data, &pos, 0U, SLB_NULL );
+			}
+
+			if (tag_read != tag) {
+				tag_matched = SLB_FALSE;
+			}
+		}
+
+		/* Update position of stream */
+		stream[i].pos = pos;
+	}
+
+	return tag_matched;
+}
+
+/* Gets random x coordinates */
+void sss_get_random_x(H_SLB_SSS hEncode, slb_int_t n, slb_uint16_t x[])
+{
+	const slb_int_t max_players = (slb_int_t)slb_sss_get_max_players_decode();
+	const slb_uint_t x_src_size = sizeof(slb_uint16_t) * (slb_uint_t)max_players;
+	slb_uint16_t* x_src = (slb_uint16_t*)slb_alloc( &g_mem_callback_param, x_src_size );
+	const slb_uint_t rand_val_size = sizeof(slb_uint_t) * (slb_uint_t)n;
+	slb_uint_t* rand_val = (slb_uint_t*)slb_alloc( &g_mem_callback_param, rand_val_size );
+	slb_int_t i, j;
+
+	for (i = 0; i < max_players; ++i) {
+		x_src[i] = (slb_uint16_t)(i + 1);
+	}
+
+	ASSERT( slb_sss_rand(hEncode, rand_val_size, rand_val) == R_SUCCESS );
+
+	for (i = 0; i < n; ++i) {
+		j = (slb_int_t)( rand_val[i] % (slb_uint_t)(max_players - i) );
+		j += i;
+		x[i] = x_src[j];
+		x_src[j] =  x_src[i];
+	}
+
+	slb_free( &g_mem_callback_param, x_src, SLB_FALSE );
+	slb_free( &g_mem_callback_param, rand_val, SLB_FALSE );
+}
+
+/* Gets the keys of share tag
+	The key is a nonzero value of GF(65537).
+*/
+void sss_get_tag_keys(H_SLB_SSS hEncode, slb_int_t n, STREAM_BUFF* stream)
+{
+	const slb_uint_t rand_val_size = sizeof(slb_uint32_t) * (slb_uint_t)n;
+	slb_uint32_t* rand_val = (slb_uint32_t*)slb_alloc( &g_mem_callback_param, rand_val_size );
+	slb_int_t i;
+
+	ASSERT( slb_sss_rand(hEncode, rand_val_size, rand_val) == R_SUCCESS );
+
+	for (i = 0; i < n; ++i) {
+		stream[i].tag_key = ( rand_val[i] % ( SSS_GFP_PRIME - 1U ) ) + 1U;
+	}
+
+	slb_free( &g_mem_callback_param, rand_val, SLB_TRUE );
+}
+
+/* Corrupts the first share value in stream
+	The value is changed without changing its length in stream.
+*/
+void sss_corrupt_stream(STREAM_BUFF* stream)
+{
+	slb_uint_t pos = 0;
+	slb_uint32_t value;
+
+	/* The lower 16 bits are always written first in constant-time layout */
+	if (stream->const_time) {
+		stream->data[1] ^= 1U;
+		return;
+	}
+
+	value = sss_get_value(stream->data, &pos, 0U, SLB_NULL);
+
+	if ( ( value & SLB_MASK_OF_UINT16 ) == 0U ) {
+		value ^= SSS_GFP_PRIME - 1U;			/* 0 <-> 65536 */
+	}
+	else {
+		value ^= (value == 1U) ? 2U : 1U;		/* low value remains nonzero */
+	}
+
+	(void)sss_put_value(stream->data, 0, value, 0U, SLB_NULL);
+}
+
+/* Checks information */
+void check_max(H_SLB_SSS handle, slb_int_t k_max, slb_int_t n_max)
+{
+	slb_uint_t info_val;
+
+	info_val = slb_sss_get_info_k_max(handle);
+	if ( info_val != (slb_uint_t)k_max ) {
+		printf("!!! unexpected k_max\n");
+		ASSERT(SLB_FALSE);
+	}
+
+	info_val = slb_sss_get_info_n_max(handle);
+	if ( info_val != (slb_uint_t)n_max ) {
+		printf("!!! unexpected n_max\n");
+		ASSERT(SLB_FALSE);
+	}
+}
+
+void check_info(H_SLB_SSS handle, slb_int_t k, slb_int_t n, slb_int_t index, slb_uint16_t xval)
+{
+	slb_uint_t info_val;
+	slb_uint16_t info_x;
+
+	info_val = slb_sss_get_info_k(handle);
+	if ( info_val != (slb_uint_t)k ) {
+		printf("!!! unexpected k\n");
+		ASSERT(SLB_FALSE);
+	}
+
+	info_val = slb_sss_get_info_n(handle);
+	if ( info_val != (slb_uint_t)n ) {
 		printf("!!! unexpected n\n");
 		ASSERT(SLB_FALSE);
 	}
@@ -822,6 +4745,53 @@ void free_callback(void* param, void* p, slb_uint_t size, slb_bool_t cleared)
 	free(p);
 }
 
+/* Extended memory management callback function
+	The buffers are routed by the usage: a practical application allocates the plain data
+	and the coefficients from non-swap memory, and the shares from huge pages.
+	The plain data and the coefficients are wiped by the modules before the free.
+*/
+void* alloc2_callback(void* param, slb_uint_t size, slb_uint_t alignment, SSS_MEM_USAGE usage, SSS_MEM_LIFETIME lifetime)
+{
+	void* p;
+
+	ASSERT( GetCurrentThreadId() == g_MyThreadId );		/* Check thread ID */
+	ASSERT( param == &g_mem_callback_param );			/* Check parameter */
+	ASSERT( ( alignment & ( alignment - 1U ) ) == 0U );
+	ASSERT( lifetime == SSS_MEM_HANDLE );
+
+	if (alignment < sizeof(void*)) {
+		alignment = sizeof(void*);
+	}
+#if defined(_MSC_VER)
+	p = _aligned_malloc(size, alignment);
+#else
+	if ( posix_memalign(&p, alignment, size) != 0 ) {
+		p = SLB_NULL;
+	}
+#endif
+	if (p != SLB_NULL) {
+		g_alloc2_size[usage] += size;
+		if (g_alloc2_peak[usage] < g_alloc2_size[usage]) {
+			g_alloc2_peak[usage] = g_alloc2_size[usage];
+		}
+	}
+	return p;
+}
+
+void free2_callback(void* param, void* p, slb_uint_t size, SSS_MEM_USAGE usage, slb_bool_t wiped)
+{
+	ASSERT( GetCurrentThreadId() == g_MyThreadId );		/* Check thread ID */
+	ASSERT( param == &g_mem_callback_param );			/* Check parameter */
+	ASSERT( wiped || (usage == SSS_MEM_SHARE) || (usage == SSS_MEM_TABLE) );
+
+	g_alloc2_size[usage] -= size;
+#if defined(_MSC_VER)
+	_aligned_free(p);
+#else
+	free(p);
+#endif
+}
+
 /* Random function to be called back
 	Although the rand function is used to focus on how to use libslbsss,
 	when creating practical applications, please use a high-quality random number generation function.
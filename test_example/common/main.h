@@ -5,6 +5,8 @@
 #define MAIN_H
 
 #include "libslbsss.h"
+#include "sss_mem.h"
+#include "sss_interp.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -15,11 +17,37 @@ extern "C" {
 	In a real application it could also be a file.
 */
 typedef struct {
-	slb_uint16_t	x;		/* x-coordinate */
-	slb_uint_t		pos;	/* write/read position */
-	slb_uint8_t*	data;	/* data */
+	slb_uint16_t	x;			/* x-coordinate */
+	slb_uint32_t	tag_key;	/* key of share tag (=0: no tag) */
+	slb_bool_t		const_time;	/* =SLB_TRUE: constant-time layout */
+	slb_uint_t		pos;		/* write/read position */
+	slb_uint8_t*	data;		/* data */
 } STREAM_BUFF;
 
+/* Parameter for timing leakage check */
+typedef struct {
+	H_SLB_SSS		hEncode;		/* control handle to encode */
+	H_SLB_SSS		hDecode;		/* control handle to decode */
+	slb_int_t		n;				/* number of shares */
+	slb_int_t		nmb;			/* number of data */
+	slb_uint16_t*	plain;			/* plain data */
+	slb_uint32_t*	value;			/* field values */
+	slb_uint32_t	result;			/* result of field operation */
+	slb_uint32_t**	share;			/* share buffer */
+	slb_uint32_t**	fixed_share;	/* shares of fixed plain data */
+	STREAM_BUFF*	stream;			/* stream */
+	slb_bool_t		const_time;		/* =SLB_TRUE: constant-time layout */
+} TIMING_PARAM;
+
+/* Parameter for decoding with a thread team */
+typedef struct {
+	SSS_INTERP*		interp;			/* interpolation decoding handles [threads] */
+	slb_int_t		k;				/* threshold */
+	const slb_uint32_t**	share;	/* share buffer [k] */
+	slb_uint16_t*	plain;			/* plain data */
+	SLB_RC			rc;				/* result (R_SUCCESS: no error) */
+} TEAM_DECODE_PARAM;
+
 int main(int argc, char* argv[]);
 
 void sss_example_sub(
@@ -32,6 +60,14 @@ void sss_example_sub(
 	slb_uint_t			simd_flags		/* SIMD flags to use */
 );
 
+void sss_example_modules(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k_min,			/* minimum threshold */
+	slb_bool_t			bAVX2,			/* =SLB_TRUE: AVX2 is available */
+	slb_bool_t			bAVX512			/* =SLB_TRUE: AVX512 is available */
+);
+
 void sss_example_encode(
 	H_SLB_SSS			hEncode,		/* control handle to encode */
 	slb_int_t			plainsize,		/* plain size */
@@ -49,14 +85,185 @@ void sss_example_decode(
 	slb_int_t			cur_k,			/* current threshold */
 	const slb_uint16_t*	plain,			/* plain data */
 	STREAM_BUFF*		stream,			/* stream */
-	slb_bool_t			plain_match		/* =SLB_TRUE: expects plain data match */
+	slb_bool_t			plain_match,	/* =SLB_TRUE: expects plain data match */
+	slb_bool_t			tag_match		/* =SLB_TRUE: expects share tags match */
+);
+
+void sss_example_robust_decode(
+	H_SLB_SSS			hDecode,		/* control handle to decode */
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			cur_k,			/* current threshold */
+	const slb_uint16_t*	plain,			/* plain data */
+	STREAM_BUFF*		stream,			/* stream */
+	slb_bool_t			sparse			/* =SLB_TRUE: a few words of each corrupted share are corrupted */
+);
+
+void sss_example_gf256(
+	slb_int_t			plainsize,		/* plain size (bytes) */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k,				/* threshold */
+	slb_bool_t			ssse3,			/* =SLB_TRUE: SSSE3 is used */
+	slb_bool_t			gfni			/* =SLB_TRUE: GFNI is used */
+);
+
+void sss_example_gf65536(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k,				/* threshold */
+	slb_bool_t			ssse3,			/* =SLB_TRUE: SSSE3 is used */
+	slb_bool_t			gfni			/* =SLB_TRUE: GFNI is used */
+);
+
+void sss_example_ntt(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+
+void sss_example_interp(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+
+void sss_example_gemm(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+
+void sss_example_plan(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+
+void sss_example_packed(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k,				/* privacy threshold */
+	slb_int_t			l				/* number of plain data of a polynomial */
+);
+
+void sss_example_step(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+
+void sss_example_online(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
 );
 
+void sss_example_partial(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k,				/* threshold */
+	slb_bool_t			avx2,			/* =SLB_TRUE: AVX2 is used */
+	slb_bool_t			avx512			/* =SLB_TRUE: AVX-512 is used */
+);
+
+void sss_example_bytes(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k,				/* threshold */
+	slb_bool_t			avx2			/* =SLB_TRUE: AVX2 is used */
+);
+
+void sss_example_wipe(
+	slb_int_t			n,				/* number of shares */
+	slb_bool_t			avx2			/* =SLB_TRUE: AVX2 is used */
+);
+
+void sss_example_pool(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+void pool_task(void* param, slb_uint_t thread, slb_int_t start, slb_int_t end);
+double pool_cycle(slb_int_t n, slb_int_t k, slb_int_t loop);
+
+void sss_example_mem(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+
+void sss_example_tune(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+
+void sss_example_topo(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+#if defined(__GNUC__)
+slb_bool_t topo_mock(const char* root, slb_bool_t create);
+#endif
+
+void sss_example_team(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+void team_empty_task(void* param, slb_uint_t thread, slb_int_t start, slb_int_t end);
+void team_decode_task(void* p, slb_uint_t thread, slb_int_t start, slb_int_t end);
+
+void sss_example_metrics(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+void metrics_task(void* param, slb_uint_t thread, slb_int_t start, slb_int_t end);
+
+void sss_example_stream(
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+
+void sss_example_multi(
+	slb_int_t			plainsize		/* plain size */
+);
+void sss_example_lz(
+	slb_int_t			plainsize,		/* plain size */
+	slb_int_t			n,				/* number of shares */
+	slb_int_t			k				/* threshold */
+);
+slb_bool_t fast_rand_callback(void* param, slb_uint_t len, void* rnd_buff);
+
+void sss_example_tag(void);
+void sss_example_res(void);
+
+void sss_example_timing(void);
+void print_timing(const char* name, double t);
+void timing_prepare_encode(void* p, slb_uint_t cls);
+void timing_run_encode(void* p);
+void timing_prepare_decode(void* p, slb_uint_t cls);
+void timing_run_decode(void* p);
+void timing_prepare_stream(void* p, slb_uint_t cls);
+void timing_run_stream(void* p);
+void timing_prepare_gfp(void* p, slb_uint_t cls);
+void timing_run_gfp(void* p);
+
 void sss_reset_stream_pos(
 	slb_int_t			n,			/* number of shares */
 	STREAM_BUFF*const	stream		/* stream buffer */
 );
 
+slb_uint_t sss_put_value(
+	slb_uint8_t*		data,		/* stream data */
+	slb_uint_t			pos,		/* write position */
+	slb_uint32_t		value,		/* share value */
+	slb_uint32_t		key,		/* key of share tag */
+	slb_uint32_t*		tag			/* [in/out] share tag (SLB_NULL: not updated) */
+);
+
+slb_uint32_t sss_get_value(
+	const slb_uint8_t*	data,		/* stream data */
+	slb_uint_t*			p_pos,		/* read position */
+	slb_uint32_t		key,		/* key of share tag */
+	slb_uint32_t*		tag			/* [in/out] share tag (SLB_NULL: not updated) */
+);
+
 void sss_share_to_stream(
 	slb_int_t			n,			/* number of shares */
 	slb_int_t			nmb,		/* number of use */
@@ -64,7 +271,25 @@ void sss_share_to_stream(
 	STREAM_BUFF*const	stream		/* stream buffer */
 );
 
-void sss_stream_to_share(
+slb_uint_t sss_put_values_ct(
+	slb_uint8_t*		data,		/* stream data */
+	slb_uint_t			pos,		/* write position */
+	slb_int_t			nmb,		/* number of values */
+	const slb_uint32_t*	value,		/* share values */
+	slb_uint32_t		key,		/* key of share tag */
+	slb_uint32_t*		tag			/* [in/out] share tag (SLB_NULL: not updated) */
+);
+
+slb_uint_t sss_get_values_ct(
+	const slb_uint8_t*	data,		/* stream data */
+	slb_uint_t			pos,		/* read position */
+	slb_int_t			nmb,		/* number of values */
+	slb_uint32_t*		value,		/* [out] share values */
+	slb_uint32_t		key,		/* key of share tag */
+	slb_uint32_t*		tag			/* [in/out] share tag (SLB_NULL: not updated) */
+);
+
+slb_bool_t sss_stream_to_share(
 	slb_int_t			n,			/* number of shares */
 	slb_int_t			nmb,		/* number of use */
 	STREAM_BUFF*const	stream,		/* stream buffer */
@@ -72,6 +297,8 @@ void sss_stream_to_share(
 );
 
 void sss_get_random_x(H_SLB_SSS hEncode, slb_int_t n, slb_uint16_t x[]);
+void sss_get_tag_keys(H_SLB_SSS hEncode, slb_int_t n, STREAM_BUFF* stream);
+void sss_corrupt_stream(STREAM_BUFF* stream);
 
 void check_max(H_SLB_SSS handle, slb_int_t k_max, slb_int_t n_max);
 void check_info(H_SLB_SSS handle, slb_int_t k, slb_int_t n, slb_int_t index, slb_uint16_t xval);
@@ -82,6 +309,8 @@ void disp_stat(H_SLB_SSS handle);
 
 void* alloc_callback(void* param, slb_uint_t size);
 void free_callback(void* param, void* p, slb_uint_t size, slb_bool_t cleared);
+void* alloc2_callback(void* param, slb_uint_t size, slb_uint_t alignment, SSS_MEM_USAGE usage, SSS_MEM_LIFETIME lifetime);
+void free2_callback(void* param, void* p, slb_uint_t size, SSS_MEM_USAGE usage, slb_bool_t wiped);
 slb_bool_t rand_callback(void* param, slb_uint_t len, void* rnd_buff);
 slb_bool_t user_callback(void* param);
 
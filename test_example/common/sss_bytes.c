@@ -0,0 +1,98 @@
+/*******************************************************************************
+ Byte order of plain data
+ *******************************************************************************/
+#include "sss_bytes.h"
+#include "cpuinfo.h"
+
+#include <immintrin.h>
+
+static slb_int_t bytes_load_avx2(slb_int_t len, const slb_uint8_t* bytes, slb_uint32_t* words);
+static slb_int_t bytes_store_avx2(slb_int_t len, const slb_uint32_t* words, slb_uint8_t* bytes);
+
+static slb_bool_t s_avx2 = SLB_FALSE;
+
+/* Sets SIMD to be used */
+void sss_bytes_set_simd(
+	slb_bool_t			avx2		/* =SLB_TRUE: AVX2 is used */
+)
+{
+	s_avx2 = avx2;
+}
+
+/* Loads bytes to words */
+void sss_bytes_load(
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint8_t*	bytes,		/* bytes */
+	slb_uint32_t*		words		/* [out] words [SSS_BYTES_WORDS(len)] */
+)
+{
+	slb_int_t i = 0;
+
+	if (s_avx2) {
+		i = bytes_load_avx2( len, bytes, words );
+	}
+	for (; i + 1 < len; i += 2) {
+		words[i / 2] = ( (slb_uint32_t)bytes[i] << 8 ) | bytes[i + 1];
+	}
+	if (i < len) {
+		words[i / 2] = (slb_uint32_t)bytes[i] << 8;
+	}
+}
+
+/* Stores words to bytes */
+void sss_bytes_store(
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint32_t*	words,		/* words (less than 65536) */
+	slb_uint8_t*		bytes		/* [out] bytes [len] */
+)
+{
+	slb_int_t i = 0;
+
+	if (s_avx2) {
+		i = bytes_store_avx2( len, words, bytes );
+	}
+	for (; i + 1 < len; i += 2) {
+		bytes[i] = (slb_uint8_t)( words[i / 2] >> 8 );
+		bytes[i + 1] = (slb_uint8_t)words[i / 2];
+	}
+	if (i < len) {
+		bytes[i] = (slb_uint8_t)( words[i / 2] >> 8 );
+	}
+}
+
+/* Load (AVX2, 16 bytes: swap the bytes of each pair and zero-extend)
+	Returns the number of bytes processed.
+*/
+SIMD_TARGET("avx2")
+static slb_int_t bytes_load_avx2(slb_int_t len, const slb_uint8_t* bytes, slb_uint32_t* words)
+{
+	const __m128i swap = _mm_setr_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+	__m128i v;
+	slb_int_t i;
+
+	for (i = 0; i + 16 <= len; i += 16) {
+		v = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*)&bytes[i] ), swap );
+		_mm256_storeu_si256( (__m256i*)&words[i / 2], _mm256_cvtepu16_epi32(v) );
+	}
+	return i;
+}
+
+/* Store (AVX2, 32 bytes: pack 16 words to 16 bits, and swap the bytes of each pair)
+	Returns the number of bytes processed.
+*/
+SIMD_TARGET("avx2")
+static slb_int_t bytes_store_avx2(slb_int_t len, const slb_uint32_t* words, slb_uint8_t* bytes)
+{
+	const __m256i swap = _mm256_setr_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+										   1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+	__m256i v;
+	slb_int_t i;
+
+	for (i = 0; i + 32 <= len; i += 32) {
+		v = _mm256_packus_epi32( _mm256_loadu_si256( (const __m256i*)&words[i / 2] ),
+								 _mm256_loadu_si256( (const __m256i*)&words[i / 2 + 8] ) );
+		v = _mm256_shuffle_epi8( _mm256_permute4x64_epi64(v, 0xd8), swap );
+		_mm256_storeu_si256( (__m256i*)&bytes[i], v );
+	}
+	return i;
+}
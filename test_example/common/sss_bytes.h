@@ -0,0 +1,46 @@
+/*******************************************************************************
+ Byte order of plain data
+ -------------------------------------------------------------------------------
+ The byte API of the example modules (sss_gemm_encode_bytes and
+ sss_interp_decode_bytes) takes the plain data as bytes in a defined order:
+	word[d] = ( bytes[2d] << 8 ) | bytes[2d+1]		(big endian, network order)
+ For an odd length, the low byte of the last word is 0, and only the high byte
+ is written back by decoding.
+
+ The conversion is done in the load and the store of the coding, so that no
+ intermediate buffer of 16-bit words is needed.
+ *******************************************************************************/
+#ifndef SSS_BYTES_H
+#define SSS_BYTES_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of words of the bytes */
+#define SSS_BYTES_WORDS(len)	( ( (len) + 1 ) / 2 )
+
+/***** Function *****/
+void sss_bytes_set_simd(
+	slb_bool_t			avx2		/* =SLB_TRUE: AVX2 is used */
+);
+
+void sss_bytes_load(
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint8_t*	bytes,		/* bytes */
+	slb_uint32_t*		words		/* [out] words [SSS_BYTES_WORDS(len)] */
+);
+
+void sss_bytes_store(
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint32_t*	words,		/* words (less than 65536) */
+	slb_uint8_t*		bytes		/* [out] bytes [len] */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_BYTES_H */
@@ -0,0 +1,33 @@
+/*******************************************************************************
+ Monotonic clock
+ *******************************************************************************/
+#include "sss_clock.h"
+
+#if defined(_MSC_VER)
+#	include <windows.h>
+#else
+#	include <time.h>
+#endif
+
+/* Returns the monotonic time in nanoseconds */
+slb_uint64_t sss_clock_ns(void)
+{
+#if defined(_MSC_VER)
+	LARGE_INTEGER count, freq;
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&freq);
+	/* The seconds and the rest are scaled separately not to overflow */
+	return (slb_uint64_t)( count.QuadPart / freq.QuadPart ) * 1000000000U
+		 + (slb_uint64_t)( count.QuadPart % freq.QuadPart ) * 1000000000U / (slb_uint64_t)freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (slb_uint64_t)ts.tv_sec * 1000000000U + (slb_uint64_t)ts.tv_nsec;
+#endif
+}
+
+/* Returns the monotonic time in milliseconds */
+double sss_clock_ms(void)
+{
+	return (double)sss_clock_ns() / 1000000.0;
+}
@@ -0,0 +1,27 @@
+/*******************************************************************************
+ Monotonic clock
+ -------------------------------------------------------------------------------
+ One clock of the example modules for the tuning, the time budget of the steps,
+ the metrics and the measurements of the examples.
+	Windows		QueryPerformanceCounter
+	Linux		clock_gettime(CLOCK_MONOTONIC)
+ *******************************************************************************/
+#ifndef SSS_CLOCK_H
+#define SSS_CLOCK_H
+
+#include "slb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***** Function *****/
+slb_uint64_t sss_clock_ns(void);
+
+double sss_clock_ms(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_CLOCK_H */
@@ -0,0 +1,499 @@
+/*******************************************************************************
+ GEMM encoding
+ *******************************************************************************/
+#include "sss_gemm.h"
+#include "sss_gfp.h"
+#include "sss_bytes.h"
+#include "sss_mem.h"
+#include "sss_wipe.h"
+#include "sss_metrics.h"
+#include "sss_clock.h"
+#include "cpuinfo.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+#define GEMM_ROWS		4		/* Number of shares of a register block */
+
+static SLB_RC gemm_encode(SSS_GEMM* gemm, slb_int_t nmb, slb_uint32_t** share, SSS_METRIC* simd);
+static slb_bool_t gemm_plain_row(const SSS_ENCODE_PLAN* plan, slb_uint_t j);
+static slb_uint_t gemm_span(const SSS_ENCODE_PLAN* plan, slb_uint_t i0, slb_uint_t* lo, slb_uint_t* hi);
+static void gemm_block(SSS_GEMM* gemm, slb_uint_t i0, slb_uint_t rows, slb_uint_t j0, slb_uint_t j1, slb_bool_t first,
+					   slb_int_t d0, slb_int_t width, slb_int_t nmb, slb_uint32_t** share);
+static slb_int_t gemm_block_avx2(SSS_GEMM* gemm, slb_uint_t i0, slb_uint_t j0, slb_uint_t j1, slb_bool_t first,
+					   slb_int_t d0, slb_int_t width, slb_int_t nmb, slb_uint32_t** share, slb_bool_t stream);
+static slb_int_t gemm_block_avx512(SSS_GEMM* gemm, slb_uint_t i0, slb_uint_t j0, slb_uint_t j1, slb_bool_t first,
+					   slb_int_t d0, slb_int_t width, slb_int_t nmb, slb_uint32_t** share, slb_bool_t stream);
+static void gemm_sfence_avx2(void);
+
+static slb_bool_t s_avx2 = SLB_FALSE;
+static slb_bool_t s_avx512 = SLB_FALSE;
+
+/* Sets SIMD to be used */
+void sss_gemm_set_simd(
+	slb_bool_t			avx2,		/* =SLB_TRUE: AVX2 is used */
+	slb_bool_t			avx512		/* =SLB_TRUE: AVX-512 is used */
+)
+{
+	s_avx2 = avx2;
+	s_avx512 = avx512;
+}
+
+/* Opens GEMM encoding handle */
+SLB_RC sss_gemm_open(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	slb_uint_t			n_max,		/* maximum number of shares */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param,	/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func,	/* random number callback */
+	void*				rand_param	/* parameter for random number callback */
+)
+{
+	memset(gemm, 0, sizeof(*gemm));
+
+	if ( (k_max < SLB_SSS_MIN_PLAYERS) || (n_max < k_max) || (slb_sss_get_max_players_decode() < n_max) ||
+		 (nmb_max <= 0) || (rand_func == SLB_NULL) ) {
+		return R_INVALID_PARAM;
+	}
+
+	gemm->k_max = k_max;
+	gemm->n_max = n_max;
+	gemm->nmb_max = nmb_max;
+	gemm->mem_param = mem_param;
+	gemm->rand_func = rand_func;
+	gemm->rand_param = rand_param;
+	gemm->llc = GetCacheSize(3U);
+	if (gemm->llc == 0U) {
+		gemm->llc = SSS_GEMM_LLC_DEFAULT;
+	}
+
+	gemm->coef = sss_mem_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint32_t) * k_max * (slb_uint_t)nmb_max ),
+								SSS_MEM_ALIGN, SSS_MEM_COEF, SSS_MEM_HANDLE );
+	gemm->rnd = sss_mem_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint64_t) * (slb_uint_t)nmb_max ),
+							   SSS_MEM_ALIGN, SSS_MEM_COEF, SSS_MEM_HANDLE );
+	if ( (gemm->coef == SLB_NULL) || (gemm->rnd == SLB_NULL) ) {
+		sss_gemm_close(gemm);
+		return R_LOW_MEMORY;
+	}
+
+	return R_SUCCESS;
+}
+
+/* Starts encoding
+	The encode plan of the handle is built. The x coordinates are in the range of slb_sss_decode.
+*/
+SLB_RC sss_gemm_start(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	const slb_uint16_t	x[]			/* x coordinates */
+)
+{
+	SLB_RC rc;
+
+	gemm->plan = SLB_NULL;
+	sss_plan_free(&gemm->own);
+	if ( (gemm->k_max < k) || (gemm->n_max < n) ) {
+		return R_INVALID_PARAM;
+	}
+
+	rc = sss_plan_build( &gemm->own, k, n, x, gemm->mem_param );
+	if ( SLB_R_SUCCEEDED(rc) ) {
+		gemm->plan = &gemm->own;
+	}
+	return rc;
+}
+
+/* Starts encoding with a shared encode plan
+	The plan must not be freed until the handle is closed or started again.
+*/
+SLB_RC sss_gemm_start_plan(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	const SSS_ENCODE_PLAN*	plan	/* encode plan */
+)
+{
+	gemm->plan = SLB_NULL;
+	if ( (plan->mat == SLB_NULL) || (gemm->k_max < plan->m) ) {
+		return R_INVALID_PARAM;
+	}
+
+	gemm->plan = plan;
+	return R_SUCCESS;
+}
+
+/* Encodes plain data
+	With a packed plan, the plain data is of l * nmb, and row j of the coefficients is
+	plain[j * nmb] to plain[j * nmb + nmb - 1].
+*/
+SLB_RC sss_gemm_encode(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	slb_int_t			nmb,		/* number of data of a share */
+	const slb_uint16_t*	plain,		/* plain data [l * nmb] */
+	slb_uint32_t**		share		/* [out] share buffer [n] */
+)
+{
+	const slb_uint64_t start = sss_clock_ns();
+	SLB_RC rc;
+	SSS_METRIC simd;
+	slb_int_t d;
+
+	if (gemm->plan == SLB_NULL) {
+		return R_SSS_NOT_STARTED;
+	}
+	if ( (nmb <= 0) || (gemm->nmb_max < nmb) ) {
+		return R_INVALID_PARAM;
+	}
+
+	for (d = 0; d < nmb * (slb_int_t)gemm->plan->l; ++d) {
+		gemm->coef[d] = plain[d];
+	}
+	rc = gemm_encode( gemm, nmb, share, &simd );
+	if ( SLB_R_SUCCEEDED(rc) ) {
+		sss_metrics_call( SSS_METRIC_OP_ENCODE, sizeof(slb_uint16_t) * (slb_uint64_t)nmb * gemm->plan->l, simd, start );
+	}
+	return rc;
+}
+
+/* Encodes bytes (see sss_bytes.h)
+	The bytes are loaded into the plain rows of the coefficients directly, and
+	the rest of the rows is 0. nmb is the number of data of a share for the bytes.
+*/
+SLB_RC sss_gemm_encode_bytes(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint8_t*	bytes,		/* plain bytes */
+	slb_int_t*			nmb,		/* [out] number of data of a share */
+	slb_uint32_t**		share		/* [out] share buffer [n] */
+)
+{
+	const slb_uint64_t start = sss_clock_ns();
+	SLB_RC rc;
+	SSS_METRIC simd;
+	slb_int_t l, words;
+
+	if (gemm->plan == SLB_NULL) {
+		return R_SSS_NOT_STARTED;
+	}
+	l = (slb_int_t)gemm->plan->l;
+	if ( (len <= 0) || (bytes == SLB_NULL) || (nmb == SLB_NULL) ) {
+		return R_INVALID_PARAM;
+	}
+	words = SSS_BYTES_WORDS(len);
+	*nmb = ( words + l - 1 ) / l;
+	if (gemm->nmb_max < *nmb) {
+		return R_INVALID_PARAM;
+	}
+
+	sss_bytes_load( len, bytes, gemm->coef );
+	memset( &gemm->coef[words], 0, sizeof(slb_uint32_t) * (slb_uint_t)( *nmb * l - words ) );
+	rc = gemm_encode( gemm, *nmb, share, &simd );
+	if ( SLB_R_SUCCEEDED(rc) ) {
+		sss_metrics_call( SSS_METRIC_OP_ENCODE, (slb_uint64_t)len, simd, start );
+	}
+	return rc;
+}
+
+/* Sets share output */
+void sss_gemm_set_stream(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	SSS_GEMM_STREAM		stream		/* share output */
+)
+{
+	gemm->stream = stream;
+}
+
+/* Closes GEMM encoding handle */
+void sss_gemm_close(
+	SSS_GEMM*			gemm		/* GEMM encoding handle */
+)
+{
+	void* mem_param = gemm->mem_param;
+
+	sss_plan_free(&gemm->own);
+	/* wiped after each encoding */
+	sss_mem_free( mem_param, gemm->coef, (slb_uint_t)( sizeof(slb_uint32_t) * gemm->k_max * (slb_uint_t)gemm->nmb_max ),
+				  SSS_MEM_COEF, SLB_TRUE );
+	sss_mem_free( mem_param, gemm->rnd, (slb_uint_t)( sizeof(slb_uint64_t) * (slb_uint_t)gemm->nmb_max ),
+				  SSS_MEM_COEF, SLB_TRUE );
+
+	memset(gemm, 0, sizeof(*gemm));
+}
+
+/* Encodes the coefficients of which the plain rows are set
+	(the 64-bit random numbers are reduced, so the bias is negligible)
+	With a multi-policy plan, the plain row is copied to the first column of each policy,
+	and each block of shares is multiplied only by the columns of its policies.
+	simd is the kernel of the most of the products (blocks of less than GEMM_ROWS shares
+	and the tails are by the scalar kernel).
+*/
+static SLB_RC gemm_encode(SSS_GEMM* gemm, slb_int_t nmb, slb_uint32_t** share, SSS_METRIC* simd)
+{
+	const slb_uint_t row = (slb_uint_t)nmb;
+	const slb_uint_t k = gemm->plan->m;
+	const slb_uint_t l = gemm->plan->l;
+	const slb_uint_t n = gemm->plan->n;
+	slb_uint_t i0, j0, j1, rows, lo, hi, ja, jb;
+	slb_int_t p0, pw, d;
+	slb_bool_t stream, last;
+	slb_uint64_t streamed = 0, random = 0;
+	slb_uint64_t vector = 0, scalar = 0;
+
+	/* Non-temporal stores (SIMD kernels with aligned share rows) */
+	stream = (gemm->stream == SSS_GEMM_STREAM_ON) ||
+			 ( (gemm->stream == SSS_GEMM_STREAM_AUTO) && ( gemm->llc <= sizeof(slb_uint32_t) * (slb_uint64_t)n * row ) );
+	stream = stream && (s_avx2 || s_avx512);
+	for (i0 = 0; stream && (i0 < n); ++i0) {
+		stream = ( ( (size_t)share[i0] & 63U ) == 0U );
+	}
+
+	for (j0 = l; j0 < k; ++j0) {
+		if ( gemm_plain_row( gemm->plan, j0 ) ) {
+			memcpy( &gemm->coef[j0 * row], gemm->coef, sizeof(slb_uint32_t) * row );
+			continue;
+		}
+		random += sizeof(slb_uint64_t) * (slb_uint64_t)row;
+		if ( !gemm->rand_func( gemm->rand_param, sizeof(slb_uint64_t) * row, gemm->rnd ) ) {
+			sss_wipe_class( SSS_WIPE_COEF, gemm->coef, (slb_uint_t)sizeof(slb_uint32_t) * k * row );
+			sss_wipe_class( SSS_WIPE_COEF, gemm->rnd, (slb_uint_t)sizeof(slb_uint64_t) * row );
+			return R_RAND_FAIL;
+		}
+		for (d = 0; d < nmb; ++d) {
+			gemm->coef[j0 * row + (slb_uint_t)d] = sss_gfp_reduce( gemm->rnd[d] );
+		}
+	}
+
+	/* Panels of data, k-blocks, and register blocks of shares */
+	for (p0 = 0; p0 < nmb; p0 += SSS_GEMM_PANEL) {
+		pw = ( nmb - p0 < SSS_GEMM_PANEL ) ? nmb - p0 : SSS_GEMM_PANEL;
+		for (j0 = 0; j0 < k; j0 = j1) {
+			j1 = ( k - j0 < SSS_GEMM_KBLOCK ) ? k : j0 + SSS_GEMM_KBLOCK;
+			for (i0 = 0; i0 < n; i0 += rows) {
+				rows = gemm_span( gemm->plan, i0, &lo, &hi );
+				ja = ( j0 < lo ) ? lo : j0;
+				jb = ( j1 < hi ) ? j1 : hi;
+				if (jb <= ja) {
+					continue;
+				}
+				last = stream && (jb == hi);
+				d = 0;
+				if (rows == GEMM_ROWS) {
+					if (s_avx512) {
+						d = gemm_block_avx512( gemm, i0, ja, jb, ja == lo, p0, pw, nmb, share, last );
+					}
+					else if (s_avx2) {
+						d = gemm_block_avx2( gemm, i0, ja, jb, ja == lo, p0, pw, nmb, share, last );
+					}
+					if (last) {
+						streamed += sizeof(slb_uint32_t) * GEMM_ROWS * (slb_uint64_t)d;
+					}
+				}
+				gemm_block( gemm, i0, rows, ja, jb, ja == lo, p0 + d, pw - d, nmb, share );
+				vector += (slb_uint64_t)rows * (slb_uint64_t)d * ( jb - ja );
+				scalar += (slb_uint64_t)rows * (slb_uint64_t)( pw - d ) * ( jb - ja );
+			}
+		}
+	}
+
+	if (stream) {
+		gemm_sfence_avx2();
+		sss_metrics_add( SSS_METRIC_STREAM_BYTES, streamed );
+	}
+
+	sss_wipe_class( SSS_WIPE_COEF, gemm->coef, (slb_uint_t)sizeof(slb_uint32_t) * k * row );
+	sss_wipe_class( SSS_WIPE_COEF, gemm->rnd, (slb_uint_t)sizeof(slb_uint64_t) * row );
+	sss_metrics_add( SSS_METRIC_RNG_BYTES, random );
+	*simd = ( vector < scalar ) ? SSS_METRIC_SIMD_NONE
+		  : s_avx512 ? SSS_METRIC_SIMD_AVX512 : SSS_METRIC_SIMD_AVX2;
+
+	return R_SUCCESS;
+}
+
+/* Returns whether row j of the coefficients is a copy of the plain row (multi-policy plan) */
+static slb_bool_t gemm_plain_row(const SSS_ENCODE_PLAN* plan, slb_uint_t j)
+{
+	slb_uint_t p;
+
+	for (p = 1U; p < plan->npolicy; ++p) {
+		if (plan->span[2U * plan->n + p] == j) {
+			return SLB_TRUE;
+		}
+	}
+	return SLB_FALSE;
+}
+
+/* Returns the number of the shares of a block from share i0, and their nonzero columns lo to hi - 1
+	A block does not straddle policies, so that it has no zero columns.
+*/
+static slb_uint_t gemm_span(const SSS_ENCODE_PLAN* plan, slb_uint_t i0, slb_uint_t* lo, slb_uint_t* hi)
+{
+	slb_uint_t rows;
+
+	rows = ( plan->n - i0 < GEMM_ROWS ) ? plan->n - i0 : GEMM_ROWS;
+	if (plan->span == SLB_NULL) {
+		*lo = 0;
+		*hi = plan->m;
+		return rows;
+	}
+	*lo = plan->span[2U * i0];
+	*hi = plan->span[2U * i0 + 1U];
+	for (rows = 1U; (rows < GEMM_ROWS) && (i0 + rows < plan->n); ++rows) {
+		if (plan->span[2U * (i0 + rows)] != *lo) {
+			break;
+		}
+	}
+	return rows;
+}
+
+/* Block kernel (no SIMD)
+	Except for the first k-block, the share value of the previous k-block is added to the accumulator.
+*/
+static void gemm_block(SSS_GEMM* gemm, slb_uint_t i0, slb_uint_t rows, slb_uint_t j0, slb_uint_t j1, slb_bool_t first,
+					   slb_int_t d0, slb_int_t width, slb_int_t nmb, slb_uint32_t** share)
+{
+	const slb_uint_t k = gemm->plan->m;
+	const slb_uint_t row = (slb_uint_t)nmb;
+	slb_uint_t i, j;
+	slb_int_t d;
+	slb_uint64_t acc;
+
+	for (i = i0; i < i0 + rows; ++i) {
+		const slb_uint32_t* v = &gemm->plan->mat[i * k];
+		for (d = d0; d < d0 + width; ++d) {
+			acc = first ? 0U : share[i][d];
+			for (j = j0; j < j1; ++j) {
+				acc += (slb_uint64_t)v[j] * gemm->coef[j * row + (slb_uint_t)d];
+			}
+			share[i][d] = sss_gfp_reduce(acc);
+		}
+	}
+}
+
+/* Block kernel (AVX2, 4 shares x 8 data in registers)
+	Returns the number of data processed. With stream, the shares are written by
+	non-temporal stores (the share rows are aligned).
+*/
+SIMD_TARGET("avx2")
+static slb_int_t gemm_block_avx2(SSS_GEMM* gemm, slb_uint_t i0, slb_uint_t j0, slb_uint_t j1, slb_bool_t first,
+					   slb_int_t d0, slb_int_t width, slb_int_t nmb, slb_uint32_t** share, slb_bool_t stream)
+{
+	const slb_uint_t k = gemm->plan->m;
+	const slb_uint_t row = (slb_uint_t)nmb;
+	const slb_uint32_t* v = &gemm->plan->mat[i0 * k];
+	__m256i acc[GEMM_ROWS][2];
+	__m256i c0, c1, vv;
+	slb_uint64_t out[8];
+	slb_uint32_t red[8];
+	slb_uint_t r, j, e;
+	slb_int_t d;
+
+	for (d = 0; d + 8 <= width; d += 8) {
+		const slb_uint_t dd = (slb_uint_t)( d0 + d );
+
+		for (r = 0; r < GEMM_ROWS; ++r) {
+			if (first) {
+				acc[r][0] = _mm256_setzero_si256();
+				acc[r][1] = _mm256_setzero_si256();
+			}
+			else {
+				acc[r][0] = _mm256_cvtepu32_epi64( _mm_loadu_si128( (const __m128i*)&share[i0 + r][dd] ) );
+				acc[r][1] = _mm256_cvtepu32_epi64( _mm_loadu_si128( (const __m128i*)&share[i0 + r][dd + 4U] ) );
+			}
+		}
+
+		for (j = j0; j < j1; ++j) {
+			c0 = _mm256_cvtepu32_epi64( _mm_loadu_si128( (const __m128i*)&gemm->coef[j * row + dd] ) );
+			c1 = _mm256_cvtepu32_epi64( _mm_loadu_si128( (const __m128i*)&gemm->coef[j * row + dd + 4U] ) );
+			for (r = 0; r < GEMM_ROWS; ++r) {
+				vv = _mm256_set1_epi64x( (long long)v[r * k + j] );
+				acc[r][0] = _mm256_add_epi64( acc[r][0], _mm256_mul_epu32(c0, vv) );
+				acc[r][1] = _mm256_add_epi64( acc[r][1], _mm256_mul_epu32(c1, vv) );
+			}
+		}
+
+		for (r = 0; r < GEMM_ROWS; ++r) {
+			_mm256_storeu_si256( (__m256i*)&out[0], acc[r][0] );
+			_mm256_storeu_si256( (__m256i*)&out[4], acc[r][1] );
+			if (stream) {
+				for (e = 0; e < 8U; ++e) {
+					red[e] = sss_gfp_reduce(out[e]);
+				}
+				_mm256_stream_si256( (__m256i*)&share[i0 + r][dd], _mm256_loadu_si256( (const __m256i*)red ) );
+			}
+			else {
+				for (e = 0; e < 8U; ++e) {
+					share[i0 + r][dd + e] = sss_gfp_reduce(out[e]);
+				}
+			}
+		}
+	}
+	return d;
+}
+
+/* Block kernel (AVX-512, 4 shares x 16 data in registers)
+	Returns the number of data processed. With stream, the shares are written by
+	non-temporal stores (the share rows are aligned).
+*/
+SIMD_TARGET("avx512f")
+static slb_int_t gemm_block_avx512(SSS_GEMM* gemm, slb_uint_t i0, slb_uint_t j0, slb_uint_t j1, slb_bool_t first,
+					   slb_int_t d0, slb_int_t width, slb_int_t nmb, slb_uint32_t** share, slb_bool_t stream)
+{
+	const slb_uint_t k = gemm->plan->m;
+	const slb_uint_t row = (slb_uint_t)nmb;
+	const slb_uint32_t* v = &gemm->plan->mat[i0 * k];
+	__m512i acc[GEMM_ROWS][2];
+	__m512i c0, c1, vv;
+	slb_uint64_t out[16];
+	slb_uint32_t red[16];
+	slb_uint_t r, j, e;
+	slb_int_t d;
+
+	for (d = 0; d + 16 <= width; d += 16) {
+		const slb_uint_t dd = (slb_uint_t)( d0 + d );
+
+		for (r = 0; r < GEMM_ROWS; ++r) {
+			if (first) {
+				acc[r][0] = _mm512_setzero_si512();
+				acc[r][1] = _mm512_setzero_si512();
+			}
+			else {
+				acc[r][0] = _mm512_cvtepu32_epi64( _mm256_loadu_si256( (const __m256i*)&share[i0 + r][dd] ) );
+				acc[r][1] = _mm512_cvtepu32_epi64( _mm256_loadu_si256( (const __m256i*)&share[i0 + r][dd + 8U] ) );
+			}
+		}
+
+		for (j = j0; j < j1; ++j) {
+			c0 = _mm512_cvtepu32_epi64( _mm256_loadu_si256( (const __m256i*)&gemm->coef[j * row + dd] ) );
+			c1 = _mm512_cvtepu32_epi64( _mm256_loadu_si256( (const __m256i*)&gemm->coef[j * row + dd + 8U] ) );
+			for (r = 0; r < GEMM_ROWS; ++r) {
+				vv = _mm512_set1_epi64( (long long)v[r * k + j] );
+				acc[r][0] = _mm512_add_epi64( acc[r][0], _mm512_mul_epu32(c0, vv) );
+				acc[r][1] = _mm512_add_epi64( acc[r][1], _mm512_mul_epu32(c1, vv) );
+			}
+		}
+
+		for (r = 0; r < GEMM_ROWS; ++r) {
+			_mm512_storeu_si512( (void*)&out[0], acc[r][0] );
+			_mm512_storeu_si512( (void*)&out[8], acc[r][1] );
+			if (stream) {
+				for (e = 0; e < 16U; ++e) {
+					red[e] = sss_gfp_reduce(out[e]);
+				}
+				_mm512_stream_si512( (void*)&share[i0 + r][dd], _mm512_loadu_si512( (const void*)red ) );
+			}
+			else {
+				for (e = 0; e < 16U; ++e) {
+					share[i0 + r][dd + e] = sss_gfp_reduce(out[e]);
+				}
+			}
+		}
+	}
+	return d;
+}
+
+/* Orders the non-temporal stores before the following stores */
+SIMD_TARGET("avx2")
+static void gemm_sfence_avx2(void)
+{
+	_mm_sfence();
+}
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ GEMM encoding
+ -------------------------------------------------------------------------------
+ Encodes a chunk as a matrix product over GF(65537),
+	share[n][nmb] = V[n][k] * C[k][nmb],
+ where V[i][j] = x[i]^j (Vandermonde matrix) and the rows of C are the plain
+ data and the random coefficients. The shares are compatible with slb_sss_decode.
+
+ The Horner method per share reads C once for each share. Here, C is divided
+ into panels of SSS_GEMM_PANEL data that stay in the L2 cache, and each panel is
+ multiplied by blocks of 4 shares in registers. The products are accumulated in
+ 64 bits, and reduced once for each k-block of SSS_GEMM_KBLOCK rows.
+
+ V is held by an encode plan (see sss_plan.h). sss_gemm_start builds a plan of
+ the handle, and sss_gemm_start_plan uses a plan shared with other handles.
+ With a packed plan, the first l rows of C are plain data and V is the matrix of
+ the packed plan.
+ With a multi-policy plan, the share buffer holds the shares of all policies in
+ order, C holds the polynomials of all policies (each starting with a copy of the
+ plain data), and each block of shares is multiplied only by the rows of C of its
+ policies, so that the plain data is read and the shares of all policies are written in one pass.
+
+ sss_gemm_encode_bytes loads plain bytes into C in the byte order of sss_bytes.h.
+
+ The shares are written once and usually not read again by the CPU (they go to
+ storage or network). When the output of a call exceeds the last level cache,
+ normal stores read the lines for ownership and evict C, so the SIMD kernels
+ write the shares by non-temporal stores (see sss_gemm_set_stream). The share
+ rows must be aligned to 64 bytes (e.g. SSS_MEM_ALIGN), or normal stores are used.
+ *******************************************************************************/
+#ifndef SSS_GEMM_H
+#define SSS_GEMM_H
+
+#include "slb_sss.h"
+#include "sss_plan.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_GEMM_PANEL		256		/* Number of data of a panel (k * 1 KB in the cache) */
+#define SSS_GEMM_KBLOCK		4096U	/* Number of rows accumulated before reduction */
+#define SSS_GEMM_LLC_DEFAULT	( 8U * 1024U * 1024U )	/* Last level cache size when it is unknown */
+
+/***** Share output *****/
+typedef enum {
+	SSS_GEMM_STREAM_AUTO = 0,		/* non-temporal stores when the output of a call is the LLC size or more */
+	SSS_GEMM_STREAM_OFF,			/* normal stores */
+	SSS_GEMM_STREAM_ON				/* non-temporal stores */
+} SSS_GEMM_STREAM;
+
+/***** GEMM encoding handle *****/
+typedef struct {
+	slb_uint_t		k_max;			/* maximum threshold (k + l - 1 of packed plans, the sum of k of multi-policy plans) */
+	slb_uint_t		n_max;			/* maximum number of shares */
+	slb_int_t		nmb_max;		/* maximum number of data */
+	void*			mem_param;		/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func;	/* random number callback */
+	void*			rand_param;		/* parameter for random number callback */
+
+	const SSS_ENCODE_PLAN*	plan;	/* encode plan in use (SLB_NULL: not started) */
+	SSS_ENCODE_PLAN	own;			/* encode plan built by sss_gemm_start */
+	slb_uint32_t*	coef;			/* coefficients (rows 0 to l - 1 are plain data) [k_max * nmb_max] */
+	slb_uint64_t*	rnd;			/* random numbers [nmb_max] */
+	SSS_GEMM_STREAM	stream;			/* share output */
+	slb_uint_t		llc;			/* last level cache size */
+} SSS_GEMM;
+
+/***** Function *****/
+void sss_gemm_set_simd(
+	slb_bool_t			avx2,		/* =SLB_TRUE: AVX2 is used */
+	slb_bool_t			avx512		/* =SLB_TRUE: AVX-512 is used */
+);
+
+SLB_RC sss_gemm_open(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	slb_uint_t			n_max,		/* maximum number of shares */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param,	/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func,	/* random number callback */
+	void*				rand_param	/* parameter for random number callback */
+);
+
+SLB_RC sss_gemm_start(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	const slb_uint16_t	x[]			/* x coordinates */
+);
+
+SLB_RC sss_gemm_start_plan(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	const SSS_ENCODE_PLAN*	plan	/* encode plan */
+);
+
+SLB_RC sss_gemm_encode(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	slb_int_t			nmb,		/* number of data of a share */
+	const slb_uint16_t*	plain,		/* plain data [l * nmb] */
+	slb_uint32_t**		share		/* [out] share buffer [n] */
+);
+
+SLB_RC sss_gemm_encode_bytes(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint8_t*	bytes,		/* plain bytes (see sss_bytes.h) */
+	slb_int_t*			nmb,		/* [out] number of data of a share */
+	slb_uint32_t**		share		/* [out] share buffer [n] */
+);
+
+void sss_gemm_set_stream(
+	SSS_GEMM*			gemm,		/* GEMM encoding handle */
+	SSS_GEMM_STREAM		stream		/* share output */
+);
+
+void sss_gemm_close(
+	SSS_GEMM*			gemm		/* GEMM encoding handle */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_GEMM_H */
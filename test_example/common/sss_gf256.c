@@ -0,0 +1,375 @@
+/*******************************************************************************
+ SSS over GF(2^8)
+ *******************************************************************************/
+#include "sss_gf256.h"
+#include "sss_gfp.h"
+#include "cpuinfo.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+#define GF256_POLY		0x11bU		/* x^8 + x^4 + x^3 + x + 1 */
+
+/* dst[j] = src[j] * c + add[j] (dst may be the same as src or add) */
+typedef void (*GF256_MUL_REGION)(slb_uint8_t* dst, const slb_uint8_t* src, slb_uint8_t c, const slb_uint8_t* add, slb_int_t nmb);
+
+static void gf256_mul_region(slb_uint8_t* dst, const slb_uint8_t* src, slb_uint8_t c, const slb_uint8_t* add, slb_int_t nmb);
+static void gf256_mul_region_ssse3(slb_uint8_t* dst, const slb_uint8_t* src, slb_uint8_t c, const slb_uint8_t* add, slb_int_t nmb);
+static void gf256_mul_region_gfni(slb_uint8_t* dst, const slb_uint8_t* src, slb_uint8_t c, const slb_uint8_t* add, slb_int_t nmb);
+static GF256_MUL_REGION gf256_select(void);
+
+static slb_bool_t s_ssse3 = SLB_FALSE;
+static slb_bool_t s_gfni = SLB_FALSE;
+
+/* Sets SIMD to be used */
+void sss_gf256_set_simd(
+	slb_bool_t			ssse3,		/* =SLB_TRUE: SSSE3 is used */
+	slb_bool_t			gfni		/* =SLB_TRUE: GFNI (with AVX-512) is used */
+)
+{
+	s_ssse3 = ssse3;
+	s_gfni = gfni;
+}
+
+/* Multiplies two values in constant time
+	The shift-and-add method uses masks instead of branches and table lookups,
+	so the processing time does not depend on the values.
+*/
+slb_uint8_t sss_gf256_mul(
+	slb_uint8_t			a,			/* multiplicand */
+	slb_uint8_t			b			/* multiplier */
+)
+{
+	slb_uint_t r = 0U;
+	slb_uint_t aa = a;
+	slb_uint_t bb = b;
+	slb_uint_t i;
+
+	for (i = 0; i < 8U; ++i) {
+		r ^= aa & ( 0U - ( bb & 1U ) );
+		aa = ( aa << 1 ) ^ ( GF256_POLY & ( 0U - ( aa >> 7 ) ) );
+		bb >>= 1;
+	}
+	return (slb_uint8_t)r;
+}
+
+/* Calculates the multiplicative inverse (a^254) */
+slb_uint8_t sss_gf256_inv(
+	slb_uint8_t			a			/* nonzero value */
+)
+{
+	slb_uint8_t r = 1U;
+	slb_uint8_t p = a;
+	slb_uint_t e = 254U;
+
+	while (e != 0U) {
+		if ( (e & 1U) != 0U ) {
+			r = sss_gf256_mul(r, p);
+		}
+		p = sss_gf256_mul(p, p);
+		e >>= 1;
+	}
+	return r;
+}
+
+/* Multiplies a region by a constant and adds a region (by the kernel of sss_gf256_set_simd) */
+void sss_gf256_mul_region(
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint8_t*	src,		/* multiplicand */
+	slb_uint8_t			c,			/* multiplier */
+	const slb_uint8_t*	add,		/* data added to the products */
+	slb_uint8_t*		dst			/* [out] src * c + add */
+)
+{
+	gf256_select()( dst, src, c, add, nmb );
+}
+
+/* Opens GF(2^8) handle for encoding */
+SLB_RC sss_gf256_open_as_encode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param,	/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func,	/* random number callback */
+	void*				rand_param	/* parameter for random number callback */
+)
+{
+	memset(gf, 0, sizeof(*gf));
+
+	if ( (k_max < SLB_SSS_MIN_PLAYERS) || (SSS_GF256_MAX_PLAYERS < k_max) || (nmb_max <= 0) || (rand_func == SLB_NULL) ) {
+		return R_INVALID_PARAM;
+	}
+
+	gf->coef = slb_alloc( mem_param, (slb_uint_t)( (k_max - 1U) * (slb_uint_t)nmb_max ) );
+	if (gf->coef == SLB_NULL) {
+		return R_LOW_MEMORY;
+	}
+
+	gf->state = HS_SSS_ENCODE;
+	gf->k_max = k_max;
+	gf->nmb_max = nmb_max;
+	gf->mem_param = mem_param;
+	gf->rand_func = rand_func;
+	gf->rand_param = rand_param;
+
+	return R_SUCCESS;
+}
+
+/* Starts encoding */
+SLB_RC sss_gf256_start_encode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	const slb_uint8_t	x[]			/* x coordinates */
+)
+{
+	SLB_RC rc;
+	slb_uint16_t wide[SSS_GF256_MAX_PLAYERS];
+	slb_uint_t i;
+
+	if ( (gf->state != HS_SSS_ENCODE) && (gf->state != HS_SSS_ENCODE_STARTED) ) {
+		return R_INVALID_HANDLE;
+	}
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (gf->k_max < k) || (n < k) || (SSS_GF256_MAX_PLAYERS < n) ) {
+		return R_INVALID_PARAM;
+	}
+	for (i = 0; i < n; ++i) {
+		wide[i] = x[i];
+	}
+	rc = sss_gfp_check_x(n, wide, SLB_MASK_OF_UINT8);
+	if (rc != R_SUCCESS) {
+		return rc;
+	}
+
+	gf->k = k;
+	gf->n = n;
+	memcpy(gf->x, x, n);
+	gf->state = HS_SSS_ENCODE_STARTED;
+
+	return R_SUCCESS;
+}
+
+/* Encodes plain data
+	The share of x is calculated by the Horner method,
+	(((c[k-1] * x + c[k-2]) * x + ... + c[1]) * x + plain,
+	applying the region kernel to the whole chunk at each step.
+*/
+SLB_RC sss_gf256_encode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_int_t			nmb,		/* number of data (bytes) */
+	const slb_uint8_t*	plain,		/* plain data */
+	slb_uint8_t**		share		/* [out] share buffer [n] */
+)
+{
+	GF256_MUL_REGION mul_region;
+	slb_uint_t i, d;
+	const slb_uint8_t* src;
+	const slb_uint8_t* add;
+
+	if (gf->state == HS_SSS_ENCODE) {
+		return R_SSS_NOT_STARTED;
+	}
+	if (gf->state != HS_SSS_ENCODE_STARTED) {
+		return R_INVALID_HANDLE;
+	}
+	if ( (nmb <= 0) || (gf->nmb_max < nmb) ) {
+		return R_INVALID_PARAM;
+	}
+
+	/* Coefficients c[1] to c[k-1] are stored in rows 0 to k-2 */
+	if ( !gf->rand_func( gf->rand_param, (slb_uint_t)( (gf->k - 1U) * (slb_uint_t)nmb ), gf->coef ) ) {
+		return R_RAND_FAIL;
+	}
+
+	mul_region = gf256_select();
+	for (i = 0; i < gf->n; ++i) {
+		src = &gf->coef[ (gf->k - 2U) * (slb_uint_t)nmb ];
+		for (d = gf->k - 1U; 0U < d; --d) {
+			add = (d == 1U) ? plain : &gf->coef[ (d - 2U) * (slb_uint_t)nmb ];
+			mul_region( share[i], src, gf->x[i], add, nmb );
+			src = share[i];
+		}
+	}
+
+	memset( gf->coef, 0, (size_t)( (gf->k - 1U) * (slb_uint_t)nmb ) );
+
+	return R_SUCCESS;
+}
+
+/* Opens GF(2^8) handle for decoding */
+SLB_RC sss_gf256_open_as_decode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	memset(gf, 0, sizeof(*gf));
+
+	if ( (k_max < SLB_SSS_MIN_PLAYERS) || (SSS_GF256_MAX_PLAYERS < k_max) ) {
+		return R_INVALID_PARAM;
+	}
+
+	gf->state = HS_SSS_DECODE;
+	gf->k_max = k_max;
+	gf->mem_param = mem_param;
+
+	return R_SUCCESS;
+}
+
+/* Starts decoding
+	The Lagrange coefficient of x[i] at 0 is the product of x[j] / (x[j] + x[i]) for j != i.
+*/
+SLB_RC sss_gf256_start_decode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_uint_t			k,			/* threshold */
+	const slb_uint8_t	x[]			/* x coordinates */
+)
+{
+	SLB_RC rc;
+	slb_uint16_t wide[SSS_GF256_MAX_PLAYERS];
+	slb_uint_t i, j;
+	slb_uint8_t num, den;
+
+	if ( (gf->state != HS_SSS_DECODE) && (gf->state != HS_SSS_DECODE_STARTED) ) {
+		return R_INVALID_HANDLE;
+	}
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (gf->k_max < k) ) {
+		return R_INVALID_PARAM;
+	}
+	for (i = 0; i < k; ++i) {
+		wide[i] = x[i];
+	}
+	rc = sss_gfp_check_x(k, wide, SLB_MASK_OF_UINT8);
+	if (rc != R_SUCCESS) {
+		return rc;
+	}
+
+	for (i = 0; i < k; ++i) {
+		num = 1U;
+		den = 1U;
+		for (j = 0; j < k; ++j) {
+			if (j != i) {
+				num = sss_gf256_mul( num, x[j] );
+				den = sss_gf256_mul( den, (slb_uint8_t)( x[j] ^ x[i] ) );
+			}
+		}
+		gf->lambda[i] = sss_gf256_mul( num, sss_gf256_inv(den) );
+	}
+
+	gf->k = k;
+	memcpy(gf->x, x, k);
+	gf->state = HS_SSS_DECODE_STARTED;
+
+	return R_SUCCESS;
+}
+
+/* Decodes plain data */
+SLB_RC sss_gf256_decode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_int_t			nmb,		/* number of data (bytes) */
+	const slb_uint8_t**	share,		/* share buffer [k] */
+	slb_uint8_t*		plain		/* [out] plain data */
+)
+{
+	GF256_MUL_REGION mul_region;
+	slb_uint_t i;
+
+	if (gf->state == HS_SSS_DECODE) {
+		return R_SSS_NOT_STARTED;
+	}
+	if (gf->state != HS_SSS_DECODE_STARTED) {
+		return R_INVALID_HANDLE;
+	}
+	if (nmb <= 0) {
+		return R_INVALID_PARAM;
+	}
+
+	mul_region = gf256_select();
+	memset( plain, 0, (size_t)nmb );
+	for (i = 0; i < gf->k; ++i) {
+		mul_region( plain, share[i], gf->lambda[i], plain, nmb );
+	}
+
+	return R_SUCCESS;
+}
+
+/* Closes GF(2^8) handle */
+void sss_gf256_close(
+	SSS_GF256*			gf			/* GF(2^8) handle */
+)
+{
+	if (gf->coef != SLB_NULL) {
+		slb_free( gf->mem_param, gf->coef, SLB_TRUE );
+	}
+	memset(gf, 0, sizeof(*gf));
+}
+
+/* Region kernel (no SIMD) */
+static void gf256_mul_region(slb_uint8_t* dst, const slb_uint8_t* src, slb_uint8_t c, const slb_uint8_t* add, slb_int_t nmb)
+{
+	slb_int_t j;
+
+	for (j = 0; j < nmb; ++j) {
+		dst[j] = (slb_uint8_t)( sss_gf256_mul( src[j], c ) ^ add[j] );
+	}
+}
+
+/* Region kernel (SSSE3)
+	The products of c and the lower and upper 4 bits are looked up by PSHUFB from 16-byte tables.
+	Since the tables are held in registers, the lookups do not depend on the cache.
+*/
+SIMD_TARGET("ssse3")
+static void gf256_mul_region_ssse3(slb_uint8_t* dst, const slb_uint8_t* src, slb_uint8_t c, const slb_uint8_t* add, slb_int_t nmb)
+{
+	slb_uint8_t tbl[2][16];
+	__m128i tlo, thi, mask, v, l, h;
+	slb_uint_t i;
+	slb_int_t j;
+
+	for (i = 0; i < 16U; ++i) {
+		tbl[0][i] = sss_gf256_mul( c, (slb_uint8_t)i );
+		tbl[1][i] = sss_gf256_mul( c, (slb_uint8_t)( i << 4 ) );
+	}
+	tlo = _mm_loadu_si128( (const __m128i*)tbl[0] );
+	thi = _mm_loadu_si128( (const __m128i*)tbl[1] );
+	mask = _mm_set1_epi8(0x0f);
+
+	for (j = 0; j + 16 <= nmb; j += 16) {
+		v = _mm_loadu_si128( (const __m128i*)&src[j] );
+		l = _mm_shuffle_epi8( tlo, _mm_and_si128(v, mask) );
+		h = _mm_shuffle_epi8( thi, _mm_and_si128(_mm_srli_epi64(v, 4), mask) );
+		v = _mm_xor_si128( _mm_xor_si128(l, h), _mm_loadu_si128( (const __m128i*)&add[j] ) );
+		_mm_storeu_si128( (__m128i*)&dst[j], v );
+	}
+	gf256_mul_region( &dst[j], &src[j], c, &add[j], nmb - j );
+}
+
+/* Region kernel (GFNI with AVX-512)
+	GF2P8MULB multiplies 64 bytes at once in the field of polynomial 0x11b.
+*/
+SIMD_TARGET("gfni,avx512f,avx512bw")
+static void gf256_mul_region_gfni(slb_uint8_t* dst, const slb_uint8_t* src, slb_uint8_t c, const slb_uint8_t* add, slb_int_t nmb)
+{
+	__m512i vc, v;
+	slb_int_t j;
+
+	vc = _mm512_set1_epi8( (char)c );
+	for (j = 0; j + 64 <= nmb; j += 64) {
+		v = _mm512_gf2p8mul_epi8( _mm512_loadu_si512( (const void*)&src[j] ), vc );
+		v = _mm512_xor_si512( v, _mm512_loadu_si512( (const void*)&add[j] ) );
+		_mm512_storeu_si512( (void*)&dst[j], v );
+	}
+	gf256_mul_region( &dst[j], &src[j], c, &add[j], nmb - j );
+}
+
+/* Selects the region kernel */
+static GF256_MUL_REGION gf256_select(void)
+{
+	if (s_gfni) {
+		return gf256_mul_region_gfni;
+	}
+	if (s_ssse3) {
+		return gf256_mul_region_ssse3;
+	}
+	return gf256_mul_region;
+}
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ SSS over GF(2^8)
+ -------------------------------------------------------------------------------
+ Secret sharing over GF(2^8) for byte-oriented secrets.
+ libslbsss shares 16-bit words over GF(65537), so each share value has 17 bits.
+ Over GF(2^8), the shares are exactly the size of the plain data,
+ and the plain data can be of any length in bytes.
+
+ The field polynomial is x^8 + x^4 + x^3 + x + 1 (0x11b),
+ the same as that of the GF2P8MULB instruction. Up to 255 players.
+ *******************************************************************************/
+#ifndef SSS_GF256_H
+#define SSS_GF256_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_GF256_MAX_PLAYERS	255U		/* Maximum players */
+
+/***** GF(2^8) handle *****/
+typedef struct {
+	SLB_SSS_HANDLE_STATE	state;		/* handle state */
+	slb_uint_t		k_max;				/* maximum threshold */
+	slb_int_t		nmb_max;			/* maximum number of data (encoding) */
+	void*			mem_param;			/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func;		/* random number callback (encoding) */
+	void*			rand_param;			/* parameter for random number callback */
+
+	slb_uint_t		k;					/* threshold */
+	slb_uint_t		n;					/* number of shares (encoding) */
+	slb_uint8_t		x[SSS_GF256_MAX_PLAYERS];		/* x coordinates */
+	slb_uint8_t		lambda[SSS_GF256_MAX_PLAYERS];	/* Lagrange coefficients at 0 (decoding) */
+	slb_uint8_t*	coef;				/* random coefficients [(k_max - 1) * nmb_max] */
+} SSS_GF256;
+
+/***** Function *****/
+void sss_gf256_set_simd(
+	slb_bool_t			ssse3,		/* =SLB_TRUE: SSSE3 is used */
+	slb_bool_t			gfni		/* =SLB_TRUE: GFNI (with AVX-512) is used */
+);
+
+slb_uint8_t sss_gf256_mul(
+	slb_uint8_t			a,			/* multiplicand */
+	slb_uint8_t			b			/* multiplier */
+);
+
+slb_uint8_t sss_gf256_inv(
+	slb_uint8_t			a			/* nonzero value */
+);
+
+void sss_gf256_mul_region(
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint8_t*	src,		/* multiplicand */
+	slb_uint8_t			c,			/* multiplier */
+	const slb_uint8_t*	add,		/* data added to the products */
+	slb_uint8_t*		dst			/* [out] src * c + add */
+);
+
+SLB_RC sss_gf256_open_as_encode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param,	/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func,	/* random number callback */
+	void*				rand_param	/* parameter for random number callback */
+);
+
+SLB_RC sss_gf256_start_encode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	const slb_uint8_t	x[]			/* x coordinates */
+);
+
+SLB_RC sss_gf256_encode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_int_t			nmb,		/* number of data (bytes) */
+	const slb_uint8_t*	plain,		/* plain data */
+	slb_uint8_t**		share		/* [out] share buffer [n] */
+);
+
+SLB_RC sss_gf256_open_as_decode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+SLB_RC sss_gf256_start_decode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_uint_t			k,			/* threshold */
+	const slb_uint8_t	x[]			/* x coordinates */
+);
+
+SLB_RC sss_gf256_decode(
+	SSS_GF256*			gf,			/* GF(2^8) handle */
+	slb_int_t			nmb,		/* number of data (bytes) */
+	const slb_uint8_t**	share,		/* share buffer [k] */
+	slb_uint8_t*		plain		/* [out] plain data */
+);
+
+void sss_gf256_close(
+	SSS_GF256*			gf			/* GF(2^8) handle */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_GF256_H */
@@ -0,0 +1,454 @@
+/*******************************************************************************
+ SSS over GF(2^16)
+ *******************************************************************************/
+#include "sss_gf65536.h"
+#include "sss_gfp.h"
+#include "cpuinfo.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+#define GF65536_POLY	0x1100bU	/* x^16 + x^12 + x^3 + x + 1 */
+
+/* dst[j] = src[j] * c + add[j] (dst may be the same as src or add) */
+typedef void (*GF65536_MUL_REGION)(slb_uint16_t* dst, const slb_uint16_t* src, slb_uint16_t c, const slb_uint16_t* add, slb_int_t nmb);
+
+static void gf65536_mul_region(slb_uint16_t* dst, const slb_uint16_t* src, slb_uint16_t c, const slb_uint16_t* add, slb_int_t nmb);
+static void gf65536_mul_region_ssse3(slb_uint16_t* dst, const slb_uint16_t* src, slb_uint16_t c, const slb_uint16_t* add, slb_int_t nmb);
+static void gf65536_mul_region_gfni(slb_uint16_t* dst, const slb_uint16_t* src, slb_uint16_t c, const slb_uint16_t* add, slb_int_t nmb);
+static GF65536_MUL_REGION gf65536_select(void);
+static void gf65536_free(void* mem_param, void* mem, slb_bool_t clear);
+
+static slb_bool_t s_ssse3 = SLB_FALSE;
+static slb_bool_t s_gfni = SLB_FALSE;
+
+/* Sets SIMD to be used */
+void sss_gf65536_set_simd(
+	slb_bool_t			ssse3,		/* =SLB_TRUE: SSSE3 is used */
+	slb_bool_t			gfni		/* =SLB_TRUE: GFNI (with AVX-512) is used */
+)
+{
+	s_ssse3 = ssse3;
+	s_gfni = gfni;
+}
+
+/* Multiplies two values in constant time */
+slb_uint16_t sss_gf65536_mul(
+	slb_uint16_t		a,			/* multiplicand */
+	slb_uint16_t		b			/* multiplier */
+)
+{
+	slb_uint32_t r = 0U;
+	slb_uint32_t aa = a;
+	slb_uint32_t bb = b;
+	slb_uint_t i;
+
+	for (i = 0; i < 16U; ++i) {
+		r ^= aa & ( 0U - ( bb & 1U ) );
+		aa = ( aa << 1 ) ^ ( GF65536_POLY & ( 0U - ( aa >> 15 ) ) );
+		bb >>= 1;
+	}
+	return (slb_uint16_t)r;
+}
+
+/* Calculates the multiplicative inverse (a^65534) */
+slb_uint16_t sss_gf65536_inv(
+	slb_uint16_t		a			/* nonzero value */
+)
+{
+	slb_uint16_t r = 1U;
+	slb_uint16_t p = a;
+	slb_uint32_t e = 65534U;
+
+	while (e != 0U) {
+		if ( (e & 1U) != 0U ) {
+			r = sss_gf65536_mul(r, p);
+		}
+		p = sss_gf65536_mul(p, p);
+		e >>= 1;
+	}
+	return r;
+}
+
+/* Multiplies a region by a constant and adds a region (by the kernel of sss_gf65536_set_simd) */
+void sss_gf65536_mul_region(
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint16_t*	src,		/* multiplicand */
+	slb_uint16_t		c,			/* multiplier */
+	const slb_uint16_t*	add,		/* data added to the products */
+	slb_uint16_t*		dst			/* [out] src * c + add */
+)
+{
+	gf65536_select()( dst, src, c, add, nmb );
+}
+
+/* Opens GF(2^16) handle for encoding */
+SLB_RC sss_gf65536_open_as_encode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	slb_uint_t			n_max,		/* maximum number of shares */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param,	/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func,	/* random number callback */
+	void*				rand_param	/* parameter for random number callback */
+)
+{
+	memset(gf, 0, sizeof(*gf));
+
+	if ( (k_max < SLB_SSS_MIN_PLAYERS) || (n_max < k_max) || (SSS_GF65536_MAX_PLAYERS < n_max) ||
+		 (nmb_max <= 0) || (rand_func == SLB_NULL) ) {
+		return R_INVALID_PARAM;
+	}
+
+	gf->mem_param = mem_param;
+	gf->x = slb_alloc( mem_param, sizeof(slb_uint16_t) * n_max );
+	gf->coef = slb_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint16_t) * (k_max - 1U) * (slb_uint_t)nmb_max ) );
+	if ( (gf->x == SLB_NULL) || (gf->coef == SLB_NULL) ) {
+		sss_gf65536_close(gf);
+		return R_LOW_MEMORY;
+	}
+
+	gf->state = HS_SSS_ENCODE;
+	gf->k_max = k_max;
+	gf->n_max = n_max;
+	gf->nmb_max = nmb_max;
+	gf->rand_func = rand_func;
+	gf->rand_param = rand_param;
+
+	return R_SUCCESS;
+}
+
+/* Starts encoding */
+SLB_RC sss_gf65536_start_encode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	const slb_uint16_t	x[]			/* x coordinates */
+)
+{
+	SLB_RC rc;
+
+	if ( (gf->state != HS_SSS_ENCODE) && (gf->state != HS_SSS_ENCODE_STARTED) ) {
+		return R_INVALID_HANDLE;
+	}
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (gf->k_max < k) || (n < k) || (gf->n_max < n) ) {
+		return R_INVALID_PARAM;
+	}
+	rc = sss_gfp_check_x(n, x, SLB_MASK_OF_UINT16);
+	if (rc != R_SUCCESS) {
+		return rc;
+	}
+
+	gf->k = k;
+	gf->n = n;
+	memcpy(gf->x, x, sizeof(slb_uint16_t) * n);
+	gf->state = HS_SSS_ENCODE_STARTED;
+
+	return R_SUCCESS;
+}
+
+/* Encodes plain data by the Horner method (see sss_gf256_encode) */
+SLB_RC sss_gf65536_encode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint16_t*	plain,		/* plain data */
+	slb_uint16_t**		share		/* [out] share buffer [n] */
+)
+{
+	GF65536_MUL_REGION mul_region;
+	slb_uint_t i, d;
+	const slb_uint16_t* src;
+	const slb_uint16_t* add;
+
+	if (gf->state == HS_SSS_ENCODE) {
+		return R_SSS_NOT_STARTED;
+	}
+	if (gf->state != HS_SSS_ENCODE_STARTED) {
+		return R_INVALID_HANDLE;
+	}
+	if ( (nmb <= 0) || (gf->nmb_max < nmb) ) {
+		return R_INVALID_PARAM;
+	}
+
+	/* Coefficients c[1] to c[k-1] are stored in rows 0 to k-2 */
+	if ( !gf->rand_func( gf->rand_param, (slb_uint_t)( sizeof(slb_uint16_t) * (gf->k - 1U) * (slb_uint_t)nmb ), gf->coef ) ) {
+		return R_RAND_FAIL;
+	}
+
+	mul_region = gf65536_select();
+	for (i = 0; i < gf->n; ++i) {
+		src = &gf->coef[ (gf->k - 2U) * (slb_uint_t)nmb ];
+		for (d = gf->k - 1U; 0U < d; --d) {
+			add = (d == 1U) ? plain : &gf->coef[ (d - 2U) * (slb_uint_t)nmb ];
+			mul_region( share[i], src, gf->x[i], add, nmb );
+			src = share[i];
+		}
+	}
+
+	memset( gf->coef, 0, sizeof(slb_uint16_t) * (gf->k - 1U) * (slb_uint_t)nmb );
+
+	return R_SUCCESS;
+}
+
+/* Opens GF(2^16) handle for decoding */
+SLB_RC sss_gf65536_open_as_decode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	memset(gf, 0, sizeof(*gf));
+
+	if ( (k_max < SLB_SSS_MIN_PLAYERS) || (SSS_GF65536_MAX_PLAYERS < k_max) ) {
+		return R_INVALID_PARAM;
+	}
+
+	gf->mem_param = mem_param;
+	gf->x = slb_alloc( mem_param, sizeof(slb_uint16_t) * k_max );
+	gf->lambda = slb_alloc( mem_param, sizeof(slb_uint16_t) * k_max );
+	if ( (gf->x == SLB_NULL) || (gf->lambda == SLB_NULL) ) {
+		sss_gf65536_close(gf);
+		return R_LOW_MEMORY;
+	}
+
+	gf->state = HS_SSS_DECODE;
+	gf->k_max = k_max;
+	gf->n_max = k_max;
+
+	return R_SUCCESS;
+}
+
+/* Starts decoding
+	The Lagrange coefficient of x[i] at 0 is the product of x[j] / (x[j] + x[i]) for j != i.
+	The denominators are inverted at once, with one inversion and 3(k - 1) multiplications.
+*/
+SLB_RC sss_gf65536_start_decode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_uint_t			k,			/* threshold */
+	const slb_uint16_t	x[]			/* x coordinates */
+)
+{
+	SLB_RC rc;
+	slb_uint_t i, j;
+	slb_uint16_t num, den, inv;
+
+	if ( (gf->state != HS_SSS_DECODE) && (gf->state != HS_SSS_DECODE_STARTED) ) {
+		return R_INVALID_HANDLE;
+	}
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (gf->k_max < k) ) {
+		return R_INVALID_PARAM;
+	}
+	rc = sss_gfp_check_x(k, x, SLB_MASK_OF_UINT16);
+	if (rc != R_SUCCESS) {
+		return rc;
+	}
+
+	/* lambda[i] = denominator, x[i] = prefix product of the denominators */
+	den = 1U;
+	for (i = 0; i < k; ++i) {
+		slb_uint16_t d = 1U;
+		for (j = 0; j < k; ++j) {
+			if (j != i) {
+				d = sss_gf65536_mul( d, (slb_uint16_t)( x[j] ^ x[i] ) );
+			}
+		}
+		gf->lambda[i] = d;
+		gf->x[i] = den;
+		den = sss_gf65536_mul( den, d );
+	}
+
+	/* Batched inversion */
+	inv = sss_gf65536_inv(den);
+	for (i = k; 0U < i--; ) {
+		den = sss_gf65536_mul( inv, gf->x[i] );
+		inv = sss_gf65536_mul( inv, gf->lambda[i] );
+		gf->lambda[i] = den;
+	}
+
+	/* Multiply the numerators */
+	for (i = 0; i < k; ++i) {
+		num = 1U;
+		for (j = 0; j < k; ++j) {
+			if (j != i) {
+				num = sss_gf65536_mul( num, x[j] );
+			}
+		}
+		gf->lambda[i] = sss_gf65536_mul( num, gf->lambda[i] );
+	}
+
+	gf->k = k;
+	memcpy(gf->x, x, sizeof(slb_uint16_t) * k);
+	gf->state = HS_SSS_DECODE_STARTED;
+
+	return R_SUCCESS;
+}
+
+/* Decodes plain data */
+SLB_RC sss_gf65536_decode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint16_t**	share,	/* share buffer [k] */
+	slb_uint16_t*		plain		/* [out] plain data */
+)
+{
+	GF65536_MUL_REGION mul_region;
+	slb_uint_t i;
+
+	if (gf->state == HS_SSS_DECODE) {
+		return R_SSS_NOT_STARTED;
+	}
+	if (gf->state != HS_SSS_DECODE_STARTED) {
+		return R_INVALID_HANDLE;
+	}
+	if (nmb <= 0) {
+		return R_INVALID_PARAM;
+	}
+
+	mul_region = gf65536_select();
+	memset( plain, 0, sizeof(slb_uint16_t) * (slb_uint_t)nmb );
+	for (i = 0; i < gf->k; ++i) {
+		mul_region( plain, share[i], gf->lambda[i], plain, nmb );
+	}
+
+	return R_SUCCESS;
+}
+
+/* Closes GF(2^16) handle */
+void sss_gf65536_close(
+	SSS_GF65536*		gf			/* GF(2^16) handle */
+)
+{
+	gf65536_free( gf->mem_param, gf->x, SLB_FALSE );
+	gf65536_free( gf->mem_param, gf->lambda, SLB_FALSE );
+	gf65536_free( gf->mem_param, gf->coef, SLB_TRUE );
+	memset(gf, 0, sizeof(*gf));
+}
+
+/* Region kernel (no SIMD) */
+static void gf65536_mul_region(slb_uint16_t* dst, const slb_uint16_t* src, slb_uint16_t c, const slb_uint16_t* add, slb_int_t nmb)
+{
+	slb_int_t j;
+
+	for (j = 0; j < nmb; ++j) {
+		dst[j] = (slb_uint16_t)( sss_gf65536_mul( src[j], c ) ^ add[j] );
+	}
+}
+
+/* Region kernel (SSSE3)
+	16 values are split into the lower bytes and the upper bytes,
+	and the product of c and each 4 bits is looked up by PSHUFB from 8 tables in registers.
+*/
+SIMD_TARGET("ssse3")
+static void gf65536_mul_region_ssse3(slb_uint16_t* dst, const slb_uint16_t* src, slb_uint16_t c, const slb_uint16_t* add, slb_int_t nmb)
+{
+	slb_uint8_t tbl[4][2][16];
+	__m128i t[4][2];
+	__m128i mask, split, v0, v1, lo, hi, n, rlo, rhi;
+	slb_uint_t i, b;
+	slb_int_t j;
+
+	for (i = 0; i < 4U; ++i) {
+		for (b = 0; b < 16U; ++b) {
+			slb_uint16_t p = sss_gf65536_mul( c, (slb_uint16_t)( b << ( 4U * i ) ) );
+			tbl[i][0][b] = (slb_uint8_t)( p & SLB_MASK_OF_UINT8 );
+			tbl[i][1][b] = (slb_uint8_t)( p >> SLB_SHIFT_OF_1B );
+		}
+		t[i][0] = _mm_loadu_si128( (const __m128i*)tbl[i][0] );
+		t[i][1] = _mm_loadu_si128( (const __m128i*)tbl[i][1] );
+	}
+	mask = _mm_set1_epi8(0x0f);
+	split = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+
+	for (j = 0; j + 16 <= nmb; j += 16) {
+		v0 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*)&src[j] ), split );
+		v1 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*)&src[j + 8] ), split );
+		lo = _mm_unpacklo_epi64(v0, v1);
+		hi = _mm_unpackhi_epi64(v0, v1);
+
+		n = _mm_and_si128(lo, mask);
+		rlo = _mm_shuffle_epi8(t[0][0], n);
+		rhi = _mm_shuffle_epi8(t[0][1], n);
+		n = _mm_and_si128(_mm_srli_epi64(lo, 4), mask);
+		rlo = _mm_xor_si128( rlo, _mm_shuffle_epi8(t[1][0], n) );
+		rhi = _mm_xor_si128( rhi, _mm_shuffle_epi8(t[1][1], n) );
+		n = _mm_and_si128(hi, mask);
+		rlo = _mm_xor_si128( rlo, _mm_shuffle_epi8(t[2][0], n) );
+		rhi = _mm_xor_si128( rhi, _mm_shuffle_epi8(t[2][1], n) );
+		n = _mm_and_si128(_mm_srli_epi64(hi, 4), mask);
+		rlo = _mm_xor_si128( rlo, _mm_shuffle_epi8(t[3][0], n) );
+		rhi = _mm_xor_si128( rhi, _mm_shuffle_epi8(t[3][1], n) );
+
+		v0 = _mm_xor_si128( _mm_unpacklo_epi8(rlo, rhi), _mm_loadu_si128( (const __m128i*)&add[j] ) );
+		v1 = _mm_xor_si128( _mm_unpackhi_epi8(rlo, rhi), _mm_loadu_si128( (const __m128i*)&add[j + 8] ) );
+		_mm_storeu_si128( (__m128i*)&dst[j], v0 );
+		_mm_storeu_si128( (__m128i*)&dst[j + 8], v1 );
+	}
+	gf65536_mul_region( &dst[j], &src[j], c, &add[j], nmb - j );
+}
+
+/* Region kernel (GFNI with AVX-512)
+	Multiplication by c is a linear map over GF(2), which consists of four 8x8 bit matrices
+	between the lower and upper bytes. Each matrix is applied to 64 bytes at once by GF2P8AFFINEQB.
+	The values are split into bytes in each 128-bit lane, in the same way as the SSSE3 kernel.
+*/
+SIMD_TARGET("gfni,avx512f,avx512bw")
+static void gf65536_mul_region_gfni(slb_uint16_t* dst, const slb_uint16_t* src, slb_uint16_t c, const slb_uint16_t* add, slb_int_t nmb)
+{
+	slb_uint64_t mat[2][2];		/* [output byte][input byte] */
+	__m512i a[2][2];
+	__m512i split, v0, v1, lo, hi, rlo, rhi;
+	slb_uint_t ob, ib, i, jb;
+	slb_int_t j;
+
+	/* Row i of the matrix (byte 7 - i) is the input bits that affect output bit i */
+	for (ob = 0; ob < 2U; ++ob) {
+		for (ib = 0; ib < 2U; ++ib) {
+			mat[ob][ib] = 0U;
+			for (jb = 0; jb < 8U; ++jb) {
+				slb_uint16_t p = sss_gf65536_mul( c, (slb_uint16_t)( 1U << ( 8U * ib + jb ) ) );
+				for (i = 0; i < 8U; ++i) {
+					slb_uint64_t bit = (slb_uint64_t)( ( p >> ( 8U * ob + i ) ) & 1U );
+					mat[ob][ib] |= bit << ( 8U * ( 7U - i ) + jb );
+				}
+			}
+			a[ob][ib] = _mm512_set1_epi64( (long long)mat[ob][ib] );
+		}
+	}
+	split = _mm512_broadcast_i32x4( _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15) );
+
+	for (j = 0; j + 64 <= nmb; j += 64) {
+		v0 = _mm512_shuffle_epi8( _mm512_loadu_si512( (const void*)&src[j] ), split );
+		v1 = _mm512_shuffle_epi8( _mm512_loadu_si512( (const void*)&src[j + 32] ), split );
+		lo = _mm512_unpacklo_epi64(v0, v1);
+		hi = _mm512_unpackhi_epi64(v0, v1);
+
+		rlo = _mm512_xor_si512( _mm512_gf2p8affine_epi64_epi8(lo, a[0][0], 0), _mm512_gf2p8affine_epi64_epi8(hi, a[0][1], 0) );
+		rhi = _mm512_xor_si512( _mm512_gf2p8affine_epi64_epi8(lo, a[1][0], 0), _mm512_gf2p8affine_epi64_epi8(hi, a[1][1], 0) );
+
+		v0 = _mm512_xor_si512( _mm512_unpacklo_epi8(rlo, rhi), _mm512_loadu_si512( (const void*)&add[j] ) );
+		v1 = _mm512_xor_si512( _mm512_unpackhi_epi8(rlo, rhi), _mm512_loadu_si512( (const void*)&add[j + 32] ) );
+		_mm512_storeu_si512( (void*)&dst[j], v0 );
+		_mm512_storeu_si512( (void*)&dst[j + 32], v1 );
+	}
+	gf65536_mul_region( &dst[j], &src[j], c, &add[j], nmb - j );
+}
+
+/* Selects the region kernel */
+static GF65536_MUL_REGION gf65536_select(void)
+{
+	if (s_gfni) {
+		return gf65536_mul_region_gfni;
+	}
+	if (s_ssse3) {
+		return gf65536_mul_region_ssse3;
+	}
+	return gf65536_mul_region;
+}
+
+/* Frees memory if allocated */
+static void gf65536_free(void* mem_param, void* mem, slb_bool_t clear)
+{
+	if (mem != SLB_NULL) {
+		slb_free(mem_param, mem, clear);
+	}
+}
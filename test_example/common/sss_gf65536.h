@@ -0,0 +1,113 @@
+/*******************************************************************************
+ SSS over GF(2^16)
+ -------------------------------------------------------------------------------
+ Secret sharing over GF(2^16) with the 16-bit plain data of libslbsss.
+ Each share value is exactly 16 bits, unlike the 17-bit values of GF(65537),
+ so the shares can be written to the stream by memcpy.
+
+ The field polynomial is x^16 + x^12 + x^3 + x + 1 (0x1100b). Up to 65535 players.
+ The byte order of the shares is that of the processing system, as in libslbsss.
+ *******************************************************************************/
+#ifndef SSS_GF65536_H
+#define SSS_GF65536_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_GF65536_MAX_PLAYERS		65535U		/* Maximum players */
+
+/***** GF(2^16) handle *****/
+typedef struct {
+	SLB_SSS_HANDLE_STATE	state;		/* handle state */
+	slb_uint_t		k_max;				/* maximum threshold */
+	slb_uint_t		n_max;				/* maximum number of shares */
+	slb_int_t		nmb_max;			/* maximum number of data (encoding) */
+	void*			mem_param;			/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func;		/* random number callback (encoding) */
+	void*			rand_param;			/* parameter for random number callback */
+
+	slb_uint_t		k;					/* threshold */
+	slb_uint_t		n;					/* number of shares (encoding) */
+	slb_uint16_t*	x;					/* x coordinates [n_max] */
+	slb_uint16_t*	lambda;				/* Lagrange coefficients at 0 (decoding) [k_max] */
+	slb_uint16_t*	coef;				/* random coefficients [(k_max - 1) * nmb_max] */
+} SSS_GF65536;
+
+/***** Function *****/
+void sss_gf65536_set_simd(
+	slb_bool_t			ssse3,		/* =SLB_TRUE: SSSE3 is used */
+	slb_bool_t			gfni		/* =SLB_TRUE: GFNI (with AVX-512) is used */
+);
+
+slb_uint16_t sss_gf65536_mul(
+	slb_uint16_t		a,			/* multiplicand */
+	slb_uint16_t		b			/* multiplier */
+);
+
+slb_uint16_t sss_gf65536_inv(
+	slb_uint16_t		a			/* nonzero value */
+);
+
+void sss_gf65536_mul_region(
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint16_t*	src,		/* multiplicand */
+	slb_uint16_t		c,			/* multiplier */
+	const slb_uint16_t*	add,		/* data added to the products */
+	slb_uint16_t*		dst			/* [out] src * c + add */
+);
+
+SLB_RC sss_gf65536_open_as_encode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	slb_uint_t			n_max,		/* maximum number of shares */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param,	/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func,	/* random number callback */
+	void*				rand_param	/* parameter for random number callback */
+);
+
+SLB_RC sss_gf65536_start_encode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	const slb_uint16_t	x[]			/* x coordinates */
+);
+
+SLB_RC sss_gf65536_encode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint16_t*	plain,		/* plain data */
+	slb_uint16_t**		share		/* [out] share buffer [n] */
+);
+
+SLB_RC sss_gf65536_open_as_decode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+SLB_RC sss_gf65536_start_decode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_uint_t			k,			/* threshold */
+	const slb_uint16_t	x[]			/* x coordinates */
+);
+
+SLB_RC sss_gf65536_decode(
+	SSS_GF65536*		gf,			/* GF(2^16) handle */
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint16_t**	share,	/* share buffer [k] */
+	slb_uint16_t*		plain		/* [out] plain data */
+);
+
+void sss_gf65536_close(
+	SSS_GF65536*		gf			/* GF(2^16) handle */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_GF65536_H */
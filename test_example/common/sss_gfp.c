@@ -0,0 +1,168 @@
+/*******************************************************************************
+ GF(65537) arithmetic
+ *******************************************************************************/
+#include "sss_gfp.h"
+#include "slb_sss.h"
+
+#include <string.h>
+
+#define GFP_X_WORDS		( 65536U / 32U )	/* Words of the bitmap of x coordinates */
+
+static const slb_uint32_t* s_inv_table = SLB_NULL;
+
+/* Sets the table of inverses (see sss_res.h) */
+void sss_gfp_set_inv_table(
+	const slb_uint32_t*	table		/* table of inverses [SSS_GFP_PRIME] (SLB_NULL: not used) */
+)
+{
+	s_inv_table = table;
+}
+
+/* Raises to the power */
+slb_uint32_t sss_gfp_pow(
+	slb_uint32_t		a,			/* base */
+	slb_uint32_t		e			/* exponent */
+)
+{
+	slb_uint32_t result = 1U;
+	a %= SSS_GFP_PRIME;
+
+	while (e != 0U) {
+		if ( (e & 1U) != 0U ) {
+			result = SSS_GFP_MUL(result, a);
+		}
+		a = SSS_GFP_MUL(a, a);
+		e >>= 1;
+	}
+
+	return result;
+}
+
+/* Returns the multiplicative inverse
+	The table of the decode resource is used if prepared, otherwise Fermat's little theorem.
+	The table lookup is not constant-time. The values inverted here are the x coordinates
+	or in robust decoding, which is not constant-time either.
+*/
+slb_uint32_t sss_gfp_inv(
+	slb_uint32_t		a			/* nonzero value */
+)
+{
+	if (s_inv_table != SLB_NULL) {
+		return s_inv_table[a % SSS_GFP_PRIME];
+	}
+	return sss_gfp_pow(a, SSS_GFP_PRIME - 2U);
+}
+
+/* Gets Lagrange coefficients
+	The value at t of the polynomial passing through the points (xs[i], y[i]) is
+	the sum of coef[i] * y[i]. The x coordinates must be distinct.
+*/
+void sss_gfp_lagrange(
+	slb_uint_t			k,			/* number of points */
+	const slb_uint32_t	xs[],		/* x coordinates of points */
+	slb_uint32_t		t,			/* x coordinate to evaluate */
+	slb_uint32_t		coef[]		/* [out] Lagrange coefficients */
+)
+{
+	slb_uint_t i, j;
+
+	for (i = 0; i < k; ++i) {
+		slb_uint32_t num = 1U;
+		slb_uint32_t den = 1U;
+
+		for (j = 0; j < k; ++j) {
+			if (j != i) {
+				num = SSS_GFP_MUL( num, SSS_GFP_SUB(t, xs[j]) );
+				den = SSS_GFP_MUL( den, SSS_GFP_SUB(xs[i], xs[j]) );
+			}
+		}
+
+		coef[i] = SSS_GFP_MUL( num, sss_gfp_inv(den) );
+	}
+}
+
+/* Gets Lagrange coefficients at several points
+	Row r of coef is the Lagrange coefficients at ts[r] (see sss_gfp_lagrange).
+	By the barycentric form, coef[r][i] = L(ts[r]) * w[i] / (ts[r] - xs[i]),
+	where L(X) = (X - xs[0]) * ... * (X - xs[k-1]) and w[i] = 1 / L'(xs[i]).
+	This needs O(k^2 + nt * k) multiplications and nt + 1 inversions.
+*/
+void sss_gfp_lagrange_rows(
+	slb_uint_t			k,			/* number of points */
+	const slb_uint32_t	xs[],		/* x coordinates of points */
+	slb_uint_t			nt,			/* number of x coordinates to evaluate */
+	const slb_uint32_t	ts[],		/* x coordinates to evaluate (not in xs) */
+	slb_uint32_t		coef[],		/* [out] Lagrange coefficients [nt * k] */
+	slb_uint32_t		work[]		/* work area [2 * k] */
+)
+{
+	slb_uint32_t*const w = work;
+	slb_uint32_t*const prefix = &work[k];
+	slb_uint_t i, j, r;
+	slb_uint32_t acc, inv;
+
+	/* Barycentric weights (batched inversion) */
+	acc = 1U;
+	for (i = 0; i < k; ++i) {
+		slb_uint32_t den = 1U;
+		for (j = 0; j < k; ++j) {
+			if (j != i) {
+				den = SSS_GFP_MUL( den, SSS_GFP_SUB(xs[i], xs[j]) );
+			}
+		}
+		w[i] = den;
+		prefix[i] = acc;
+		acc = SSS_GFP_MUL(acc, den);
+	}
+	inv = sss_gfp_inv(acc);
+	for (i = k; 0U < i--; ) {
+		const slb_uint32_t den = w[i];
+		w[i] = SSS_GFP_MUL(inv, prefix[i]);
+		inv = SSS_GFP_MUL(inv, den);
+	}
+
+	/* Rows (batched inversion of ts[r] - xs[i]) */
+	for (r = 0; r < nt; ++r) {
+		slb_uint32_t*const row = &coef[r * k];
+		slb_uint32_t l;
+
+		acc = 1U;
+		for (i = 0; i < k; ++i) {
+			row[i] = SSS_GFP_SUB(ts[r], xs[i]);
+			prefix[i] = acc;
+			acc = SSS_GFP_MUL(acc, row[i]);
+		}
+		l = acc;
+		inv = sss_gfp_inv(acc);
+		for (i = k; 0U < i--; ) {
+			const slb_uint32_t d = row[i];
+			row[i] = SSS_GFP_MUL( SSS_GFP_MUL(inv, prefix[i]), SSS_GFP_MUL(l, w[i]) );
+			inv = SSS_GFP_MUL(inv, d);
+		}
+	}
+}
+
+/* Checks x coordinates
+	Each x coordinate must be 1 to x_max, and distinct. It is O(n) by the bitmap.
+*/
+SLB_RC sss_gfp_check_x(
+	slb_uint_t			n,			/* number of x coordinates */
+	const slb_uint16_t	x[],		/* x coordinates */
+	slb_uint_t			x_max		/* maximum x coordinate */
+)
+{
+	slb_uint32_t seen[GFP_X_WORDS];
+	slb_uint_t i;
+
+	memset(seen, 0, sizeof(seen));
+	for (i = 0; i < n; ++i) {
+		if ( (x[i] == 0U) || (x_max < x[i]) ) {
+			return R_SSS_INVALID_X;
+		}
+		if ( ( seen[x[i] >> 5] >> (x[i] & 31U) ) & 1U ) {
+			return R_SSS_IDENTIC_X;
+		}
+		seen[x[i] >> 5] |= 1U << (x[i] & 31U);
+	}
+	return R_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ GF(65537) arithmetic
+ -------------------------------------------------------------------------------
+ libslbsss encodes the 16-bit plain data into the values of the prime field
+ GF(65537). The share value is in the range 0 to 65536 (17 bits).
+ *******************************************************************************/
+#ifndef SSS_GFP_H
+#define SSS_GFP_H
+
+#include "slb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_GFP_PRIME		65537U		/* Prime of the field (2^16 + 1) */
+
+/* Inline function */
+#if defined(_MSC_VER)
+#	define SSS_INLINE	static __inline
+#else
+#	define SSS_INLINE	static inline
+#endif
+
+/* Reduces a 64-bit value in constant time
+	Since 2^16 = -1 (mod 65537), the value is folded into the alternating sum of its 16-bit parts,
+	and the last correction is done with a mask instead of a branch.
+	Unlike the % operator, this does not become a variable-time library call on 32-bit processing systems.
+*/
+SSS_INLINE slb_uint32_t sss_gfp_reduce(slb_uint64_t v)
+{
+	slb_uint32_t r, mask;
+
+	/* 4 <= r <= 262144 */
+	r = (slb_uint32_t)( v & SLB_MASK_OF_UINT16 ) + (slb_uint32_t)( ( v >> SLB_SHIFT_OF_4B ) & SLB_MASK_OF_UINT16 )
+		+ ( 2U * SSS_GFP_PRIME )
+		- (slb_uint32_t)( ( v >> SLB_SHIFT_OF_2B ) & SLB_MASK_OF_UINT16 ) - (slb_uint32_t)( v >> SLB_SHIFT_OF_6B );
+
+	/* 65533 <= r <= 131072 */
+	r = ( r & SLB_MASK_OF_UINT16 ) + SSS_GFP_PRIME - ( r >> SLB_SHIFT_OF_2B );
+
+	/* 0 <= r <= 65536 */
+	mask = 0U - ( ( SSS_GFP_PRIME - 1U - r ) >> ( SLB_BITS_OF_UINT32 - 1 ) );
+	r -= SSS_GFP_PRIME & mask;
+
+	return r;
+}
+
+/* Multiplies two values and reduces it (a * b must be less than 2^64) */
+#define SSS_GFP_MUL(a, b) \
+	sss_gfp_reduce( (slb_uint64_t)(a) * (slb_uint64_t)(b) )
+
+/* Adds two reduced values */
+#define SSS_GFP_ADD(a, b) \
+	(slb_uint32_t)( ( (slb_uint32_t)(a) + (slb_uint32_t)(b) ) % SSS_GFP_PRIME )
+
+/* Subtracts two reduced values */
+#define SSS_GFP_SUB(a, b) \
+	(slb_uint32_t)( ( (slb_uint32_t)(a) + SSS_GFP_PRIME - (slb_uint32_t)(b) ) % SSS_GFP_PRIME )
+
+/***** Function *****/
+void sss_gfp_set_inv_table(
+	const slb_uint32_t*	table		/* table of inverses [SSS_GFP_PRIME] (SLB_NULL: not used) */
+);
+
+slb_uint32_t sss_gfp_pow(
+	slb_uint32_t		a,			/* base */
+	slb_uint32_t		e			/* exponent */
+);
+
+slb_uint32_t sss_gfp_inv(
+	slb_uint32_t		a			/* nonzero value */
+);
+
+void sss_gfp_lagrange(
+	slb_uint_t			k,			/* number of points */
+	const slb_uint32_t	xs[],		/* x coordinates of points */
+	slb_uint32_t		t,			/* x coordinate to evaluate */
+	slb_uint32_t		coef[]		/* [out] Lagrange coefficients */
+);
+
+void sss_gfp_lagrange_rows(
+	slb_uint_t			k,			/* number of points */
+	const slb_uint32_t	xs[],		/* x coordinates of points */
+	slb_uint_t			nt,			/* number of x coordinates to evaluate */
+	const slb_uint32_t	ts[],		/* x coordinates to evaluate (not in xs) */
+	slb_uint32_t		coef[],		/* [out] Lagrange coefficients [nt * k] */
+	slb_uint32_t		work[]		/* work area [2 * k] */
+);
+
+SLB_RC sss_gfp_check_x(
+	slb_uint_t			n,			/* number of x coordinates */
+	const slb_uint16_t	x[],		/* x coordinates */
+	slb_uint_t			x_max		/* maximum x coordinate */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_GFP_H */
@@ -0,0 +1,696 @@
+/*******************************************************************************
+ Fast interpolation decoding
+ *******************************************************************************/
+#include "sss_interp.h"
+#include "sss_bytes.h"
+#include "sss_wipe.h"
+#include "sss_metrics.h"
+#include "sss_clock.h"
+#include "sss_mem.h"
+#include "sss_gfp.h"
+#include "cpuinfo.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+#define INTERP_PRIMITIVE_ROOT	3U		/* Primitive root of GF(65537) */
+#define INTERP_NTT_MIN_LEN		64U		/* Minimum length of polynomials to multiply or divide with NTT */
+
+static slb_bool_t interp_lambda_tree(void* mem_param, slb_uint_t k, const slb_uint32_t xs[], slb_uint32_t den[]);
+static void interp_lambda_direct(slb_uint_t k, const slb_uint32_t xs[], slb_uint32_t den[]);
+static slb_bool_t poly_mul(void* mem_param, const slb_uint32_t* a, slb_uint_t la, const slb_uint32_t* b, slb_uint_t lb, slb_uint32_t* c, slb_uint_t lc);
+static slb_bool_t poly_inv(void* mem_param, const slb_uint32_t* f, slb_uint_t lf, slb_uint_t t, slb_uint32_t* g);
+static slb_bool_t poly_mod(void* mem_param, const slb_uint32_t* a, slb_uint_t la, const slb_uint32_t* b, slb_uint_t lb, slb_uint32_t* r);
+static void interp_ntt(slb_uint32_t* a, slb_uint_t len, slb_bool_t inverse);
+static void interp_mac(slb_uint64_t* acc, const slb_uint32_t* y, slb_uint32_t c, slb_int_t nmb);
+static void interp_mac_avx2(slb_uint64_t* acc, const slb_uint32_t* y, slb_uint32_t c, slb_int_t nmb);
+static void interp_add(slb_uint64_t* acc, const slb_uint32_t* y, slb_int_t nmb);
+static void interp_add_avx2(slb_uint64_t* acc, const slb_uint32_t* y, slb_int_t nmb);
+static slb_uint_t interp_pow2(slb_uint_t v);
+
+static slb_bool_t s_avx2 = SLB_FALSE;
+
+/* Sets SIMD to be used */
+void sss_interp_set_simd(
+	slb_bool_t			avx2		/* =SLB_TRUE: AVX2 is used */
+)
+{
+	s_avx2 = avx2;
+}
+
+/* Opens interpolation decoding handle */
+SLB_RC sss_interp_open(
+	SSS_INTERP*			interp,		/* interpolation decoding handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	memset(interp, 0, sizeof(*interp));
+
+	if ( (k_max < SLB_SSS_MIN_PLAYERS) || (SSS_INTERP_MAX_PLAYERS < k_max) || (nmb_max <= 0) ) {
+		return R_INVALID_PARAM;
+	}
+
+	interp->k_max = k_max;
+	interp->nmb_max = nmb_max;
+	interp->mem_param = mem_param;
+
+	interp->lambda = sss_mem_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint32_t) * k_max ),
+									sizeof(slb_uint32_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	interp->acc = sss_mem_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint64_t) * (slb_uint_t)nmb_max ),
+								 SSS_MEM_ALIGN, SSS_MEM_PLAIN, SSS_MEM_HANDLE );
+	if ( (interp->lambda == SLB_NULL) || (interp->acc == SLB_NULL) ) {
+		sss_interp_close(interp);
+		return R_LOW_MEMORY;
+	}
+
+	return R_SUCCESS;
+}
+
+/* Starts decoding */
+SLB_RC sss_interp_start(
+	SSS_INTERP*			interp,		/* interpolation decoding handle */
+	slb_uint_t			k,			/* threshold */
+	const slb_uint16_t	x[],		/* x coordinates */
+	slb_uint_t			tree_min_k	/* minimum threshold to use the subproduct tree (0: SSS_INTERP_TREE_MIN_K) */
+)
+{
+	slb_uint32_t* xs;
+	slb_uint32_t* pre;
+	slb_uint32_t prod, inv, t, p0;
+	slb_uint_t i;
+	slb_bool_t ok = SLB_TRUE;
+	SLB_RC rc;
+
+	interp->k = 0;
+
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (interp->k_max < k) ) {
+		return R_INVALID_PARAM;
+	}
+	if (tree_min_k == 0U) {
+		tree_min_k = SSS_INTERP_TREE_MIN_K;
+	}
+
+	/* Check x coordinates */
+	rc = sss_gfp_check_x( k, x, SLB_MASK_OF_UINT16 );
+	if ( SLB_R_FAILED(rc) ) {
+		return rc;
+	}
+
+	xs = slb_alloc( interp->mem_param, sizeof(slb_uint32_t) * k );
+	pre = slb_alloc( interp->mem_param, sizeof(slb_uint32_t) * k );
+	if ( (xs == SLB_NULL) || (pre == SLB_NULL) ) {
+		if (xs != SLB_NULL) {
+			slb_free( interp->mem_param, xs, SLB_FALSE );
+		}
+		if (pre != SLB_NULL) {
+			slb_free( interp->mem_param, pre, SLB_FALSE );
+		}
+		return R_LOW_MEMORY;
+	}
+
+	for (i = 0; i < k; ++i) {
+		xs[i] = x[i];
+	}
+
+	/* Whole coset: x[i]^k are all the same */
+	interp->coset = (slb_bool_t)( interp_pow2(k) == k );
+	t = sss_gfp_pow( xs[0], k );
+	for (i = 1; (i < k) && interp->coset; ++i) {
+		if (sss_gfp_pow( xs[i], k ) != t) {
+			interp->coset = SLB_FALSE;
+		}
+	}
+	interp->tree = SLB_FALSE;
+
+	if (interp->coset) {
+		interp->inv_k = sss_gfp_inv(k);
+		for (i = 0; i < k; ++i) {
+			interp->lambda[i] = interp->inv_k;
+		}
+	}
+	else {
+		/* lambda[i] = -x[i] * P'(x[i]) */
+		if (tree_min_k <= k) {
+			ok = interp_lambda_tree( interp->mem_param, k, xs, interp->lambda );
+			interp->tree = SLB_TRUE;
+		}
+		else {
+			interp_lambda_direct( k, xs, interp->lambda );
+		}
+
+		if (ok) {
+			/* P(0) = (-x[0]) * ... * (-x[k-1]) */
+			p0 = 1U;
+			for (i = 0; i < k; ++i) {
+				p0 = SSS_GFP_MUL( p0, SSS_GFP_PRIME - xs[i] );
+			}
+
+			/* Batched inversion, lambda[i] = P(0) / lambda[i] */
+			prod = 1U;
+			for (i = 0; i < k; ++i) {
+				pre[i] = prod;
+				prod = SSS_GFP_MUL( prod, interp->lambda[i] );
+			}
+			inv = SSS_GFP_MUL( p0, sss_gfp_inv(prod) );
+			for (i = k; 0U < i--; ) {
+				t = SSS_GFP_MUL( inv, pre[i] );
+				inv = SSS_GFP_MUL( inv, interp->lambda[i] );
+				interp->lambda[i] = t;
+			}
+		}
+	}
+
+	slb_free( interp->mem_param, xs, SLB_FALSE );
+	slb_free( interp->mem_param, pre, SLB_FALSE );
+	if (ok == SLB_FALSE) {
+		return R_LOW_MEMORY;
+	}
+
+	interp->k = k;
+	return R_SUCCESS;
+}
+
+/* Decodes plain data
+	The products are accumulated in 64 bits, and reduced once for each data.
+*/
+SLB_RC sss_interp_decode(
+	SSS_INTERP*			interp,		/* interpolation decoding handle */
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint32_t**	share,	/* share buffer [k] */
+	slb_uint16_t*		plain		/* [out] plain data */
+)
+{
+	const slb_uint64_t start = sss_clock_ns();
+	slb_uint64_t* acc = interp->acc;
+	slb_uint_t i;
+	slb_int_t d;
+
+	if (interp->k == 0U) {
+		return R_SSS_NOT_STARTED;
+	}
+	if ( (nmb <= 0) || (interp->nmb_max < nmb) ) {
+		return R_INVALID_PARAM;
+	}
+
+	memset( acc, 0, sizeof(slb_uint64_t) * (slb_uint_t)nmb );
+
+	if (interp->coset) {
+		for (i = 0; i < interp->k; ++i) {
+			if (s_avx2) {
+				interp_add_avx2( acc, share[i], nmb );
+			}
+			else {
+				interp_add( acc, share[i], nmb );
+			}
+		}
+		for (d = 0; d < nmb; ++d) {
+			plain[d] = (slb_uint16_t)SSS_GFP_MUL( sss_gfp_reduce(acc[d]), interp->inv_k );
+		}
+	}
+	else {
+		for (i = 0; i < interp->k; ++i) {
+			if (s_avx2) {
+				interp_mac_avx2( acc, share[i], interp->lambda[i], nmb );
+			}
+			else {
+				interp_mac( acc, share[i], interp->lambda[i], nmb );
+			}
+		}
+		for (d = 0; d < nmb; ++d) {
+			plain[d] = (slb_uint16_t)sss_gfp_reduce(acc[d]);
+		}
+	}
+
+	sss_wipe_class( SSS_WIPE_PLAIN, acc, (slb_uint_t)( sizeof(slb_uint64_t) * (slb_uint_t)nmb ) );
+	sss_metrics_call( SSS_METRIC_OP_DECODE, sizeof(slb_uint16_t) * (slb_uint64_t)nmb,
+					  s_avx2 ? SSS_METRIC_SIMD_AVX2 : SSS_METRIC_SIMD_NONE, start );
+
+	return R_SUCCESS;
+}
+
+/* Decodes to bytes (see sss_bytes.h)
+	Each accumulator is reduced and stored to the bytes directly.
+*/
+SLB_RC sss_interp_decode_bytes(
+	SSS_INTERP*			interp,		/* interpolation decoding handle */
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint32_t**	share,	/* share buffer [k] */
+	slb_uint8_t*		bytes		/* [out] plain bytes [len] */
+)
+{
+	slb_uint64_t* acc = interp->acc;
+	slb_uint32_t v;
+	const slb_int_t nmb = SSS_BYTES_WORDS(len);
+	const slb_uint64_t start = sss_clock_ns();
+	slb_uint_t i;
+	slb_int_t d;
+
+	if (interp->k == 0U) {
+		return R_SSS_NOT_STARTED;
+	}
+	if ( (len <= 0) || (interp->nmb_max < nmb) || (bytes == SLB_NULL) ) {
+		return R_INVALID_PARAM;
+	}
+
+	memset( acc, 0, sizeof(slb_uint64_t) * (slb_uint_t)nmb );
+
+	for (i = 0; i < interp->k; ++i) {
+		if (interp->coset) {
+			if (s_avx2) {
+				interp_add_avx2( acc, share[i], nmb );
+			}
+			else {
+				interp_add( acc, share[i], nmb );
+			}
+		}
+		else {
+			if (s_avx2) {
+				interp_mac_avx2( acc, share[i], interp->lambda[i], nmb );
+			}
+			else {
+				interp_mac( acc, share[i], interp->lambda[i], nmb );
+			}
+		}
+	}
+	for (d = 0; d < nmb; ++d) {
+		v = interp->coset ? SSS_GFP_MUL( sss_gfp_reduce(acc[d]), interp->inv_k )
+						  : sss_gfp_reduce(acc[d]);
+		bytes[2 * d] = (slb_uint8_t)( v >> 8 );
+		if (2 * d + 1 < len) {
+			bytes[2 * d + 1] = (slb_uint8_t)v;
+		}
+	}
+
+	sss_wipe_class( SSS_WIPE_PLAIN, acc, (slb_uint_t)( sizeof(slb_uint64_t) * (slb_uint_t)nmb ) );
+	sss_metrics_call( SSS_METRIC_OP_DECODE, (slb_uint64_t)len,
+					  s_avx2 ? SSS_METRIC_SIMD_AVX2 : SSS_METRIC_SIMD_NONE, start );
+
+	return R_SUCCESS;
+}
+
+/* Closes interpolation decoding handle */
+void sss_interp_close(
+	SSS_INTERP*			interp		/* interpolation decoding handle */
+)
+{
+	sss_mem_free( interp->mem_param, interp->lambda, (slb_uint_t)( sizeof(slb_uint32_t) * interp->k_max ),
+				  SSS_MEM_TABLE, SLB_FALSE );
+	sss_mem_free( interp->mem_param, interp->acc, (slb_uint_t)( sizeof(slb_uint64_t) * (slb_uint_t)interp->nmb_max ),
+				  SSS_MEM_PLAIN, SLB_TRUE );		/* wiped after each decoding */
+	memset(interp, 0, sizeof(*interp));
+}
+
+/* Calculates -x[i] * P'(x[i]) with the subproduct tree
+	Level h of the tree has the products of 2^h leaves (X - x[i]), and its node j is stored
+	at offset j * (2^h + 1). The remainder of P' by each node is calculated from the top,
+	and the remainder by the leaf (X - x[i]) is P'(x[i]).
+*/
+static slb_bool_t interp_lambda_tree(void* mem_param, slb_uint_t k, const slb_uint32_t xs[], slb_uint32_t den[])
+{
+	slb_uint32_t* tree;
+	slb_uint32_t* rem[2];
+	slb_uint_t offset[SLB_BITS_OF_UINT32];
+	slb_uint_t levels, h, j, size, w, nodes, deg, degl;
+	slb_bool_t ok = SLB_TRUE;
+
+	/* Offsets of levels */
+	size = 0;
+	for (levels = 0; ; ++levels) {
+		w = 1U << levels;
+		offset[levels] = size;
+		size += ( ( k + w - 1U ) / w ) * ( w + 1U );
+		if (k <= w) {
+			break;
+		}
+	}
+
+	tree = slb_alloc( mem_param, sizeof(slb_uint32_t) * size );
+	rem[0] = slb_alloc( mem_param, sizeof(slb_uint32_t) * 2U * k );
+	rem[1] = slb_alloc( mem_param, sizeof(slb_uint32_t) * 2U * k );
+	if ( (tree == SLB_NULL) || (rem[0] == SLB_NULL) || (rem[1] == SLB_NULL) ) {
+		ok = SLB_FALSE;
+	}
+
+	/* Leaves */
+	for (j = 0; ok && (j < k); ++j) {
+		tree[2U * j] = ( SSS_GFP_PRIME - xs[j] ) % SSS_GFP_PRIME;
+		tree[2U * j + 1U] = 1U;
+	}
+
+	/* Products going up */
+	for (h = 1; ok && (h <= levels); ++h) {
+		w = 1U << h;
+		nodes = ( k + w - 1U ) / w;
+		for (j = 0; ok && (j < nodes); ++j) {
+			const slb_uint32_t* left = &tree[ offset[h - 1U] + ( 2U * j ) * ( w / 2U + 1U ) ];
+			const slb_uint32_t* right = &tree[ offset[h - 1U] + ( 2U * j + 1U ) * ( w / 2U + 1U ) ];
+			slb_uint32_t* node = &tree[ offset[h] + j * ( w + 1U ) ];
+			degl = w / 2U;
+			deg = ( k - j * w < w ) ? k - j * w : w;
+			if (deg <= degl) {
+				memcpy( node, left, sizeof(slb_uint32_t) * ( deg + 1U ) );
+			}
+			else {
+				ok = poly_mul( mem_param, left, degl + 1U, right, deg - degl + 1U, node, deg + 1U );
+			}
+		}
+	}
+
+	/* P' */
+	if (ok) {
+		const slb_uint32_t* root = &tree[ offset[levels] ];
+		for (j = 0; j < k; ++j) {
+			rem[levels % 2U][j] = SSS_GFP_MUL( root[j + 1U], j + 1U );
+		}
+	}
+
+	/* Remainders going down */
+	for (h = levels; ok && (0U < h--); ) {
+		w = 1U << h;
+		nodes = ( k + w - 1U ) / w;
+		for (j = 0; ok && (j < nodes); ++j) {
+			const slb_uint_t pw = 2U * w;
+			const slb_uint_t pdeg = ( k - ( j / 2U ) * pw < pw ) ? k - ( j / 2U ) * pw : pw;
+			deg = ( k - j * w < w ) ? k - j * w : w;
+			ok = poly_mod( mem_param, &rem[(h + 1U) % 2U][ ( j / 2U ) * pw ], pdeg,
+						   &tree[ offset[h] + j * ( w + 1U ) ], deg + 1U, &rem[h % 2U][ j * w ] );
+		}
+	}
+
+	/* -x[i] * P'(x[i]) */
+	for (j = 0; ok && (j < k); ++j) {
+		den[j] = SSS_GFP_MUL( SSS_GFP_PRIME - xs[j], rem[0][j] );
+	}
+
+	if (tree != SLB_NULL) {
+		slb_free( mem_param, tree, SLB_FALSE );
+	}
+	if (rem[0] != SLB_NULL) {
+		slb_free( mem_param, rem[0], SLB_FALSE );
+	}
+	if (rem[1] != SLB_NULL) {
+		slb_free( mem_param, rem[1], SLB_FALSE );
+	}
+	return ok;
+}
+
+/* Calculates -x[i] * P'(x[i]) directly, in O(k^2) */
+static void interp_lambda_direct(slb_uint_t k, const slb_uint32_t xs[], slb_uint32_t den[])
+{
+	slb_uint_t i, j;
+	slb_uint32_t d;
+
+	for (i = 0; i < k; ++i) {
+		d = SSS_GFP_PRIME - xs[i];
+		for (j = 0; j < k; ++j) {
+			if (j != i) {
+				d = SSS_GFP_MUL( d, SSS_GFP_SUB(xs[i], xs[j]) );
+			}
+		}
+		den[i] = d;
+	}
+}
+
+/* Multiplies polynomials (c = a * b mod X^lc, lc <= la + lb - 1) */
+static slb_bool_t poly_mul(void* mem_param, const slb_uint32_t* a, slb_uint_t la, const slb_uint32_t* b, slb_uint_t lb, slb_uint32_t* c, slb_uint_t lc)
+{
+	slb_uint32_t* fa;
+	slb_uint32_t* fb;
+	slb_uint_t i, j, len;
+
+	/* Schoolbook (at most min(la, lb) products of less than 2^33 are accumulated) */
+	if ( (la < INTERP_NTT_MIN_LEN) || (lb < INTERP_NTT_MIN_LEN) ) {
+		for (i = 0; i < lc; ++i) {
+			slb_uint64_t acc = 0U;
+			const slb_uint_t j_min = (lb <= i) ? i - lb + 1U : 0U;
+			for (j = j_min; (j < la) && (j <= i); ++j) {
+				acc += (slb_uint64_t)a[j] * b[i - j];
+			}
+			c[i] = sss_gfp_reduce(acc);
+		}
+		return SLB_TRUE;
+	}
+
+	/* NTT */
+	len = interp_pow2( la + lb - 1U );
+	fa = slb_alloc( mem_param, sizeof(slb_uint32_t) * len );
+	fb = slb_alloc( mem_param, sizeof(slb_uint32_t) * len );
+	if ( (fa == SLB_NULL) || (fb == SLB_NULL) ) {
+		if (fa != SLB_NULL) {
+			slb_free( mem_param, fa, SLB_FALSE );
+		}
+		if (fb != SLB_NULL) {
+			slb_free( mem_param, fb, SLB_FALSE );
+		}
+		return SLB_FALSE;
+	}
+
+	memcpy( fa, a, sizeof(slb_uint32_t) * la );
+	memset( &fa[la], 0, sizeof(slb_uint32_t) * ( len - la ) );
+	memcpy( fb, b, sizeof(slb_uint32_t) * lb );
+	memset( &fb[lb], 0, sizeof(slb_uint32_t) * ( len - lb ) );
+
+	interp_ntt(fa, len, SLB_FALSE);
+	interp_ntt(fb, len, SLB_FALSE);
+	for (i = 0; i < len; ++i) {
+		fa[i] = SSS_GFP_MUL( fa[i], fb[i] );
+	}
+	interp_ntt(fa, len, SLB_TRUE);
+	memcpy( c, fa, sizeof(slb_uint32_t) * lc );
+
+	slb_free( mem_param, fa, SLB_FALSE );
+	slb_free( mem_param, fb, SLB_FALSE );
+	return SLB_TRUE;
+}
+
+/* Inverts a power series (g = 1 / f mod X^t, f[0] != 0) by the Newton method, g = g * (2 - f * g) */
+static slb_bool_t poly_inv(void* mem_param, const slb_uint32_t* f, slb_uint_t lf, slb_uint_t t, slb_uint32_t* g)
+{
+	slb_uint32_t* h;
+	slb_uint32_t* g2;
+	slb_uint_t cur, nc, lh, i;
+	slb_bool_t ok = SLB_TRUE;
+
+	h = slb_alloc( mem_param, sizeof(slb_uint32_t) * t );
+	g2 = slb_alloc( mem_param, sizeof(slb_uint32_t) * t );
+	if ( (h == SLB_NULL) || (g2 == SLB_NULL) ) {
+		ok = SLB_FALSE;
+	}
+
+	if (ok) {
+		g[0] = sss_gfp_inv(f[0]);
+	}
+	for (cur = 1; ok && (cur < t); cur = nc) {
+		nc = ( 2U * cur < t ) ? 2U * cur : t;
+		lh = ( ( lf < nc ) ? lf : nc ) + cur - 1U;
+		if (nc < lh) {
+			lh = nc;
+		}
+		ok = poly_mul( mem_param, f, ( lf < nc ) ? lf : nc, g, cur, h, lh );
+		for (i = lh; i < nc; ++i) {
+			h[i] = 0U;
+		}
+		for (i = 0; ok && (i < nc); ++i) {
+			h[i] = ( SSS_GFP_PRIME - h[i] ) % SSS_GFP_PRIME;
+		}
+		h[0] = SSS_GFP_ADD( h[0], 2U );
+		if (ok) {
+			ok = poly_mul( mem_param, g, cur, h, nc, g2, nc );
+			memcpy( g, g2, sizeof(slb_uint32_t) * nc );
+		}
+	}
+
+	if (h != SLB_NULL) {
+		slb_free( mem_param, h, SLB_FALSE );
+	}
+	if (g2 != SLB_NULL) {
+		slb_free( mem_param, g2, SLB_FALSE );
+	}
+	return ok;
+}
+
+/* Calculates the remainder (r = a mod b, b is monic of degree lb - 1, la <= 2 * (lb - 1))
+	The quotient is rev(rev(a) / rev(b)), where rev(b) is inverted as a power series.
+*/
+static slb_bool_t poly_mod(void* mem_param, const slb_uint32_t* a, slb_uint_t la, const slb_uint32_t* b, slb_uint_t lb, slb_uint32_t* r)
+{
+	const slb_uint_t m = lb - 1U;
+	slb_uint32_t* buf;
+	slb_uint32_t* ra;
+	slb_uint32_t* rb;
+	slb_uint32_t* ginv;
+	slb_uint32_t* q;
+	slb_uint32_t* qb;
+	slb_uint_t qlen, i, j;
+	slb_bool_t ok;
+
+	if (la <= m) {
+		memcpy( r, a, sizeof(slb_uint32_t) * la );
+		memset( &r[la], 0, sizeof(slb_uint32_t) * ( m - la ) );
+		return SLB_TRUE;
+	}
+	qlen = la - m;
+
+	/* Schoolbook */
+	if ( (qlen < INTERP_NTT_MIN_LEN) || (m < INTERP_NTT_MIN_LEN) ) {
+		buf = slb_alloc( mem_param, sizeof(slb_uint32_t) * la );
+		if (buf == SLB_NULL) {
+			return SLB_FALSE;
+		}
+		memcpy( buf, a, sizeof(slb_uint32_t) * la );
+		for (i = la; m < i--; ) {
+			const slb_uint32_t c = buf[i];
+			for (j = 0; j < m; ++j) {
+				buf[i - m + j] = SSS_GFP_SUB( buf[i - m + j], SSS_GFP_MUL(c, b[j]) );
+			}
+		}
+		memcpy( r, buf, sizeof(slb_uint32_t) * m );
+		slb_free( mem_param, buf, SLB_FALSE );
+		return SLB_TRUE;
+	}
+
+	/* Newton */
+	buf = slb_alloc( mem_param, sizeof(slb_uint32_t) * ( 4U * qlen + lb + la ) );
+	if (buf == SLB_NULL) {
+		return SLB_FALSE;
+	}
+	ra = buf;
+	ginv = &ra[qlen];
+	q = &ginv[qlen];
+	rb = &q[2U * qlen];
+	qb = &rb[lb];
+
+	for (i = 0; i < qlen; ++i) {
+		ra[i] = a[la - 1U - i];
+	}
+	for (i = 0; i < lb; ++i) {
+		rb[i] = b[m - i];
+	}
+
+	ok = poly_inv( mem_param, rb, lb, qlen, ginv );
+	if (ok) {
+		ok = poly_mul( mem_param, ra, qlen, ginv, qlen, q, qlen );
+	}
+	if (ok) {
+		for (i = 0; i < qlen / 2U; ++i) {
+			const slb_uint32_t tmp = q[i];
+			q[i] = q[qlen - 1U - i];
+			q[qlen - 1U - i] = tmp;
+		}
+		ok = poly_mul( mem_param, q, qlen, b, lb, qb, m );
+	}
+	for (i = 0; ok && (i < m); ++i) {
+		r[i] = SSS_GFP_SUB( a[i], qb[i] );
+	}
+
+	slb_free( mem_param, buf, SLB_FALSE );
+	return ok;
+}
+
+/* NTT of len points (len is a power of 2) */
+static void interp_ntt(slb_uint32_t* a, slb_uint_t len, slb_bool_t inverse)
+{
+	slb_uint_t i, j, bit, half, start;
+	slb_uint32_t w, wn, u, v, tmp;
+
+	/* Bit-reversal permutation */
+	for (i = 1, j = 0; i < len; ++i) {
+		for (bit = len >> 1; (j & bit) != 0U; bit >>= 1) {
+			j ^= bit;
+		}
+		j ^= bit;
+		if (i < j) {
+			tmp = a[i];
+			a[i] = a[j];
+			a[j] = tmp;
+		}
+	}
+
+	for (half = 1; half < len; half *= 2U) {
+		w = sss_gfp_pow( INTERP_PRIMITIVE_ROOT, ( SSS_GFP_PRIME - 1U ) / ( 2U * half ) );
+		if (inverse) {
+			w = sss_gfp_inv(w);
+		}
+		for (start = 0; start < len; start += 2U * half) {
+			wn = 1U;
+			for (j = 0; j < half; ++j) {
+				u = a[start + j];
+				v = SSS_GFP_MUL( a[start + j + half], wn );
+				a[start + j] = SSS_GFP_ADD(u, v);
+				a[start + j + half] = SSS_GFP_SUB(u, v);
+				wn = SSS_GFP_MUL(wn, w);
+			}
+		}
+	}
+
+	if (inverse) {
+		w = sss_gfp_inv(len);
+		for (i = 0; i < len; ++i) {
+			a[i] = SSS_GFP_MUL( a[i], w );
+		}
+	}
+}
+
+/* Multiply-accumulate (no SIMD) */
+static void interp_mac(slb_uint64_t* acc, const slb_uint32_t* y, slb_uint32_t c, slb_int_t nmb)
+{
+	slb_int_t d;
+
+	for (d = 0; d < nmb; ++d) {
+		acc[d] += (slb_uint64_t)y[d] * c;
+	}
+}
+
+/* Multiply-accumulate (AVX2) */
+SIMD_TARGET("avx2")
+static void interp_mac_avx2(slb_uint64_t* acc, const slb_uint32_t* y, slb_uint32_t c, slb_int_t nmb)
+{
+	const __m256i vc = _mm256_set1_epi64x( (long long)c );
+	__m256i v;
+	slb_int_t d;
+
+	for (d = 0; d + 4 <= nmb; d += 4) {
+		v = _mm256_cvtepu32_epi64( _mm_loadu_si128( (const __m128i*)&y[d] ) );
+		v = _mm256_add_epi64( _mm256_loadu_si256( (const __m256i*)&acc[d] ), _mm256_mul_epu32(v, vc) );
+		_mm256_storeu_si256( (__m256i*)&acc[d], v );
+	}
+	interp_mac( &acc[d], &y[d], c, nmb - d );
+}
+
+/* Accumulate (no SIMD) */
+static void interp_add(slb_uint64_t* acc, const slb_uint32_t* y, slb_int_t nmb)
+{
+	slb_int_t d;
+
+	for (d = 0; d < nmb; ++d) {
+		acc[d] += y[d];
+	}
+}
+
+/* Accumulate (AVX2) */
+SIMD_TARGET("avx2")
+static void interp_add_avx2(slb_uint64_t* acc, const slb_uint32_t* y, slb_int_t nmb)
+{
+	__m256i v;
+	slb_int_t d;
+
+	for (d = 0; d + 4 <= nmb; d += 4) {
+		v = _mm256_cvtepu32_epi64( _mm_loadu_si128( (const __m128i*)&y[d] ) );
+		v = _mm256_add_epi64( _mm256_loadu_si256( (const __m256i*)&acc[d] ), v );
+		_mm256_storeu_si256( (__m256i*)&acc[d], v );
+	}
+	interp_add( &acc[d], &y[d], nmb - d );
+}
+
+/* Returns the power of 2 not less than v */
+static slb_uint_t interp_pow2(slb_uint_t v)
+{
+	slb_uint_t p = 1U;
+
+	while (p < v) {
+		p *= 2U;
+	}
+	return p;
+}
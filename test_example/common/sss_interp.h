@@ -0,0 +1,85 @@
+/*******************************************************************************
+ Fast interpolation decoding
+ -------------------------------------------------------------------------------
+ Decodes the shares of GF(65537) with any x coordinates of 1 to 65535,
+ including those of NTT encoding (see sss_ntt.h).
+
+ The plain data is the sum of lambda[i] * share[i], where lambda[i] is the
+ Lagrange coefficient at 0. The coefficients are calculated as
+	lambda[i] = P(0) / ( -x[i] * P'(x[i]) ),	P(X) = (X - x[0]) * ... * (X - x[k-1]).
+ When k is SSS_INTERP_TREE_MIN_K or more, P is built by the subproduct tree
+ with NTT multiplication, and P' is evaluated at all x coordinates by the
+ remainder tree, in O(k * log(k)^2) instead of O(k^2).
+
+ When the x coordinates are a whole coset of the subgroup of order k (k is a power of 2),
+ the inverse NTT gives the plain data as (share[0] + ... + share[k-1]) / k,
+ and no multiplication is needed for each data.
+ *******************************************************************************/
+#ifndef SSS_INTERP_H
+#define SSS_INTERP_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_INTERP_MAX_PLAYERS	32768U		/* Maximum players */
+#define SSS_INTERP_TREE_MIN_K	1536U		/* Minimum threshold to use the subproduct tree (by benchmark) */
+
+/***** Interpolation decoding handle *****/
+typedef struct {
+	slb_uint_t		k_max;			/* maximum threshold */
+	slb_int_t		nmb_max;		/* maximum number of data */
+	void*			mem_param;		/* parameter for memory management callback */
+
+	slb_uint_t		k;				/* threshold */
+	slb_bool_t		coset;			/* =SLB_TRUE: x coordinates are a whole coset */
+	slb_bool_t		tree;			/* =SLB_TRUE: subproduct tree was used */
+	slb_uint32_t	inv_k;			/* inverse of k (coset) */
+	slb_uint32_t*	lambda;			/* Lagrange coefficients at 0 [k_max] */
+	slb_uint64_t*	acc;			/* accumulator [nmb_max] */
+} SSS_INTERP;
+
+/***** Function *****/
+void sss_interp_set_simd(
+	slb_bool_t			avx2		/* =SLB_TRUE: AVX2 is used */
+);
+
+SLB_RC sss_interp_open(
+	SSS_INTERP*			interp,		/* interpolation decoding handle */
+	slb_uint_t			k_max,		/* maximum threshold */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+SLB_RC sss_interp_start(
+	SSS_INTERP*			interp,		/* interpolation decoding handle */
+	slb_uint_t			k,			/* threshold */
+	const slb_uint16_t	x[],		/* x coordinates */
+	slb_uint_t			tree_min_k	/* minimum threshold to use the subproduct tree (0: SSS_INTERP_TREE_MIN_K) */
+);
+
+SLB_RC sss_interp_decode(
+	SSS_INTERP*			interp,		/* interpolation decoding handle */
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint32_t**	share,	/* share buffer [k] */
+	slb_uint16_t*		plain		/* [out] plain data */
+);
+
+SLB_RC sss_interp_decode_bytes(
+	SSS_INTERP*			interp,		/* interpolation decoding handle */
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint32_t**	share,	/* share buffer [k] */
+	slb_uint8_t*		bytes		/* [out] plain bytes [len] (see sss_bytes.h) */
+);
+
+void sss_interp_close(
+	SSS_INTERP*			interp		/* interpolation decoding handle */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_INTERP_H */
@@ -0,0 +1,364 @@
+/*******************************************************************************
+ Compression before splitting
+ *******************************************************************************/
+#include "sss_lz.h"
+
+#include <string.h>
+
+#define LZ_MAX_OFFSET		65535		/* Maximum offset of a match */
+#define LZ_SKIP_SHIFT		6			/* Misses before the step is increased */
+
+static slb_uint32_t lz_read32(const slb_uint8_t* p);
+static slb_uint32_t lz_read_be32(const slb_uint8_t* p);
+static void lz_write_be32(slb_uint8_t* p, slb_uint32_t v);
+static SLB_RC lz_sequence(const slb_uint8_t* lit, slb_int_t nlit, slb_int_t offset, slb_int_t mlen,
+						  slb_int_t size, slb_uint8_t* dst, slb_int_t* op);
+static slb_int_t lz_put_length(slb_int_t value, slb_uint8_t* dst);
+static slb_bool_t lz_get_length(slb_int_t len, const slb_uint8_t* src, slb_int_t* ip, slb_int_t* value);
+
+/* Hash of 4 bytes */
+#define LZ_HASH(v)			( (slb_uint_t)( ( (v) * 2654435761U ) >> ( 32U - SSS_LZ_HASH_BITS ) ) )
+
+/* Compresses bytes
+	R_INVALID_PARAM is returned when the compressed bytes exceed size
+	(size of SSS_LZ_BOUND(len) is always enough).
+*/
+SLB_RC sss_lz_compress(
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint8_t*	src,		/* bytes */
+	slb_int_t			size,		/* size of dst */
+	slb_uint8_t*		dst,		/* [out] compressed bytes */
+	slb_int_t*			out			/* [out] number of compressed bytes */
+)
+{
+	slb_uint32_t table[1U << SSS_LZ_HASH_BITS];
+	slb_int_t ip = 0, anchor = 0, op = 0, ref, mlen;
+	slb_uint_t h, miss = 0;
+	slb_uint32_t v;
+	SLB_RC rc;
+
+	if ( (len < 0) || (size < 0) ) {
+		return R_INVALID_PARAM;
+	}
+	memset( table, 0, sizeof(table) );
+
+	while (ip + SSS_LZ_MIN_MATCH <= len) {
+		v = lz_read32( &src[ip] );
+		h = LZ_HASH(v);
+		ref = (slb_int_t)table[h];
+		table[h] = (slb_uint32_t)ip;
+		if ( (ref < ip) && (ip - ref <= LZ_MAX_OFFSET) && (lz_read32( &src[ref] ) == v) ) {
+			/* Extend the match forward and backward */
+			mlen = SSS_LZ_MIN_MATCH;
+			while ( (ip + mlen < len) && (src[ref + mlen] == src[ip + mlen]) ) {
+				++mlen;
+			}
+			while ( (anchor < ip) && (0 < ref) && (src[ip - 1] == src[ref - 1]) ) {
+				--ip;
+				--ref;
+				++mlen;
+			}
+			rc = lz_sequence( &src[anchor], ip - anchor, ip - ref, mlen, size, dst, &op );
+			if ( SLB_R_FAILED(rc) ) {
+				return rc;
+			}
+			ip += mlen;
+			anchor = ip;
+			miss = 0;
+
+			/* Position in the match for the next search */
+			if (ip + SSS_LZ_MIN_MATCH <= len) {
+				table[ LZ_HASH( lz_read32( &src[ip - 2] ) ) ] = (slb_uint32_t)( ip - 2 );
+			}
+		}
+		else {
+			/* Skip faster in data of no match */
+			ip += 1 + (slb_int_t)( miss++ >> LZ_SKIP_SHIFT );
+		}
+	}
+
+	/* Last literals */
+	rc = lz_sequence( &src[anchor], len - anchor, 0, 0, size, dst, &op );
+	if ( SLB_R_FAILED(rc) ) {
+		return rc;
+	}
+	*out = op;
+	return R_SUCCESS;
+}
+
+/* Decompresses bytes
+	R_INVALID_PARAM is returned for the broken data and when the bytes exceed size.
+*/
+SLB_RC sss_lz_decompress(
+	slb_int_t			len,		/* number of compressed bytes */
+	const slb_uint8_t*	src,		/* compressed bytes */
+	slb_int_t			size,		/* size of dst */
+	slb_uint8_t*		dst,		/* [out] bytes */
+	slb_int_t*			out			/* [out] number of bytes */
+)
+{
+	slb_int_t ip = 0, op = 0, nlit, mlen, offset, i;
+	slb_uint_t token;
+
+	if ( (len <= 0) || (size < 0) ) {
+		return R_INVALID_PARAM;
+	}
+
+	for (;;) {
+		/* Literals */
+		token = src[ip++];
+		nlit = (slb_int_t)( token >> 4 );
+		if ( (nlit == 15) && !lz_get_length( len, src, &ip, &nlit ) ) {
+			return R_INVALID_PARAM;
+		}
+		if ( (len - ip < nlit) || (size - op < nlit) ) {
+			return R_INVALID_PARAM;
+		}
+		memcpy( &dst[op], &src[ip], (size_t)nlit );
+		ip += nlit;
+		op += nlit;
+		if (ip == len) {
+			break;
+		}
+
+		/* Match */
+		if (len - ip < 2) {
+			return R_INVALID_PARAM;
+		}
+		offset = (slb_int_t)src[ip] | ( (slb_int_t)src[ip + 1] << 8 );
+		ip += 2;
+		mlen = (slb_int_t)( token & 15U );
+		if ( (mlen == 15) && !lz_get_length( len, src, &ip, &mlen ) ) {
+			return R_INVALID_PARAM;
+		}
+		mlen += SSS_LZ_MIN_MATCH;
+		if ( (offset == 0) || (op < offset) || (size - op < mlen) ) {
+			return R_INVALID_PARAM;
+		}
+		if (mlen <= offset) {
+			memcpy( &dst[op], &dst[op - offset], (size_t)mlen );
+		}
+		else {
+			/* Overlapped copy (repeat of the last offset bytes) */
+			for (i = 0; i < mlen; ++i) {
+				dst[op + i] = dst[op - offset + i];
+			}
+		}
+		op += mlen;
+		if (ip == len) {
+			return R_INVALID_PARAM;
+		}
+	}
+
+	*out = op;
+	return R_SUCCESS;
+}
+
+/* Compresses bytes into frames aligned to unit bytes
+	A frame that is not smaller by the compression is stored.
+*/
+SLB_RC sss_lz_pack(
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint8_t*	src,		/* bytes */
+	slb_int_t			frame,		/* raw bytes of a frame (1 to SSS_LZ_FRAME_MAX) */
+	slb_int_t			unit,		/* alignment of the frames */
+	slb_int_t			size,		/* size of dst (SSS_LZ_PACK_BOUND) */
+	slb_uint8_t*		dst,		/* [out] frames */
+	slb_int_t*			out			/* [out] number of bytes of the frames */
+)
+{
+	slb_int_t pos, raw, op = 0, room, payload, padded;
+	slb_uint32_t stored;
+	SLB_RC rc;
+
+	if ( (len < 0) || (frame <= 0) || (SSS_LZ_FRAME_MAX < frame) || (unit <= 0) || (size < 0) ) {
+		return R_INVALID_PARAM;
+	}
+
+	for (pos = 0; pos < len; pos += raw) {
+		raw = ( len - pos < frame ) ? len - pos : frame;
+		if (size - op < SSS_LZ_HEADER) {
+			return R_INVALID_PARAM;
+		}
+		room = size - op - SSS_LZ_HEADER;
+
+		rc = sss_lz_compress( raw, &src[pos], ( room < raw - 1 ) ? room : raw - 1, &dst[op + SSS_LZ_HEADER], &payload );
+		if ( SLB_R_SUCCEEDED(rc) ) {
+			stored = (slb_uint32_t)payload;
+		}
+		else {
+			if (room < raw) {
+				return R_INVALID_PARAM;
+			}
+			memcpy( &dst[op + SSS_LZ_HEADER], &src[pos], (size_t)raw );
+			payload = raw;
+			stored = (slb_uint32_t)raw | SSS_LZ_STORED;
+		}
+		lz_write_be32( &dst[op], (slb_uint32_t)raw );
+		lz_write_be32( &dst[op + 4], stored );
+
+		/* Padding to the chunk boundary */
+		padded = ( SSS_LZ_HEADER + payload + unit - 1 ) / unit * unit;
+		if (size - op < padded) {
+			return R_INVALID_PARAM;
+		}
+		memset( &dst[op + SSS_LZ_HEADER + payload], 0, (size_t)( padded - SSS_LZ_HEADER - payload ) );
+		op += padded;
+	}
+
+	*out = op;
+	return R_SUCCESS;
+}
+
+/* Reads the header of a frame */
+SLB_RC sss_lz_frame(
+	slb_int_t			len,		/* number of bytes from the frame */
+	const slb_uint8_t*	src,		/* frame */
+	slb_int_t			unit,		/* alignment of the frames */
+	slb_int_t*			raw,		/* [out] raw bytes of the frame */
+	slb_int_t*			padded		/* [out] bytes of the frame with the padding */
+)
+{
+	slb_uint32_t r, stored, payload;
+
+	if ( (len < SSS_LZ_HEADER) || (unit <= 0) ) {
+		return R_INVALID_PARAM;
+	}
+	r = lz_read_be32( &src[0] );
+	stored = lz_read_be32( &src[4] );
+	payload = stored & ~SSS_LZ_STORED;
+	if ( ( (slb_uint32_t)SSS_LZ_FRAME_MAX < r ) ||
+		 ( ( (stored & SSS_LZ_STORED) != 0U ) && (payload != r) ) ||
+		 ( (slb_uint32_t)( len - SSS_LZ_HEADER ) < payload ) ) {
+		return R_INVALID_PARAM;
+	}
+
+	*raw = (slb_int_t)r;
+	*padded = ( SSS_LZ_HEADER + (slb_int_t)payload + unit - 1 ) / unit * unit;
+	if (len < *padded) {
+		return R_INVALID_PARAM;
+	}
+	return R_SUCCESS;
+}
+
+/* Decompresses frames */
+SLB_RC sss_lz_unpack(
+	slb_int_t			len,		/* number of bytes of the frames */
+	const slb_uint8_t*	src,		/* frames */
+	slb_int_t			unit,		/* alignment of the frames */
+	slb_int_t			size,		/* size of dst */
+	slb_uint8_t*		dst,		/* [out] bytes */
+	slb_int_t*			out			/* [out] number of bytes */
+)
+{
+	slb_int_t ip, op = 0, raw, padded, n;
+	SLB_RC rc;
+
+	if ( (len < 0) || (size < 0) ) {
+		return R_INVALID_PARAM;
+	}
+
+	for (ip = 0; ip < len; ip += padded) {
+		rc = sss_lz_frame( len - ip, &src[ip], unit, &raw, &padded );
+		if ( SLB_R_FAILED(rc) ) {
+			return rc;
+		}
+		if (size - op < raw) {
+			return R_INVALID_PARAM;
+		}
+		if ( ( lz_read_be32( &src[ip + 4] ) & SSS_LZ_STORED ) != 0U ) {
+			memcpy( &dst[op], &src[ip + SSS_LZ_HEADER], (size_t)raw );
+		}
+		else {
+			rc = sss_lz_decompress( (slb_int_t)lz_read_be32( &src[ip + 4] ), &src[ip + SSS_LZ_HEADER], raw, &dst[op], &n );
+			if ( SLB_R_FAILED(rc) || (n != raw) ) {
+				return R_INVALID_PARAM;
+			}
+		}
+		op += raw;
+	}
+
+	*out = op;
+	return R_SUCCESS;
+}
+
+/* Reads 4 bytes (in the byte order of the CPU) */
+static slb_uint32_t lz_read32(const slb_uint8_t* p)
+{
+	slb_uint32_t v;
+
+	memcpy( &v, p, sizeof(v) );
+	return v;
+}
+
+/* Reads 4 bytes of big endian */
+static slb_uint32_t lz_read_be32(const slb_uint8_t* p)
+{
+	return ( (slb_uint32_t)p[0] << 24 ) | ( (slb_uint32_t)p[1] << 16 ) | ( (slb_uint32_t)p[2] << 8 ) | p[3];
+}
+
+/* Writes 4 bytes of big endian */
+static void lz_write_be32(slb_uint8_t* p, slb_uint32_t v)
+{
+	p[0] = (slb_uint8_t)( v >> 24 );
+	p[1] = (slb_uint8_t)( v >> 16 );
+	p[2] = (slb_uint8_t)( v >> 8 );
+	p[3] = (slb_uint8_t)v;
+}
+
+/* Writes a sequence (mlen = 0: the last literals) */
+static SLB_RC lz_sequence(const slb_uint8_t* lit, slb_int_t nlit, slb_int_t offset, slb_int_t mlen,
+						  slb_int_t size, slb_uint8_t* dst, slb_int_t* op)
+{
+	slb_uint8_t* p = &dst[*op];
+	slb_int_t m = ( mlen == 0 ) ? 0 : mlen - SSS_LZ_MIN_MATCH;
+
+	/* Token, lengths and offset are at most 2 + 3 + (length / 255) * 2 bytes */
+	if ( size - *op < 5 + nlit + nlit / 255 + m / 255 ) {
+		return R_INVALID_PARAM;
+	}
+
+	*p++ = (slb_uint8_t)( ( ( ( nlit < 15 ) ? nlit : 15 ) << 4 ) | ( ( m < 15 ) ? m : 15 ) );
+	if (15 <= nlit) {
+		p += lz_put_length( nlit - 15, p );
+	}
+	memcpy( p, lit, (size_t)nlit );
+	p += nlit;
+	if (mlen != 0) {
+		*p++ = (slb_uint8_t)offset;
+		*p++ = (slb_uint8_t)( offset >> 8 );
+		if (15 <= m) {
+			p += lz_put_length( m - 15, p );
+		}
+	}
+
+	*op = (slb_int_t)( p - dst );
+	return R_SUCCESS;
+}
+
+/* Writes the extension of a length, and returns the number of bytes */
+static slb_int_t lz_put_length(slb_int_t value, slb_uint8_t* dst)
+{
+	slb_int_t n = 0;
+
+	for (; 255 <= value; value -= 255) {
+		dst[n++] = 255U;
+	}
+	dst[n++] = (slb_uint8_t)value;
+	return n;
+}
+
+/* Reads the extension of a length */
+static slb_bool_t lz_get_length(slb_int_t len, const slb_uint8_t* src, slb_int_t* ip, slb_int_t* value)
+{
+	slb_uint_t b;
+
+	do {
+		if ( (*ip == len) || ( 0x7fffffff - 255 < *value ) ) {
+			return SLB_FALSE;
+		}
+		b = src[(*ip)++];
+		*value += (slb_int_t)b;
+	} while (b == 255U);
+	return SLB_TRUE;
+}
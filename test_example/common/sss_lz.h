@@ -0,0 +1,97 @@
+/*******************************************************************************
+ Compression before splitting
+ -------------------------------------------------------------------------------
+ Shares are random and do not compress, and each byte of the plain data is
+ encoded to n shares. Plain data such as logs is compressed before the encoding
+ and decompressed after the decoding.
+
+ The codec is of the LZ77 class with the block format of LZ4: a sequence is
+	token			(literal length << 4) | (match length - SSS_LZ_MIN_MATCH)
+	[255 ...]		extension of the literal length (when the field is 15)
+	literals
+	offset			2 bytes (little endian, 1 to 65535)
+	[255 ...]		extension of the match length (when the field is 15)
+ and the last sequence has only literals. A match is found by a hash table of
+ 4 bytes (SSS_LZ_HASH_BITS), and data of no match is skipped faster.
+
+ sss_lz_pack divides the plain data into frames of a size, compresses each, and
+ pads it to a multiple of unit bytes:
+	raw length		4 bytes (big endian)
+	stored length	4 bytes (big endian, SSS_LZ_STORED: not compressed)
+	payload
+	padding			0 to unit - 1 bytes of zero
+ With unit of the bytes of a coding chunk (2 * slb_sss_get_bestnmb), a frame
+ starts at a chunk boundary, so that the chunks of the frames are decoded in
+ parallel and each frame is decompressed when its chunks are decoded.
+ *******************************************************************************/
+#ifndef SSS_LZ_H
+#define SSS_LZ_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_LZ_MIN_MATCH		4			/* Minimum match length */
+#define SSS_LZ_HASH_BITS		12U			/* Bits of the hash table */
+#define SSS_LZ_FRAME_MAX		65536		/* Maximum raw bytes of a frame */
+#define SSS_LZ_HEADER			8			/* Bytes of a frame header */
+#define SSS_LZ_STORED			0x80000000U	/* Flag of the stored length: not compressed */
+
+/* Maximum compressed size of len bytes */
+#define SSS_LZ_BOUND(len)		( (len) + (len) / 255 + 16 )
+
+/* Maximum packed size of len bytes in frames of frame bytes */
+#define SSS_LZ_PACK_BOUND(len, frame, unit) \
+			( ( ( (len) + (frame) - 1 ) / (frame) ) * ( (frame) + SSS_LZ_HEADER + (unit) - 1 ) )
+
+/***** Function *****/
+SLB_RC sss_lz_compress(
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint8_t*	src,		/* bytes */
+	slb_int_t			size,		/* size of dst */
+	slb_uint8_t*		dst,		/* [out] compressed bytes */
+	slb_int_t*			out			/* [out] number of compressed bytes */
+);
+
+SLB_RC sss_lz_decompress(
+	slb_int_t			len,		/* number of compressed bytes */
+	const slb_uint8_t*	src,		/* compressed bytes */
+	slb_int_t			size,		/* size of dst */
+	slb_uint8_t*		dst,		/* [out] bytes */
+	slb_int_t*			out			/* [out] number of bytes */
+);
+
+SLB_RC sss_lz_pack(
+	slb_int_t			len,		/* number of bytes */
+	const slb_uint8_t*	src,		/* bytes */
+	slb_int_t			frame,		/* raw bytes of a frame (1 to SSS_LZ_FRAME_MAX) */
+	slb_int_t			unit,		/* alignment of the frames */
+	slb_int_t			size,		/* size of dst (SSS_LZ_PACK_BOUND) */
+	slb_uint8_t*		dst,		/* [out] frames */
+	slb_int_t*			out			/* [out] number of bytes of the frames */
+);
+
+SLB_RC sss_lz_frame(
+	slb_int_t			len,		/* number of bytes from the frame */
+	const slb_uint8_t*	src,		/* frame */
+	slb_int_t			unit,		/* alignment of the frames */
+	slb_int_t*			raw,		/* [out] raw bytes of the frame */
+	slb_int_t*			padded		/* [out] bytes of the frame with the padding */
+);
+
+SLB_RC sss_lz_unpack(
+	slb_int_t			len,		/* number of bytes of the frames */
+	const slb_uint8_t*	src,		/* frames */
+	slb_int_t			unit,		/* alignment of the frames */
+	slb_int_t			size,		/* size of dst */
+	slb_uint8_t*		dst,		/* [out] bytes */
+	slb_int_t*			out			/* [out] number of bytes */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_LZ_H */
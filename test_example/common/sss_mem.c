@@ -0,0 +1,58 @@
+/*******************************************************************************
+ Extended memory management callback
+ *******************************************************************************/
+#include "sss_mem.h"
+
+static SSS_ALLOC2 s_alloc = SLB_NULL;
+static SSS_FREE2 s_free = SLB_NULL;
+
+/* Configures callbacks */
+void sss_mem_config(
+	SSS_ALLOC2			alloc_func,	/* allocation callback (SLB_NULL: slb_alloc_aligned) */
+	SSS_FREE2			free_func	/* free callback (SLB_NULL: slb_free) */
+)
+{
+	if ( (alloc_func == SLB_NULL) || (free_func == SLB_NULL) ) {
+		alloc_func = SLB_NULL;
+		free_func = SLB_NULL;
+	}
+	s_alloc = alloc_func;
+	s_free = free_func;
+}
+
+/* Allocates memory */
+void* sss_mem_alloc(
+	void*				mem_param,	/* parameter for memory management callback */
+	slb_uint_t			size,		/* size in bytes */
+	slb_uint_t			alignment,	/* alignment (power of 2) */
+	SSS_MEM_USAGE		usage,		/* usage */
+	SSS_MEM_LIFETIME	lifetime	/* lifetime */
+)
+{
+	if (s_alloc != SLB_NULL) {
+		return s_alloc( mem_param, size, alignment, usage, lifetime );
+	}
+	return slb_alloc_aligned( mem_param, size, alignment );
+}
+
+/* Frees memory
+	slb_free does not clear the memory, since the buffers are wiped by the modules (see sss_wipe.h).
+*/
+void sss_mem_free(
+	void*				mem_param,	/* parameter for memory management callback */
+	void*				mem,		/* memory (SLB_NULL: nothing is done) */
+	slb_uint_t			size,		/* size in bytes (same as sss_mem_alloc) */
+	SSS_MEM_USAGE		usage,		/* usage (same as sss_mem_alloc) */
+	slb_bool_t			wiped		/* =SLB_TRUE: no data is left (wiped after the last use, or not used) */
+)
+{
+	if (mem == SLB_NULL) {
+		return;
+	}
+	if (s_free != SLB_NULL) {
+		s_free( mem_param, mem, size, usage, wiped );
+	}
+	else {
+		slb_free( mem_param, mem, SLB_FALSE );
+	}
+}
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ Extended memory management callback
+ -------------------------------------------------------------------------------
+ SLB_ALLOC receives only the size, and slb_alloc_aligned allocates more and
+ offsets the block for the alignment. The example modules allocate their
+ buffers by sss_mem_alloc with the alignment, the usage and the lifetime:
+	SSS_MEM_PLAIN	plain data and partial sums of it
+	SSS_MEM_SHARE	share data
+	SSS_MEM_COEF	random coefficients
+	SSS_MEM_TABLE	tables of public values (x coordinates, matrices, twiddles)
+ so that the application can route secret buffers to locked memory, large share
+ buffers to huge pages and small tables to a slab, without over-allocation.
+
+ When the callbacks are configured by sss_mem_config, they receive the requests
+ with the mem_param of the handle. The free callback receives wiped = SLB_TRUE when
+ no data is left in the buffer, so that it need not clear the buffer again. Otherwise slb_alloc_aligned and slb_free are
+ used. Configure the callbacks while no buffer of the modules is allocated.
+ *******************************************************************************/
+#ifndef SSS_MEM_H
+#define SSS_MEM_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_MEM_ALIGN		64U		/* Alignment of the buffers of data (cache line, AVX-512) */
+
+/***** Usage *****/
+typedef enum {
+	SSS_MEM_PLAIN,				/* plain data */
+	SSS_MEM_SHARE,				/* share data */
+	SSS_MEM_COEF,				/* random coefficients */
+	SSS_MEM_TABLE				/* public tables */
+} SSS_MEM_USAGE;
+
+/***** Lifetime *****/
+typedef enum {
+	SSS_MEM_CALL,				/* freed in the call */
+	SSS_MEM_HANDLE,				/* freed by the close of the handle */
+	SSS_MEM_PROCESS				/* freed at the end of the process */
+} SSS_MEM_LIFETIME;
+
+/***** Memory management callback *****/
+typedef void* (*SSS_ALLOC2)(void* param, slb_uint_t size, slb_uint_t alignment,
+							SSS_MEM_USAGE usage, SSS_MEM_LIFETIME lifetime);
+typedef void (*SSS_FREE2)(void* param, void* mem, slb_uint_t size, SSS_MEM_USAGE usage, slb_bool_t wiped);
+
+/***** Function *****/
+void sss_mem_config(
+	SSS_ALLOC2			alloc_func,	/* allocation callback (SLB_NULL: slb_alloc_aligned) */
+	SSS_FREE2			free_func	/* free callback (SLB_NULL: slb_free) */
+);
+
+void* sss_mem_alloc(
+	void*				mem_param,	/* parameter for memory management callback */
+	slb_uint_t			size,		/* size in bytes */
+	slb_uint_t			alignment,	/* alignment (power of 2) */
+	SSS_MEM_USAGE		usage,		/* usage */
+	SSS_MEM_LIFETIME	lifetime	/* lifetime */
+);
+
+void sss_mem_free(
+	void*				mem_param,	/* parameter for memory management callback */
+	void*				mem,		/* memory (SLB_NULL: nothing is done) */
+	slb_uint_t			size,		/* size in bytes (same as sss_mem_alloc) */
+	SSS_MEM_USAGE		usage,		/* usage (same as sss_mem_alloc) */
+	slb_bool_t			wiped		/* =SLB_TRUE: no data is left (wiped after the last use, or not used) */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_MEM_H */
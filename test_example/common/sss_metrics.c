@@ -0,0 +1,253 @@
+/*******************************************************************************
+ Metrics
+ *******************************************************************************/
+#include "sss_metrics.h"
+#include "sss_clock.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#	include <windows.h>
+#	define METRICS_TLS			__declspec(thread)
+#	define METRICS_ALIGN		__declspec(align(64))
+#	define METRICS_ADD(p, v)	InterlockedExchangeAdd64((volatile LONG64*)(p), (LONG64)(v))
+#	define METRICS_OWN_ADD(p, v)	( *(volatile slb_uint64_t*)(p) += (v) )
+#	define METRICS_LOAD(p)		( (slb_uint64_t)InterlockedCompareExchange64((volatile LONG64*)(p), 0, 0) )
+#	define METRICS_CLEAR(p)		InterlockedExchange64((volatile LONG64*)(p), 0)
+#	define METRICS_CLAIM()		( (slb_uint_t)InterlockedIncrement(&s_nslot) - 1U )
+#	define METRICS_CLAIMED()		( (slb_uint_t)InterlockedCompareExchange(&s_nslot, 0, 0) )
+#else
+#	define METRICS_TLS			__thread
+#	define METRICS_ALIGN		__attribute__((aligned(64)))
+#	define METRICS_ADD(p, v)	__atomic_add_fetch(p, v, __ATOMIC_RELAXED)
+#	define METRICS_OWN_ADD(p, v)	__atomic_store_n(p, __atomic_load_n(p, __ATOMIC_RELAXED) + (v), __ATOMIC_RELAXED)
+#	define METRICS_LOAD(p)		__atomic_load_n(p, __ATOMIC_RELAXED)
+#	define METRICS_CLEAR(p)		__atomic_store_n(p, 0U, __ATOMIC_RELAXED)
+#	define METRICS_CLAIM()		__atomic_fetch_add(&s_nslot, 1U, __ATOMIC_RELAXED)
+#	define METRICS_CLAIMED()		__atomic_load_n(&s_nslot, __ATOMIC_RELAXED)
+#endif
+
+#define METRICS_WORDS	( sizeof(SSS_METRICS_SNAPSHOT) / sizeof(slb_uint64_t) )
+
+/***** Slot of a thread (a multiple of the cache line) *****/
+typedef struct {
+	SSS_METRICS_SNAPSHOT	m;
+	slb_uint8_t		pad[64U - sizeof(SSS_METRICS_SNAPSHOT) % 64U];
+} METRICS_SLOT;
+
+/***** Text output *****/
+typedef struct {
+	char*			buf;			/* text */
+	slb_int_t		size;			/* size of buf */
+	slb_int_t		len;			/* length of the text */
+} METRICS_OUT;
+
+/* Names of the counters (Prometheus name, label, JSON name) */
+static const char* const s_name[SSS_METRIC_COUNT][3] = {
+	{ "sss_encode_calls_total",			"",					"encode_calls" },
+	{ "sss_encode_bytes_total",			"",					"encode_bytes" },
+	{ "sss_decode_calls_total",			"",					"decode_calls" },
+	{ "sss_decode_bytes_total",			"",					"decode_bytes" },
+	{ "sss_simd_calls_total",			"{level=\"none\"}",		"simd_none" },
+	{ "sss_simd_calls_total",			"{level=\"avx2\"}",		"simd_avx2" },
+	{ "sss_simd_calls_total",			"{level=\"avx512\"}",	"simd_avx512" },
+	{ "sss_parallel_regions_total",		"",					"parallel_regions" },
+	{ "sss_rng_bytes_total",			"",					"rng_bytes" },
+	{ "sss_wipe_bytes_total",			"",					"wipe_bytes" },
+	{ "sss_stream_bytes_total",			"",					"stream_bytes" },
+};
+static const char* const s_op[SSS_METRIC_OPS] = { "encode", "decode" };
+
+static METRICS_ALIGN METRICS_SLOT s_slot[SSS_METRICS_MAX_THREADS];
+#if defined(_MSC_VER)
+static volatile LONG s_nslot = 0;
+#else
+static slb_uint_t s_nslot = 0;
+#endif
+static METRICS_TLS METRICS_SLOT* s_mine = SLB_NULL;
+static METRICS_TLS slb_bool_t s_shared = SLB_FALSE;
+
+static METRICS_SLOT* metrics_slot(void);
+static void metrics_add(slb_uint64_t* p, slb_uint64_t value);
+static void metrics_printf(METRICS_OUT* out, const char* format, ...);
+
+/* Adds to a counter */
+void sss_metrics_add(
+	SSS_METRIC			metric,		/* counter */
+	slb_uint64_t		value		/* value to add */
+)
+{
+	metrics_add( &metrics_slot()->m.counter[metric], value );
+}
+
+/* Counts an encoding or decoding call */
+void sss_metrics_call(
+	SSS_METRIC_OP		op,			/* operation */
+	slb_uint64_t		bytes,		/* plain bytes */
+	SSS_METRIC			simd,		/* SSS_METRIC_SIMD_xxx */
+	slb_uint64_t		start_ns	/* sss_clock_ns at the start of the call */
+)
+{
+	METRICS_SLOT*const slot = metrics_slot();
+	const slb_uint64_t ns = sss_clock_ns() - start_ns;
+	slb_uint_t b = 0;
+
+	while ( (b < SSS_METRICS_BUCKETS - 1U) && ( ( (slb_uint64_t)1 << ( SSS_METRICS_BUCKET_SHIFT + b ) ) <= ns ) ) {
+		++b;
+	}
+
+	metrics_add( &slot->m.counter[( op == SSS_METRIC_OP_ENCODE ) ? SSS_METRIC_ENCODE_CALLS : SSS_METRIC_DECODE_CALLS], 1U );
+	metrics_add( &slot->m.counter[( op == SSS_METRIC_OP_ENCODE ) ? SSS_METRIC_ENCODE_BYTES : SSS_METRIC_DECODE_BYTES], bytes );
+	metrics_add( &slot->m.counter[simd], 1U );
+	metrics_add( &slot->m.bucket[op][b], 1U );
+	metrics_add( &slot->m.sum_ns[op], ns );
+}
+
+
+/* Sums the slots of the threads */
+void sss_metrics_snapshot(
+	SSS_METRICS_SNAPSHOT*	snap	/* [out] snapshot */
+)
+{
+	slb_uint64_t*const dst = (slb_uint64_t*)snap;
+	slb_uint_t nslot = METRICS_CLAIMED();
+	slb_uint_t s, w;
+
+	memset(snap, 0, sizeof(*snap));
+	if (SSS_METRICS_MAX_THREADS < nslot) {
+		nslot = SSS_METRICS_MAX_THREADS;
+	}
+	for (s = 0; s < nslot; ++s) {
+		slb_uint64_t*const src = (slb_uint64_t*)&s_slot[s].m;
+		for (w = 0; w < METRICS_WORDS; ++w) {
+			dst[w] += METRICS_LOAD(&src[w]);
+		}
+	}
+}
+
+/* Writes a snapshot
+	Returns the length of the whole text. When it is size or more, the text is
+	truncated to size - 1 characters (as snprintf).
+*/
+slb_int_t sss_metrics_export(
+	const SSS_METRICS_SNAPSHOT*	snap,	/* snapshot */
+	SSS_METRICS_FORMAT	format,		/* format */
+	char*				buf,		/* [out] text (SLB_NULL: the size is returned) */
+	slb_int_t			size		/* size of buf */
+)
+{
+	METRICS_OUT out;
+	slb_uint64_t count;
+	slb_uint_t m, op, b;
+
+	out.buf = buf;
+	out.size = (buf == SLB_NULL) ? 0 : size;
+	out.len = 0;
+	if (0 < out.size) {
+		buf[0] = '\0';
+	}
+
+	if (format == SSS_METRICS_PROMETHEUS) {
+		for (m = 0; m < SSS_METRIC_COUNT; ++m) {
+			if ( (m == 0U) || (strcmp(s_name[m][0], s_name[m - 1U][0]) != 0) ) {
+				metrics_printf( &out, "# TYPE %s counter\n", s_name[m][0] );
+			}
+			metrics_printf( &out, "%s%s %llu\n", s_name[m][0], s_name[m][1], (unsigned long long)snap->counter[m] );
+		}
+		metrics_printf( &out, "# TYPE sss_latency_seconds histogram\n" );
+		for (op = 0; op < SSS_METRIC_OPS; ++op) {
+			count = 0;
+			for (b = 0; b < SSS_METRICS_BUCKETS - 1U; ++b) {
+				count += snap->bucket[op][b];
+				metrics_printf( &out, "sss_latency_seconds_bucket{op=\"%s\",le=\"%g\"} %llu\n",
+								s_op[op], (double)( (slb_uint64_t)1 << ( SSS_METRICS_BUCKET_SHIFT + b ) ) / 1e9,
+								(unsigned long long)count );
+			}
+			count += snap->bucket[op][b];
+			metrics_printf( &out, "sss_latency_seconds_bucket{op=\"%s\",le=\"+Inf\"} %llu\n", s_op[op], (unsigned long long)count );
+			metrics_printf( &out, "sss_latency_seconds_sum{op=\"%s\"} %g\n", s_op[op], (double)snap->sum_ns[op] / 1e9 );
+			metrics_printf( &out, "sss_latency_seconds_count{op=\"%s\"} %llu\n", s_op[op], (unsigned long long)count );
+		}
+	}
+	else {
+		metrics_printf( &out, "{" );
+		for (m = 0; m < SSS_METRIC_COUNT; ++m) {
+			metrics_printf( &out, "\"%s\":%llu,", s_name[m][2], (unsigned long long)snap->counter[m] );
+		}
+		metrics_printf( &out, "\"latency\":{\"bucket0_le_ns\":%u", 1U << SSS_METRICS_BUCKET_SHIFT );
+		for (op = 0; op < SSS_METRIC_OPS; ++op) {
+			metrics_printf( &out, ",\"%s\":{\"sum_ns\":%llu,\"buckets\":[", s_op[op], (unsigned long long)snap->sum_ns[op] );
+			for (b = 0; b < SSS_METRICS_BUCKETS; ++b) {
+				metrics_printf( &out, ( b == 0U ) ? "%llu" : ",%llu", (unsigned long long)snap->bucket[op][b] );
+			}
+			metrics_printf( &out, "]}" );
+		}
+		metrics_printf( &out, "}}\n" );
+	}
+	return out.len;
+}
+
+/* Clears the metrics (the threads counting at the same time may be left partly) */
+void sss_metrics_reset(void)
+{
+	slb_uint_t nslot = METRICS_CLAIMED();
+	slb_uint_t s, w;
+
+	if (SSS_METRICS_MAX_THREADS < nslot) {
+		nslot = SSS_METRICS_MAX_THREADS;
+	}
+	for (s = 0; s < nslot; ++s) {
+		slb_uint64_t*const p = (slb_uint64_t*)&s_slot[s].m;
+		for (w = 0; w < METRICS_WORDS; ++w) {
+			METRICS_CLEAR(&p[w]);
+		}
+	}
+}
+
+/* Returns the slot of the calling thread */
+static METRICS_SLOT* metrics_slot(void)
+{
+	slb_uint_t s;
+
+	if (s_mine == SLB_NULL) {
+		s = (slb_uint_t)METRICS_CLAIM();
+		s_shared = ( SSS_METRICS_MAX_THREADS - 1U <= s ) ? SLB_TRUE : SLB_FALSE;
+		s_mine = &s_slot[s_shared ? SSS_METRICS_MAX_THREADS - 1U : s];
+	}
+	return s_mine;
+}
+
+/* Adds to a counter of the slot
+	Only the owner thread writes to its slot, so no locked instruction is needed
+	except for the last slot shared by the overflowing threads.
+*/
+static void metrics_add(slb_uint64_t* p, slb_uint64_t value)
+{
+	if (s_shared) {
+		METRICS_ADD(p, value);
+	}
+	else {
+		METRICS_OWN_ADD(p, value);
+	}
+}
+
+/* Appends to the text */
+static void metrics_printf(METRICS_OUT* out, const char* format, ...)
+{
+	va_list args;
+	int len;
+
+	va_start(args, format);
+	if (out->len < out->size) {
+		len = vsnprintf( &out->buf[out->len], (size_t)( out->size - out->len ), format, args );
+	}
+	else {
+		len = vsnprintf( SLB_NULL, 0, format, args );
+	}
+	va_end(args);
+	if (0 < len) {
+		out->len += len;
+	}
+}
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ Metrics
+ -------------------------------------------------------------------------------
+ SLB_SSS_STATISTICS is of a handle, and it is lost by slb_sss_close.
+ The metrics are of the process, and always on: the modules of this directory
+ count their calls, bytes, SIMD, parallel regions, random, wiped and streamed
+ bytes, and the latency of encoding and decoding.
+
+ Each thread adds to its own slot of a cache line boundary without a locked
+ instruction, so that the counting costs a few ns besides the clock. When
+ SSS_METRICS_MAX_THREADS - 1 threads have slots, the rest share the last slot
+ with atomic adds.
+ sss_metrics_snapshot sums the slots, and sss_metrics_export writes a snapshot
+ in the Prometheus text format or JSON.
+
+ The latency histogram has SSS_METRICS_BUCKETS buckets of powers of 2:
+ bucket i counts the latency of 2^(SSS_METRICS_BUCKET_SHIFT + i - 1) ns or more
+ and less than 2^(SSS_METRICS_BUCKET_SHIFT + i) ns, and the last one is unbounded.
+ *******************************************************************************/
+#ifndef SSS_METRICS_H
+#define SSS_METRICS_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_METRICS_MAX_THREADS		256U	/* Slots of threads */
+#define SSS_METRICS_BUCKETS			24U		/* Buckets of the latency histogram */
+#define SSS_METRICS_BUCKET_SHIFT	8U		/* Bound of bucket 0 (2^8 = 256 ns) */
+
+/***** Counter *****/
+typedef enum {
+	SSS_METRIC_ENCODE_CALLS = 0,			/* encoding calls */
+	SSS_METRIC_ENCODE_BYTES,				/* plain bytes encoded */
+	SSS_METRIC_DECODE_CALLS,				/* decoding calls */
+	SSS_METRIC_DECODE_BYTES,				/* plain bytes decoded */
+	SSS_METRIC_SIMD_NONE,					/* calls without SIMD */
+	SSS_METRIC_SIMD_AVX2,					/* calls with AVX2 */
+	SSS_METRIC_SIMD_AVX512,					/* calls with AVX-512 */
+	SSS_METRIC_PARALLEL_REGIONS,			/* parallel regions (thread team) */
+	SSS_METRIC_RNG_BYTES,					/* random bytes */
+	SSS_METRIC_WIPE_BYTES,					/* wiped bytes */
+	SSS_METRIC_STREAM_BYTES,				/* share bytes written by non-temporal stores */
+	SSS_METRIC_COUNT
+} SSS_METRIC;
+
+/***** Operation of latency *****/
+typedef enum {
+	SSS_METRIC_OP_ENCODE = 0,				/* encoding */
+	SSS_METRIC_OP_DECODE,					/* decoding */
+	SSS_METRIC_OPS
+} SSS_METRIC_OP;
+
+/***** Export format *****/
+typedef enum {
+	SSS_METRICS_PROMETHEUS = 0,				/* Prometheus text format */
+	SSS_METRICS_JSON						/* JSON */
+} SSS_METRICS_FORMAT;
+
+/***** Snapshot *****/
+typedef struct {
+	slb_uint64_t	counter[SSS_METRIC_COUNT];						/* counters */
+	slb_uint64_t	bucket[SSS_METRIC_OPS][SSS_METRICS_BUCKETS];	/* latency histograms */
+	slb_uint64_t	sum_ns[SSS_METRIC_OPS];							/* sum of latency (ns) */
+} SSS_METRICS_SNAPSHOT;
+
+/***** Function *****/
+void sss_metrics_add(
+	SSS_METRIC			metric,		/* counter */
+	slb_uint64_t		value		/* value to add */
+);
+
+void sss_metrics_call(
+	SSS_METRIC_OP		op,			/* operation */
+	slb_uint64_t		bytes,		/* plain bytes */
+	SSS_METRIC			simd,		/* SSS_METRIC_SIMD_xxx */
+	slb_uint64_t		start_ns	/* sss_clock_ns at the start of the call */
+);
+
+void sss_metrics_snapshot(
+	SSS_METRICS_SNAPSHOT*	snap	/* [out] snapshot */
+);
+
+slb_int_t sss_metrics_export(
+	const SSS_METRICS_SNAPSHOT*	snap,	/* snapshot */
+	SSS_METRICS_FORMAT	format,		/* format */
+	char*				buf,		/* [out] text (SLB_NULL: the size is returned) */
+	slb_int_t			size		/* size of buf */
+);
+
+void sss_metrics_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_METRICS_H */
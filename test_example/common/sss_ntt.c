@@ -0,0 +1,399 @@
+/*******************************************************************************
+ NTT encoding
+ *******************************************************************************/
+#include "sss_ntt.h"
+#include "sss_gfp.h"
+#include "sss_wipe.h"
+#include "sss_metrics.h"
+#include "sss_clock.h"
+#include "sss_mem.h"
+#include "cpuinfo.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+#define NTT_PRIMITIVE_ROOT	3U			/* Primitive root of GF(65537) */
+#define NTT_COSET_SHIFT		3U			/* Shift of x coordinates (not in the subgroup of order N) */
+
+/* Sizes of the buffers */
+#define NTT_SIZE_X(t)		(slb_uint_t)( sizeof(slb_uint16_t) * (t)->n )
+#define NTT_SIZE_TW(t)		(slb_uint_t)( sizeof(slb_uint32_t) * ( (t)->l / 2U ) )
+#define NTT_SIZE_SHIFT(t)	(slb_uint_t)( sizeof(slb_uint32_t) * (t)->ncoset * (t)->k )
+#define NTT_SIZE_COEF(t)	(slb_uint_t)( sizeof(slb_uint32_t) * (t)->k * (slb_uint_t)(t)->nmb_max )
+#define NTT_SIZE_BUF(t)		(slb_uint_t)( sizeof(slb_uint32_t) * (t)->l * (slb_uint_t)(t)->nmb_max )
+#define NTT_SIZE_RND(t)		(slb_uint_t)( sizeof(slb_uint64_t) * (slb_uint_t)(t)->nmb_max )
+
+static void ntt_transform(SSS_NTT* ntt, slb_int_t nmb, slb_uint32_t** share);
+static void ntt_horner(SSS_NTT* ntt, slb_int_t nmb, slb_uint32_t** share);
+static void ntt_mul_row(slb_uint32_t* dst, const slb_uint32_t* src, slb_uint32_t s, slb_int_t nmb);
+static void ntt_mul_row_avx2(slb_uint32_t* dst, const slb_uint32_t* src, slb_uint32_t s, slb_int_t nmb);
+static void ntt_butterfly(slb_uint32_t* a, slb_uint32_t* b, slb_uint32_t w, slb_int_t nmb);
+static void ntt_butterfly_avx2(slb_uint32_t* a, slb_uint32_t* b, slb_uint32_t w, slb_int_t nmb);
+static slb_uint_t ntt_pow2(slb_uint_t v);
+static slb_uint_t ntt_log2(slb_uint_t v);
+static slb_uint_t ntt_bitrev(slb_uint_t v, slb_uint_t bits);
+
+static slb_bool_t s_avx2 = SLB_FALSE;
+
+/* Sets SIMD to be used */
+void sss_ntt_set_simd(
+	slb_bool_t			avx2		/* =SLB_TRUE: AVX2 is used */
+)
+{
+	s_avx2 = avx2;
+}
+
+/* Returns if NTT encoding is effective
+	The cost of the Horner method is n * k multiplications per plain word.
+	The cost of NTT is (L / 2) * log2(L) butterflies and k multiplications for each coset.
+	The minimum ratio depends on the SIMD set by sss_ntt_set_simd.
+*/
+slb_bool_t sss_ntt_effective(
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n			/* number of shares */
+)
+{
+	slb_uint_t l, ncoset, gain;
+
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (n < k) || (SSS_NTT_MAX_PLAYERS < n) ) {
+		return SLB_FALSE;
+	}
+
+	l = ntt_pow2(k);
+	ncoset = ( n + l - 1U ) / l;
+
+	gain = s_avx2 ? SSS_NTT_MIN_GAIN_AVX2 : SSS_NTT_MIN_GAIN;
+
+	return (slb_bool_t)( gain * ncoset * ( ( l / 2U ) * ntt_log2(l) + k ) <= n * k );
+}
+
+/* Opens NTT encoding handle */
+SLB_RC sss_ntt_open(
+	SSS_NTT*			ntt,		/* NTT encoding handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param,	/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func,	/* random number callback */
+	void*				rand_param	/* parameter for random number callback */
+)
+{
+	slb_uint_t a, b, j;
+	slb_uint32_t w, v, s, xa;
+
+	memset(ntt, 0, sizeof(*ntt));
+
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (n < k) || (SSS_NTT_MAX_PLAYERS < n) ||
+		 (nmb_max <= 0) || (rand_func == SLB_NULL) ) {
+		return R_INVALID_PARAM;
+	}
+
+	ntt->k = k;
+	ntt->n = n;
+	ntt->l = ntt_pow2(k);
+	ntt->ncoset = ( n + ntt->l - 1U ) / ntt->l;
+	ntt->use_ntt = sss_ntt_effective(k, n);
+	ntt->nmb_max = nmb_max;
+	ntt->mem_param = mem_param;
+	ntt->rand_func = rand_func;
+	ntt->rand_param = rand_param;
+
+	/* Allocate resources */
+	ntt->x = sss_mem_alloc( mem_param, NTT_SIZE_X(ntt), sizeof(slb_uint16_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	ntt->tw = sss_mem_alloc( mem_param, NTT_SIZE_TW(ntt), sizeof(slb_uint32_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	ntt->shift = sss_mem_alloc( mem_param, NTT_SIZE_SHIFT(ntt), sizeof(slb_uint32_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	ntt->coef = sss_mem_alloc( mem_param, NTT_SIZE_COEF(ntt), SSS_MEM_ALIGN, SSS_MEM_COEF, SSS_MEM_HANDLE );
+	ntt->buf = sss_mem_alloc( mem_param, NTT_SIZE_BUF(ntt), SSS_MEM_ALIGN, SSS_MEM_COEF, SSS_MEM_HANDLE );
+	ntt->rnd = sss_mem_alloc( mem_param, NTT_SIZE_RND(ntt), SSS_MEM_ALIGN, SSS_MEM_COEF, SSS_MEM_HANDLE );
+
+	if ( (ntt->x == SLB_NULL) || (ntt->tw == SLB_NULL) || (ntt->shift == SLB_NULL) ||
+		 (ntt->coef == SLB_NULL) || (ntt->buf == SLB_NULL) || (ntt->rnd == SLB_NULL) ) {
+		sss_ntt_close(ntt);
+		return R_LOW_MEMORY;
+	}
+
+	/* w: root of unity of order N (N = L * (power of 2 not less than number of cosets)), v = w^(N / L) */
+	w = sss_gfp_pow( NTT_PRIMITIVE_ROOT, ( SSS_GFP_PRIME - 1U ) / ( ntt->l * ntt_pow2(ntt->ncoset) ) );
+	v = sss_gfp_pow( NTT_PRIMITIVE_ROOT, ( SSS_GFP_PRIME - 1U ) / ntt->l );
+
+	for (j = 0; j < ntt->l / 2U; ++j) {
+		ntt->tw[j] = sss_gfp_pow(v, j);
+	}
+
+	for (a = 0; a < ntt->ncoset; ++a) {
+
+		/* Coset shift G * w^a and its powers */
+		xa = SSS_GFP_MUL( NTT_COSET_SHIFT, sss_gfp_pow(w, a) );
+		s = 1U;
+		for (j = 0; j < k; ++j) {
+			ntt->shift[a * k + j] = s;
+			s = SSS_GFP_MUL(s, xa);
+		}
+
+		/* x coordinates of the coset */
+		for (b = 0; (b < ntt->l) && (a * ntt->l + b < n); ++b) {
+			ntt->x[a * ntt->l + b] = (slb_uint16_t)SSS_GFP_MUL( xa, sss_gfp_pow(v, b) );
+		}
+	}
+
+	return R_SUCCESS;
+}
+
+/* Encodes plain data
+	NTT is used when sss_ntt_effective is true for k and n, or else the Horner method.
+	Both evaluate the polynomial at the same x coordinates.
+*/
+SLB_RC sss_ntt_encode(
+	SSS_NTT*			ntt,		/* NTT encoding handle */
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint16_t*	plain,		/* plain data */
+	slb_uint32_t**		share		/* [out] share buffer [n] */
+)
+{
+	const slb_uint_t k = ntt->k;
+	const slb_uint_t l = ntt->l;
+	const slb_uint_t row = (slb_uint_t)nmb;
+	const slb_uint64_t clk = sss_clock_ns();
+	slb_uint_t j;
+	slb_int_t d;
+
+	if ( (ntt->k == 0U) || (nmb <= 0) || (ntt->nmb_max < nmb) ) {
+		return R_INVALID_PARAM;
+	}
+
+	/* Coefficients (the 64-bit random numbers are reduced, so the bias is negligible) */
+	for (d = 0; d < nmb; ++d) {
+		ntt->coef[d] = plain[d];
+	}
+	for (j = 1; j < k; ++j) {
+		if ( !ntt->rand_func( ntt->rand_param, sizeof(slb_uint64_t) * row, ntt->rnd ) ) {
+			sss_wipe_class( SSS_WIPE_COEF, ntt->coef, (slb_uint_t)sizeof(slb_uint32_t) * k * row );
+			sss_wipe_class( SSS_WIPE_COEF, ntt->rnd, (slb_uint_t)sizeof(slb_uint64_t) * row );
+			return R_RAND_FAIL;
+		}
+		for (d = 0; d < nmb; ++d) {
+			ntt->coef[j * row + (slb_uint_t)d] = sss_gfp_reduce( ntt->rnd[d] );
+		}
+	}
+
+	if (ntt->use_ntt) {
+		ntt_transform(ntt, nmb, share);
+		sss_wipe_class( SSS_WIPE_COEF, ntt->buf, (slb_uint_t)sizeof(slb_uint32_t) * l * row );
+	}
+	else {
+		ntt_horner(ntt, nmb, share);
+	}
+
+	sss_wipe_class( SSS_WIPE_COEF, ntt->coef, (slb_uint_t)sizeof(slb_uint32_t) * k * row );
+	sss_wipe_class( SSS_WIPE_COEF, ntt->rnd, (slb_uint_t)sizeof(slb_uint64_t) * row );
+	sss_metrics_add( SSS_METRIC_RNG_BYTES, sizeof(slb_uint64_t) * (slb_uint64_t)row * ( k - 1U ) );
+	sss_metrics_call( SSS_METRIC_OP_ENCODE, sizeof(slb_uint16_t) * (slb_uint64_t)row,
+					  ( ntt->use_ntt && s_avx2 ) ? SSS_METRIC_SIMD_AVX2 : SSS_METRIC_SIMD_NONE, clk );
+
+	return R_SUCCESS;
+}
+
+/* Closes NTT encoding handle */
+void sss_ntt_close(
+	SSS_NTT*			ntt			/* NTT encoding handle */
+)
+{
+	void* mem_param = ntt->mem_param;
+
+	sss_mem_free( mem_param, ntt->x, NTT_SIZE_X(ntt), SSS_MEM_TABLE, SLB_FALSE );
+	sss_mem_free( mem_param, ntt->tw, NTT_SIZE_TW(ntt), SSS_MEM_TABLE, SLB_FALSE );
+	sss_mem_free( mem_param, ntt->shift, NTT_SIZE_SHIFT(ntt), SSS_MEM_TABLE, SLB_FALSE );
+	sss_mem_free( mem_param, ntt->coef, NTT_SIZE_COEF(ntt), SSS_MEM_COEF, SLB_TRUE );		/* wiped after each encoding */
+	sss_mem_free( mem_param, ntt->buf, NTT_SIZE_BUF(ntt), SSS_MEM_COEF, SLB_TRUE );
+	sss_mem_free( mem_param, ntt->rnd, NTT_SIZE_RND(ntt), SSS_MEM_COEF, SLB_TRUE );
+
+	memset(ntt, 0, sizeof(*ntt));
+}
+
+/* Evaluates the polynomial by NTT
+	For each coset, the coefficients multiplied by the powers of the coset shift are
+	transformed by NTT of L points (decimation in frequency), whose output is in bit-reversed order.
+	Each butterfly is applied to whole rows of the chunk.
+*/
+static void ntt_transform(SSS_NTT* ntt, slb_int_t nmb, slb_uint32_t** share)
+{
+	const slb_uint_t k = ntt->k;
+	const slb_uint_t l = ntt->l;
+	const slb_uint_t bits = ntt_log2(l);
+	const slb_uint_t row = (slb_uint_t)nmb;
+	void (*mul_row)(slb_uint32_t*, const slb_uint32_t*, slb_uint32_t, slb_int_t);
+	void (*butterfly)(slb_uint32_t*, slb_uint32_t*, slb_uint32_t, slb_int_t);
+	slb_uint_t a, j, len, start, pos, i;
+
+	mul_row = s_avx2 ? ntt_mul_row_avx2 : ntt_mul_row;
+	butterfly = s_avx2 ? ntt_butterfly_avx2 : ntt_butterfly;
+
+	for (a = 0; a < ntt->ncoset; ++a) {
+
+		/* Multiply by the powers of the coset shift, and pad with zero */
+		for (j = 0; j < k; ++j) {
+			mul_row( &ntt->buf[j * row], &ntt->coef[j * row], ntt->shift[a * k + j], nmb );
+		}
+		memset( &ntt->buf[k * row], 0, sizeof(slb_uint32_t) * ( l - k ) * row );
+
+		/* NTT */
+		for (len = l / 2U; 0U < len; len /= 2U) {
+			const slb_uint_t step = l / ( 2U * len );
+			for (start = 0; start < l; start += 2U * len) {
+				for (j = 0; j < len; ++j) {
+					butterfly( &ntt->buf[(start + j) * row], &ntt->buf[(start + j + len) * row], ntt->tw[j * step], nmb );
+				}
+			}
+		}
+
+		/* Output to the shares */
+		for (pos = 0; pos < l; ++pos) {
+			i = a * l + ntt_bitrev(pos, bits);
+			if (i < ntt->n) {
+				memcpy( share[i], &ntt->buf[pos * row], sizeof(slb_uint32_t) * row );
+			}
+		}
+	}
+}
+
+/* Evaluates the polynomial by the Horner method at each x coordinate */
+static void ntt_horner(SSS_NTT* ntt, slb_int_t nmb, slb_uint32_t** share)
+{
+	const slb_uint_t k = ntt->k;
+	const slb_uint_t row = (slb_uint_t)nmb;
+	slb_uint32_t x, acc;
+	slb_uint_t i, j;
+	slb_int_t d;
+
+	for (i = 0; i < ntt->n; ++i) {
+		x = ntt->x[i];
+		for (d = 0; d < nmb; ++d) {
+			acc = ntt->coef[(k - 1U) * row + (slb_uint_t)d];
+			for (j = k - 1U; 0U < j; --j) {
+				acc = sss_gfp_reduce( (slb_uint64_t)acc * x + ntt->coef[(j - 1U) * row + (slb_uint_t)d] );
+			}
+			share[i][d] = acc;
+		}
+	}
+}
+
+/* Multiplies a row (no SIMD) */
+static void ntt_mul_row(slb_uint32_t* dst, const slb_uint32_t* src, slb_uint32_t s, slb_int_t nmb)
+{
+	slb_int_t d;
+
+	for (d = 0; d < nmb; ++d) {
+		dst[d] = SSS_GFP_MUL( src[d], s );
+	}
+}
+
+/* Multiplies a row (AVX2)
+	Since s is public, s = 65536 (= -1) is processed as negation,
+	and the other products are less than 2^32.
+	A product t is reduced as (t mod 2^16) - (t / 2^16), since 2^16 = -1.
+*/
+SIMD_TARGET("avx2")
+static void ntt_mul_row_avx2(slb_uint32_t* dst, const slb_uint32_t* src, slb_uint32_t s, slb_int_t nmb)
+{
+	const __m256i p = _mm256_set1_epi32( (int)SSS_GFP_PRIME );
+	const __m256i pm1 = _mm256_set1_epi32( (int)( SSS_GFP_PRIME - 1U ) );
+	const __m256i mask = _mm256_set1_epi32( (int)SLB_MASK_OF_UINT16 );
+	const __m256i vs = _mm256_set1_epi32( (int)s );
+	__m256i t;
+	slb_int_t d;
+
+	for (d = 0; d + 8 <= nmb; d += 8) {
+		t = _mm256_loadu_si256( (const __m256i*)&src[d] );
+		if (s == SSS_GFP_PRIME - 1U) {
+			t = _mm256_sub_epi32(p, t);
+		}
+		else {
+			t = _mm256_mullo_epi32(t, vs);
+			t = _mm256_add_epi32( _mm256_sub_epi32( _mm256_and_si256(t, mask), _mm256_srli_epi32(t, 16) ), p );
+		}
+		t = _mm256_sub_epi32( t, _mm256_and_si256( p, _mm256_cmpgt_epi32(t, pm1) ) );
+		_mm256_storeu_si256( (__m256i*)&dst[d], t );
+	}
+	ntt_mul_row( &dst[d], &src[d], s, nmb - d );
+}
+
+/* Butterfly (no SIMD): a = a + b, b = (a - b) * w */
+static void ntt_butterfly(slb_uint32_t* a, slb_uint32_t* b, slb_uint32_t w, slb_int_t nmb)
+{
+	slb_uint32_t u, v;
+	slb_int_t d;
+
+	for (d = 0; d < nmb; ++d) {
+		u = a[d];
+		v = b[d];
+		a[d] = SSS_GFP_ADD(u, v);
+		b[d] = SSS_GFP_MUL( SSS_GFP_SUB(u, v), w );
+	}
+}
+
+/* Butterfly (AVX2)
+	The twiddle factor w is never 65536, so (a - b) * w is less than 2^32.
+*/
+SIMD_TARGET("avx2")
+static void ntt_butterfly_avx2(slb_uint32_t* a, slb_uint32_t* b, slb_uint32_t w, slb_int_t nmb)
+{
+	const __m256i p = _mm256_set1_epi32( (int)SSS_GFP_PRIME );
+	const __m256i pm1 = _mm256_set1_epi32( (int)( SSS_GFP_PRIME - 1U ) );
+	const __m256i mask = _mm256_set1_epi32( (int)SLB_MASK_OF_UINT16 );
+	const __m256i vw = _mm256_set1_epi32( (int)w );
+	__m256i u, v, s, t;
+	slb_int_t d;
+
+	for (d = 0; d + 8 <= nmb; d += 8) {
+		u = _mm256_loadu_si256( (const __m256i*)&a[d] );
+		v = _mm256_loadu_si256( (const __m256i*)&b[d] );
+
+		s = _mm256_add_epi32(u, v);
+		s = _mm256_sub_epi32( s, _mm256_and_si256( p, _mm256_cmpgt_epi32(s, pm1) ) );
+
+		t = _mm256_add_epi32( _mm256_sub_epi32(u, v), p );
+		t = _mm256_sub_epi32( t, _mm256_and_si256( p, _mm256_cmpgt_epi32(t, pm1) ) );
+		t = _mm256_mullo_epi32(t, vw);
+		t = _mm256_add_epi32( _mm256_sub_epi32( _mm256_and_si256(t, mask), _mm256_srli_epi32(t, 16) ), p );
+		t = _mm256_sub_epi32( t, _mm256_and_si256( p, _mm256_cmpgt_epi32(t, pm1) ) );
+
+		_mm256_storeu_si256( (__m256i*)&a[d], s );
+		_mm256_storeu_si256( (__m256i*)&b[d], t );
+	}
+	ntt_butterfly( &a[d], &b[d], w, nmb - d );
+}
+
+/* Returns the power of 2 not less than v (at least 2) */
+static slb_uint_t ntt_pow2(slb_uint_t v)
+{
+	slb_uint_t p = 2U;
+
+	while (p < v) {
+		p *= 2U;
+	}
+	return p;
+}
+
+/* Returns log2 of the power of 2 */
+static slb_uint_t ntt_log2(slb_uint_t v)
+{
+	slb_uint_t bits = 0;
+
+	while ( (1U << bits) < v ) {
+		++bits;
+	}
+	return bits;
+}
+
+/* Reverses the lower bits */
+static slb_uint_t ntt_bitrev(slb_uint_t v, slb_uint_t bits)
+{
+	slb_uint_t r = 0;
+	slb_uint_t i;
+
+	for (i = 0; i < bits; ++i) {
+		r = ( r << 1 ) | ( ( v >> i ) & 1U );
+	}
+	return r;
+}
+
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ NTT encoding
+ -------------------------------------------------------------------------------
+ Encodes with the number-theoretic transform over GF(65537) when n and k are large.
+ Evaluating the polynomial at n points by the Horner method costs O(n * k)
+ per plain word. When the x coordinates are taken from the roots of unity,
+ the evaluation is done by NTTs of L points (L is the power of 2 not less than k),
+ and it costs O(n * log(k)) per plain word.
+
+ The x coordinate of share i (i = a * L + b) is G * w^a * v^b,
+ where w is a primitive root of unity of order N, v = w^(N / L) and G = 3.
+ Since G is not in the subgroup of order N, the x coordinate is never 65536,
+ and it fits in slb_uint16_t. The x coordinates are decided by n and k,
+ and most of them are above the range of slb_sss_decode.
+
+ The handle evaluates the polynomial at the same x coordinates by the Horner method
+ when NTT is not effective for n and k (sss_ntt_effective).
+ *******************************************************************************/
+#ifndef SSS_NTT_H
+#define SSS_NTT_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_NTT_MAX_PLAYERS		32768U		/* Maximum players */
+#define SSS_NTT_MIN_GAIN		2U			/* Minimum ratio of cost (Horner / NTT) to use NTT (by benchmark) */
+#define SSS_NTT_MIN_GAIN_AVX2	1U			/* Same as above when AVX2 is used (by benchmark) */
+
+/***** NTT encoding handle *****/
+typedef struct {
+	slb_uint_t		k;				/* threshold */
+	slb_uint_t		n;				/* number of shares */
+	slb_uint_t		l;				/* number of points of NTT */
+	slb_uint_t		ncoset;			/* number of cosets */
+	slb_bool_t		use_ntt;		/* =SLB_TRUE: NTT is used (=SLB_FALSE: Horner method at the same x coordinates) */
+	slb_int_t		nmb_max;		/* maximum number of data */
+	void*			mem_param;		/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func;	/* random number callback */
+	void*			rand_param;		/* parameter for random number callback */
+
+	slb_uint16_t*	x;				/* x coordinates [n] */
+	slb_uint32_t*	tw;				/* twiddle factors [l / 2] */
+	slb_uint32_t*	shift;			/* powers of coset shifts [ncoset * k] */
+	slb_uint32_t*	coef;			/* coefficients (row 0 is plain data) [k * nmb_max] */
+	slb_uint32_t*	buf;			/* NTT buffer [l * nmb_max] */
+	slb_uint64_t*	rnd;			/* random numbers [nmb_max] */
+} SSS_NTT;
+
+/***** Function *****/
+void sss_ntt_set_simd(
+	slb_bool_t			avx2		/* =SLB_TRUE: AVX2 is used */
+);
+
+slb_bool_t sss_ntt_effective(
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n			/* number of shares */
+);
+
+SLB_RC sss_ntt_open(
+	SSS_NTT*			ntt,		/* NTT encoding handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param,	/* parameter for memory management callback */
+	SLB_RAND_CALLBACK	rand_func,	/* random number callback */
+	void*				rand_param	/* parameter for random number callback */
+);
+
+SLB_RC sss_ntt_encode(
+	SSS_NTT*			ntt,		/* NTT encoding handle */
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint16_t*	plain,		/* plain data */
+	slb_uint32_t**		share		/* [out] share buffer [n] */
+);
+
+void sss_ntt_close(
+	SSS_NTT*			ntt			/* NTT encoding handle */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_NTT_H */
@@ -0,0 +1,178 @@
+/*******************************************************************************
+ Online decoding
+ *******************************************************************************/
+#include "sss_online.h"
+#include "sss_gfp.h"
+#include "sss_wipe.h"
+#include "sss_mem.h"
+
+#include <string.h>
+
+/* Sizes of the buffers */
+#define ONLINE_SIZE_X(o)		(slb_uint_t)( sizeof(slb_uint16_t) * (o)->n_max )
+#define ONLINE_SIZE_DONE(o)		(slb_uint_t)( sizeof(slb_bool_t) * (o)->n_max )
+#define ONLINE_SIZE_P(o)		(slb_uint_t)( sizeof(slb_uint32_t) * (o)->n_max )
+#define ONLINE_SIZE_VALUE(o)	(slb_uint_t)( sizeof(slb_uint32_t) * (o)->n_max * (slb_uint_t)(o)->nmb_max )
+#define ONLINE_SIZE_DATA(o)		(slb_uint_t)( sizeof(slb_uint32_t) * (slb_uint_t)(o)->nmb_max )
+
+
+/* Opens online decoding handle */
+SLB_RC sss_online_open(
+	SSS_ONLINE*			online,		/* online decoding handle */
+	slb_uint_t			n_max,		/* maximum number of holders */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	memset(online, 0, sizeof(*online));
+
+	if ( (n_max < SLB_SSS_MIN_PLAYERS) || (slb_sss_get_max_players_decode() < n_max) || (nmb_max <= 0) ) {
+		return R_INVALID_PARAM;
+	}
+
+	online->n_max = n_max;
+	online->nmb_max = nmb_max;
+	online->mem_param = mem_param;
+
+	online->x = sss_mem_alloc( mem_param, ONLINE_SIZE_X(online), sizeof(slb_uint16_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	online->done = sss_mem_alloc( mem_param, ONLINE_SIZE_DONE(online), sizeof(slb_bool_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	online->p = sss_mem_alloc( mem_param, ONLINE_SIZE_P(online), sizeof(slb_uint32_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	online->value = sss_mem_alloc( mem_param, ONLINE_SIZE_VALUE(online), SSS_MEM_ALIGN, SSS_MEM_SHARE, SSS_MEM_HANDLE );
+	online->f0 = sss_mem_alloc( mem_param, ONLINE_SIZE_DATA(online), SSS_MEM_ALIGN, SSS_MEM_PLAIN, SSS_MEM_HANDLE );
+	online->c = sss_mem_alloc( mem_param, ONLINE_SIZE_DATA(online), SSS_MEM_ALIGN, SSS_MEM_COEF, SSS_MEM_HANDLE );
+	if ( (online->x == SLB_NULL) || (online->done == SLB_NULL) || (online->p == SLB_NULL) ||
+		 (online->value == SLB_NULL) || (online->f0 == SLB_NULL) || (online->c == SLB_NULL) ) {
+		sss_online_close(online);
+		return R_LOW_MEMORY;
+	}
+
+	return R_SUCCESS;
+}
+
+/* Starts decoding
+	No share has arrived: f_S = 0 and P_S = 1.
+*/
+SLB_RC sss_online_start(
+	SSS_ONLINE*			online,		/* online decoding handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of holders */
+	const slb_uint16_t	x[],		/* x coordinates of holders */
+	slb_int_t			nmb			/* number of data of a share */
+)
+{
+	slb_uint_t i;
+	SLB_RC rc;
+
+	online->k = 0;
+
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (n < k) || (online->n_max < n) || (nmb <= 0) || (online->nmb_max < nmb) ) {
+		return R_INVALID_PARAM;
+	}
+	rc = sss_gfp_check_x( n, x, slb_sss_get_max_players_decode() );
+	if ( SLB_R_FAILED(rc) ) {
+		return rc;
+	}
+
+	memcpy( online->x, x, sizeof(slb_uint16_t) * n );
+	for (i = 0; i < n; ++i) {
+		online->done[i] = SLB_FALSE;
+		online->p[i] = 1U;
+	}
+	memset( online->value, 0, sizeof(slb_uint32_t) * n * (slb_uint_t)nmb );
+	memset( online->f0, 0, sizeof(slb_uint32_t) * (slb_uint_t)nmb );
+
+	online->k = k;
+	online->n = n;
+	online->nmb = nmb;
+	online->arrived = 0;
+	online->p0 = 1U;
+	return R_SUCCESS;
+}
+
+/* Adds a share
+	R_SUCCESS is returned until the k-th share, and R_COMPLETE with the plain data at the k-th share.
+*/
+SLB_RC sss_online_add(
+	SSS_ONLINE*			online,		/* online decoding handle */
+	slb_uint16_t		x,			/* x coordinate of the share */
+	const slb_uint32_t*	share,		/* share [nmb] */
+	slb_uint16_t*		plain		/* [out] plain data [nmb] (written at the k-th share) */
+)
+{
+	const slb_uint_t nmb = (slb_uint_t)online->nmb;
+	slb_uint32_t* c = online->c;
+	slb_uint32_t inv;
+	slb_uint_t i, j, d;
+
+	if ( (online->k == 0U) || (online->k <= online->arrived) ) {
+		return R_SSS_NOT_STARTED;
+	}
+
+	for (j = 0; j < online->n; ++j) {
+		if (online->x[j] == x) {
+			break;
+		}
+	}
+	if (j == online->n) {
+		return R_SSS_INVALID_X;
+	}
+	if (online->done[j]) {
+		return R_SSS_IDENTIC_X;
+	}
+
+	inv = sss_gfp_inv( online->p[j] );
+	online->done[j] = SLB_TRUE;
+	++online->arrived;
+
+	/* k-th share: f(0) = f_S(0) + ( y_j - f_S(x_j) ) * P_S(0) / P_S(x_j) in one pass
+		(the values are cleared by the next start or the close, not to delay the plain data) */
+	if (online->arrived == online->k) {
+		const slb_uint64_t q = SSS_GFP_MUL(inv, online->p0);
+		for (d = 0; d < nmb; ++d) {
+			const slb_uint32_t diff = share[d] + SSS_GFP_PRIME - online->value[j * nmb + d];
+			plain[d] = (slb_uint16_t)sss_gfp_reduce( online->f0[d] + diff * q );
+		}
+		return R_COMPLETE;
+	}
+
+	/* Newton coefficient c_j = ( y_j - f_S(x_j) ) / P_S(x_j), and f(0) */
+	for (d = 0; d < nmb; ++d) {
+		const slb_uint32_t diff = share[d] + SSS_GFP_PRIME - online->value[j * nmb + d];
+		c[d] = sss_gfp_reduce( (slb_uint64_t)diff * inv );
+		online->f0[d] = sss_gfp_reduce( online->f0[d] + (slb_uint64_t)c[d] * online->p0 );
+	}
+
+	/* f_S(x) and P_S(x) of the shares not arrived */
+	for (i = 0; i < online->n; ++i) {
+		if (online->done[i] == SLB_FALSE) {
+			slb_uint32_t* v = &online->value[i * nmb];
+			const slb_uint64_t p = online->p[i];
+			for (d = 0; d < nmb; ++d) {
+				v[d] = sss_gfp_reduce( v[d] + c[d] * p );
+			}
+			online->p[i] = SSS_GFP_MUL( online->p[i], SSS_GFP_SUB(online->x[i], x) );
+		}
+	}
+	online->p0 = SSS_GFP_MUL( online->p0, SSS_GFP_SUB(0U, x) );
+	sss_wipe_class( SSS_WIPE_COEF, c, (slb_uint_t)sizeof(slb_uint32_t) * nmb );
+
+	return R_SUCCESS;
+}
+
+/* Closes online decoding handle */
+void sss_online_close(
+	SSS_ONLINE*			online		/* online decoding handle */
+)
+{
+	void* mem_param = online->mem_param;
+
+	sss_mem_free( mem_param, online->x, ONLINE_SIZE_X(online), SSS_MEM_TABLE, SLB_FALSE );
+	sss_mem_free( mem_param, online->done, ONLINE_SIZE_DONE(online), SSS_MEM_TABLE, SLB_FALSE );
+	sss_mem_free( mem_param, online->p, ONLINE_SIZE_P(online), SSS_MEM_TABLE, SLB_FALSE );
+	sss_wipe_free( mem_param, SSS_WIPE_SHARE, online->value, ONLINE_SIZE_VALUE(online) );
+	sss_wipe_free( mem_param, SSS_WIPE_PLAIN, online->f0, ONLINE_SIZE_DATA(online) );
+	sss_mem_free( mem_param, online->c, ONLINE_SIZE_DATA(online), SSS_MEM_COEF, SLB_TRUE );	/* wiped after each share */
+
+	memset(online, 0, sizeof(*online));
+}
+
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ Online decoding
+ -------------------------------------------------------------------------------
+ Decodes the shares of GF(65537) one by one as they arrive, in the Newton form.
+
+ With the shares S arrived so far, f_S is the polynomial through them, and
+	f_{S+j}(X) = f_S(X) + c_j * P_S(X),		P_S(X) = product of (X - x_i) for i in S,
+	c_j = ( y_j - f_S(x_j) ) / P_S(x_j).
+ The plain data f(0) is accumulated with each share. The values f_S(x) at the
+ x coordinates of the shares not yet arrived are also kept, so that the
+ k-th share needs only one pass over the data, and the plain data is ready
+ just after the last share arrives.
+
+ The x coordinates of all the holders are given at the start, and the shares
+ can arrive in any order.
+ *******************************************************************************/
+#ifndef SSS_ONLINE_H
+#define SSS_ONLINE_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***** Online decoding handle *****/
+typedef struct {
+	slb_uint_t		n_max;			/* maximum number of holders */
+	slb_int_t		nmb_max;		/* maximum number of data */
+	void*			mem_param;		/* parameter for memory management callback */
+
+	slb_uint_t		k;				/* threshold (0: not started) */
+	slb_uint_t		n;				/* number of holders */
+	slb_int_t		nmb;			/* number of data */
+	slb_uint_t		arrived;		/* number of shares arrived */
+	slb_uint32_t	p0;				/* P_S(0) */
+	slb_uint16_t*	x;				/* x coordinates of holders [n_max] */
+	slb_bool_t*		done;			/* =SLB_TRUE: share arrived [n_max] */
+	slb_uint32_t*	p;				/* P_S(x) [n_max] */
+	slb_uint32_t*	value;			/* f_S(x) [n_max * nmb_max] */
+	slb_uint32_t*	f0;				/* f_S(0) [nmb_max] */
+	slb_uint32_t*	c;				/* Newton coefficient [nmb_max] */
+} SSS_ONLINE;
+
+/***** Function *****/
+SLB_RC sss_online_open(
+	SSS_ONLINE*			online,		/* online decoding handle */
+	slb_uint_t			n_max,		/* maximum number of holders */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+SLB_RC sss_online_start(
+	SSS_ONLINE*			online,		/* online decoding handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of holders */
+	const slb_uint16_t	x[],		/* x coordinates of holders */
+	slb_int_t			nmb			/* number of data of a share */
+);
+
+SLB_RC sss_online_add(
+	SSS_ONLINE*			online,		/* online decoding handle */
+	slb_uint16_t		x,			/* x coordinate of the share */
+	const slb_uint32_t*	share,		/* share [nmb] */
+	slb_uint16_t*		plain		/* [out] plain data [nmb] (written at the k-th share) */
+);
+
+void sss_online_close(
+	SSS_ONLINE*			online		/* online decoding handle */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_ONLINE_H */
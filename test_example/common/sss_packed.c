@@ -0,0 +1,143 @@
+/*******************************************************************************
+ Packed secret sharing decoding
+ *******************************************************************************/
+#include "sss_packed.h"
+#include "sss_gfp.h"
+#include "sss_wipe.h"
+#include "sss_mem.h"
+
+#include <string.h>
+
+/* Sizes of the buffers */
+#define PACKED_M_MAX(p)				( (p)->k_max + (p)->l_max - 1U )
+#define PACKED_SIZE_LAMBDA(p)		(slb_uint_t)( sizeof(slb_uint32_t) * (p)->l_max * PACKED_M_MAX(p) )
+#define PACKED_SIZE_WORK(p)			(slb_uint_t)( sizeof(slb_uint32_t) * 4U * PACKED_M_MAX(p) )
+#define PACKED_SIZE_ACC(p)			(slb_uint_t)( sizeof(slb_uint64_t) * (slb_uint_t)(p)->nmb_max )
+
+
+/* Opens packed decoding handle */
+SLB_RC sss_packed_open(
+	SSS_PACKED*			packed,		/* packed decoding handle */
+	slb_uint_t			k_max,		/* maximum privacy threshold */
+	slb_uint_t			l_max,		/* maximum number of plain data of a polynomial */
+	slb_int_t			nmb_max,	/* maximum number of data of a share */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	memset(packed, 0, sizeof(*packed));
+
+	if ( (k_max < SLB_SSS_MIN_PLAYERS) || (l_max == 0U) || (nmb_max <= 0) ||
+		 (slb_sss_get_max_players_decode() < k_max + l_max - 1U) ) {
+		return R_INVALID_PARAM;
+	}
+	packed->k_max = k_max;
+	packed->l_max = l_max;
+	packed->nmb_max = nmb_max;
+	packed->mem_param = mem_param;
+
+	packed->lambda = sss_mem_alloc( mem_param, PACKED_SIZE_LAMBDA(packed), sizeof(slb_uint32_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	packed->work = sss_mem_alloc( mem_param, PACKED_SIZE_WORK(packed), sizeof(slb_uint32_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	packed->acc = sss_mem_alloc( mem_param, PACKED_SIZE_ACC(packed), SSS_MEM_ALIGN, SSS_MEM_PLAIN, SSS_MEM_HANDLE );
+	if ( (packed->lambda == SLB_NULL) || (packed->work == SLB_NULL) || (packed->acc == SLB_NULL) ) {
+		sss_packed_close(packed);
+		return R_LOW_MEMORY;
+	}
+
+	return R_SUCCESS;
+}
+
+/* Starts decoding */
+SLB_RC sss_packed_start(
+	SSS_PACKED*			packed,		/* packed decoding handle */
+	slb_uint_t			k,			/* privacy threshold */
+	slb_uint_t			l,			/* number of plain data of a polynomial */
+	const slb_uint16_t	x[]			/* x coordinates of k + l - 1 shares */
+)
+{
+	SLB_RC rc;
+	slb_uint32_t*const xs = packed->work;
+	slb_uint32_t*const anchor = &packed->work[k + l - 1U];
+	slb_uint_t i, m;
+
+	packed->k = 0;
+
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (packed->k_max < k) || (l == 0U) || (packed->l_max < l) ) {
+		return R_INVALID_PARAM;
+	}
+	m = k + l - 1U;
+
+	/* Check x coordinates */
+	rc = sss_gfp_check_x( m, x, slb_sss_get_max_players_decode() );
+	if ( SLB_R_FAILED(rc) ) {
+		return rc;
+	}
+	for (i = 0; i < m; ++i) {
+		xs[i] = x[i];
+	}
+
+	/* Lagrange coefficients at the anchors 0, -1, ..., -(l-1) */
+	for (i = 0; i < l; ++i) {
+		anchor[i] = ( SSS_GFP_PRIME - i ) % SSS_GFP_PRIME;
+	}
+	sss_gfp_lagrange_rows( m, xs, l, anchor, packed->lambda, &packed->work[2U * m] );
+
+	packed->k = k;
+	packed->l = l;
+	packed->m = m;
+	return R_SUCCESS;
+}
+
+/* Decodes plain data
+	Row j of the plain data is plain[j * nmb] to plain[j * nmb + nmb - 1].
+*/
+SLB_RC sss_packed_decode(
+	SSS_PACKED*			packed,		/* packed decoding handle */
+	slb_int_t			nmb,		/* number of data of a share */
+	const slb_uint32_t**	share,	/* share buffer [k + l - 1] */
+	slb_uint16_t*		plain		/* [out] plain data [l * nmb] */
+)
+{
+	slb_uint64_t* acc = packed->acc;
+	slb_uint_t i, j;
+	slb_int_t d;
+
+	if (packed->k == 0U) {
+		return R_SSS_NOT_STARTED;
+	}
+	if ( (nmb <= 0) || (packed->nmb_max < nmb) ) {
+		return R_INVALID_PARAM;
+	}
+
+	for (j = 0; j < packed->l; ++j) {
+		const slb_uint32_t* lambda = &packed->lambda[j * packed->m];
+
+		memset( acc, 0, sizeof(slb_uint64_t) * (slb_uint_t)nmb );
+		for (i = 0; i < packed->m; ++i) {
+			const slb_uint32_t* y = share[i];
+			const slb_uint64_t c = lambda[i];
+			for (d = 0; d < nmb; ++d) {
+				acc[d] += c * y[d];
+			}
+		}
+		for (d = 0; d < nmb; ++d) {
+			plain[j * (slb_uint_t)nmb + (slb_uint_t)d] = (slb_uint16_t)sss_gfp_reduce(acc[d]);
+		}
+	}
+
+	sss_wipe_class( SSS_WIPE_PLAIN, acc, (slb_uint_t)( sizeof(slb_uint64_t) * (slb_uint_t)nmb ) );
+
+	return R_SUCCESS;
+}
+
+/* Closes packed decoding handle */
+void sss_packed_close(
+	SSS_PACKED*			packed		/* packed decoding handle */
+)
+{
+	sss_mem_free( packed->mem_param, packed->lambda, PACKED_SIZE_LAMBDA(packed), SSS_MEM_TABLE, SLB_FALSE );
+	sss_mem_free( packed->mem_param, packed->work, PACKED_SIZE_WORK(packed), SSS_MEM_TABLE, SLB_FALSE );
+	sss_mem_free( packed->mem_param, packed->acc, PACKED_SIZE_ACC(packed), SSS_MEM_PLAIN, SLB_TRUE );	/* wiped after each decoding */
+
+	memset(packed, 0, sizeof(*packed));
+}
+
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ Packed secret sharing decoding
+ -------------------------------------------------------------------------------
+ Decodes the shares of packed secret sharing (see sss_plan_build_packed).
+ Each share carries nmb values, and k + l - 1 shares give l * nmb plain data.
+
+ The plain data at the anchor -j is the sum of lambda[j][i] * share[i],
+ where lambda[j] are the Lagrange coefficients at -j of the x coordinates.
+ *******************************************************************************/
+#ifndef SSS_PACKED_H
+#define SSS_PACKED_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***** Packed decoding handle *****/
+typedef struct {
+	slb_uint_t		k_max;			/* maximum privacy threshold */
+	slb_uint_t		l_max;			/* maximum number of plain data of a polynomial */
+	slb_int_t		nmb_max;		/* maximum number of data of a share */
+	void*			mem_param;		/* parameter for memory management callback */
+
+	slb_uint_t		k;				/* privacy threshold (0: not started) */
+	slb_uint_t		l;				/* number of plain data of a polynomial */
+	slb_uint_t		m;				/* number of shares to decode (k + l - 1) */
+	slb_uint32_t*	lambda;			/* Lagrange coefficients at the anchors [l_max * m_max] */
+	slb_uint32_t*	work;			/* work area [4 * m_max] */
+	slb_uint64_t*	acc;			/* accumulator [nmb_max] */
+} SSS_PACKED;
+
+/***** Function *****/
+SLB_RC sss_packed_open(
+	SSS_PACKED*			packed,		/* packed decoding handle */
+	slb_uint_t			k_max,		/* maximum privacy threshold */
+	slb_uint_t			l_max,		/* maximum number of plain data of a polynomial */
+	slb_int_t			nmb_max,	/* maximum number of data of a share */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+SLB_RC sss_packed_start(
+	SSS_PACKED*			packed,		/* packed decoding handle */
+	slb_uint_t			k,			/* privacy threshold */
+	slb_uint_t			l,			/* number of plain data of a polynomial */
+	const slb_uint16_t	x[]			/* x coordinates of k + l - 1 shares */
+);
+
+SLB_RC sss_packed_decode(
+	SSS_PACKED*			packed,		/* packed decoding handle */
+	slb_int_t			nmb,		/* number of data of a share */
+	const slb_uint32_t**	share,	/* share buffer [k + l - 1] */
+	slb_uint16_t*		plain		/* [out] plain data [l * nmb] */
+);
+
+void sss_packed_close(
+	SSS_PACKED*			packed		/* packed decoding handle */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_PACKED_H */
@@ -0,0 +1,230 @@
+/*******************************************************************************
+ Partial reconstruction
+ *******************************************************************************/
+#include "sss_partial.h"
+#include "sss_gfp.h"
+#include "cpuinfo.h"
+
+#include <immintrin.h>
+
+static void partial_scale(slb_int_t nmb, const slb_uint32_t* share, slb_uint32_t lambda, slb_uint32_t* partial);
+static slb_int_t partial_scale_avx2(slb_int_t nmb, const slb_uint32_t* share, slb_uint32_t lambda, slb_uint32_t* partial);
+static slb_int_t partial_scale_avx512(slb_int_t nmb, const slb_uint32_t* share, slb_uint32_t lambda, slb_uint32_t* partial);
+static slb_int_t partial_add_avx2(slb_int_t nmb, slb_uint32_t* acc, const slb_uint32_t* partial);
+static slb_int_t partial_add_avx512(slb_int_t nmb, slb_uint32_t* acc, const slb_uint32_t* partial);
+
+static slb_bool_t s_avx2 = SLB_FALSE;
+static slb_bool_t s_avx512 = SLB_FALSE;
+
+/* Sets SIMD to be used */
+void sss_partial_set_simd(
+	slb_bool_t			avx2,		/* =SLB_TRUE: AVX2 is used */
+	slb_bool_t			avx512		/* =SLB_TRUE: AVX-512 is used */
+)
+{
+	s_avx2 = avx2;
+	s_avx512 = avx512;
+}
+
+/* Exports Lagrange coefficients at 0
+	The coefficients are the same as slb_sss_start_decode with these x coordinates.
+*/
+SLB_RC sss_partial_coef(
+	slb_uint_t			k,			/* threshold */
+	const slb_uint16_t	x[],		/* x coordinates of the chosen k shares */
+	slb_uint32_t		lambda[],	/* [out] Lagrange coefficients at 0 [k] */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	slb_uint32_t* xs;
+	SLB_RC rc;
+	const slb_uint32_t zero = 0U;
+	slb_uint_t i;
+
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (slb_sss_get_max_players_decode() < k) ) {
+		return R_INVALID_PARAM;
+	}
+
+	/* Check x coordinates */
+	rc = sss_gfp_check_x( k, x, slb_sss_get_max_players_decode() );
+	if ( SLB_R_FAILED(rc) ) {
+		return rc;
+	}
+
+	/* x coordinates [k], and the work area of sss_gfp_lagrange_rows [2 * k] */
+	xs = slb_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint32_t) * 3U * k ) );
+	if (xs == SLB_NULL) {
+		return R_LOW_MEMORY;
+	}
+	for (i = 0; i < k; ++i) {
+		xs[i] = x[i];
+	}
+	sss_gfp_lagrange_rows( k, xs, 1U, &zero, lambda, &xs[k] );
+
+	slb_free( mem_param, xs, SLB_FALSE );
+	return R_SUCCESS;
+}
+
+/* Scales share by Lagrange coefficient (holder side) */
+void sss_partial_scale(
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint32_t*	share,		/* share */
+	slb_uint32_t		lambda,		/* Lagrange coefficient of the share */
+	slb_uint32_t*		partial		/* [out] partial */
+)
+{
+	slb_int_t d = 0;
+
+	if (s_avx512) {
+		d = partial_scale_avx512( nmb, share, lambda, partial );
+	}
+	else if (s_avx2) {
+		d = partial_scale_avx2( nmb, share, lambda, partial );
+	}
+	partial_scale( nmb - d, &share[d], lambda, &partial[d] );
+}
+
+/* Adds partial (node of the reduction tree) */
+void sss_partial_add(
+	slb_int_t			nmb,		/* number of data */
+	slb_uint32_t*		acc,		/* [in/out] partial to add to */
+	const slb_uint32_t*	partial		/* partial */
+)
+{
+	slb_int_t d = 0;
+
+	if (s_avx512) {
+		d = partial_add_avx512( nmb, acc, partial );
+	}
+	else if (s_avx2) {
+		d = partial_add_avx2( nmb, acc, partial );
+	}
+	for (; d < nmb; ++d) {
+		const slb_uint32_t s = acc[d] + partial[d];
+		acc[d] = ( s < SSS_GFP_PRIME ) ? s : s - SSS_GFP_PRIME;
+	}
+}
+
+/* Converts the sum of the partials to plain data */
+void sss_partial_to_plain(
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint32_t*	sum,		/* sum of all the partials */
+	slb_uint16_t*		plain		/* [out] plain data */
+)
+{
+	slb_int_t d;
+
+	for (d = 0; d < nmb; ++d) {
+		plain[d] = (slb_uint16_t)sum[d];
+	}
+}
+
+/* Scale (no SIMD) */
+static void partial_scale(slb_int_t nmb, const slb_uint32_t* share, slb_uint32_t lambda, slb_uint32_t* partial)
+{
+	slb_int_t d;
+
+	for (d = 0; d < nmb; ++d) {
+		partial[d] = SSS_GFP_MUL( share[d], lambda );
+	}
+}
+
+/* Scale (AVX2, 8 data)
+	The products (2^32 at most) of the even and the odd lanes are folded as
+	lo - mid + hi + p (2^16 = -1) in 2 to 2p - 2, and p is subtracted once by min_epu32.
+	Returns the number of data processed.
+*/
+SIMD_TARGET("avx2")
+static slb_int_t partial_scale_avx2(slb_int_t nmb, const slb_uint32_t* share, slb_uint32_t lambda, slb_uint32_t* partial)
+{
+	const __m256i vc = _mm256_set1_epi64x( (long long)lambda );
+	const __m256i vp = _mm256_set1_epi32( (int)SSS_GFP_PRIME );
+	const __m256i vp64 = _mm256_set1_epi64x( (long long)SSS_GFP_PRIME );
+	const __m256i m16 = _mm256_set1_epi64x( 0xffff );
+	__m256i v, e, o, r;
+	slb_int_t d;
+
+	for (d = 0; d + 8 <= nmb; d += 8) {
+		v = _mm256_loadu_si256( (const __m256i*)&share[d] );
+		e = _mm256_mul_epu32( v, vc );
+		o = _mm256_mul_epu32( _mm256_srli_epi64(v, 32), vc );
+
+		e = _mm256_sub_epi64( _mm256_add_epi64( _mm256_add_epi64( _mm256_and_si256(e, m16), _mm256_srli_epi64(e, 32) ), vp64 ),
+							  _mm256_and_si256( _mm256_srli_epi64(e, 16), m16 ) );
+		o = _mm256_sub_epi64( _mm256_add_epi64( _mm256_add_epi64( _mm256_and_si256(o, m16), _mm256_srli_epi64(o, 32) ), vp64 ),
+							  _mm256_and_si256( _mm256_srli_epi64(o, 16), m16 ) );
+		r = _mm256_or_si256( e, _mm256_slli_epi64(o, 32) );
+
+		r = _mm256_min_epu32( r, _mm256_sub_epi32(r, vp) );
+		_mm256_storeu_si256( (__m256i*)&partial[d], r );
+	}
+	return d;
+}
+
+/* Scale (AVX-512, 16 data)
+	Returns the number of data processed.
+*/
+SIMD_TARGET("avx512f")
+static slb_int_t partial_scale_avx512(slb_int_t nmb, const slb_uint32_t* share, slb_uint32_t lambda, slb_uint32_t* partial)
+{
+	const __m512i vc = _mm512_set1_epi64( (long long)lambda );
+	const __m512i vp = _mm512_set1_epi32( (int)SSS_GFP_PRIME );
+	const __m512i vp64 = _mm512_set1_epi64( (long long)SSS_GFP_PRIME );
+	const __m512i m16 = _mm512_set1_epi64( 0xffff );
+	__m512i v, e, o, r;
+	slb_int_t d;
+
+	for (d = 0; d + 16 <= nmb; d += 16) {
+		v = _mm512_loadu_si512( (const void*)&share[d] );
+		e = _mm512_mul_epu32( v, vc );
+		o = _mm512_mul_epu32( _mm512_srli_epi64(v, 32), vc );
+
+		e = _mm512_sub_epi64( _mm512_add_epi64( _mm512_add_epi64( _mm512_and_si512(e, m16), _mm512_srli_epi64(e, 32) ), vp64 ),
+							  _mm512_and_si512( _mm512_srli_epi64(e, 16), m16 ) );
+		o = _mm512_sub_epi64( _mm512_add_epi64( _mm512_add_epi64( _mm512_and_si512(o, m16), _mm512_srli_epi64(o, 32) ), vp64 ),
+							  _mm512_and_si512( _mm512_srli_epi64(o, 16), m16 ) );
+		r = _mm512_or_si512( e, _mm512_slli_epi64(o, 32) );
+
+		r = _mm512_min_epu32( r, _mm512_sub_epi32(r, vp) );
+		_mm512_storeu_si512( (void*)&partial[d], r );
+	}
+	return d;
+}
+
+/* Add (AVX2, 8 data)
+	Returns the number of data processed.
+*/
+SIMD_TARGET("avx2")
+static slb_int_t partial_add_avx2(slb_int_t nmb, slb_uint32_t* acc, const slb_uint32_t* partial)
+{
+	const __m256i vp = _mm256_set1_epi32( (int)SSS_GFP_PRIME );
+	__m256i s;
+	slb_int_t d;
+
+	for (d = 0; d + 8 <= nmb; d += 8) {
+		s = _mm256_add_epi32( _mm256_loadu_si256( (const __m256i*)&acc[d] ),
+							  _mm256_loadu_si256( (const __m256i*)&partial[d] ) );
+		s = _mm256_min_epu32( s, _mm256_sub_epi32(s, vp) );
+		_mm256_storeu_si256( (__m256i*)&acc[d], s );
+	}
+	return d;
+}
+
+/* Add (AVX-512, 16 data)
+	Returns the number of data processed.
+*/
+SIMD_TARGET("avx512f")
+static slb_int_t partial_add_avx512(slb_int_t nmb, slb_uint32_t* acc, const slb_uint32_t* partial)
+{
+	const __m512i vp = _mm512_set1_epi32( (int)SSS_GFP_PRIME );
+	__m512i s;
+	slb_int_t d;
+
+	for (d = 0; d + 16 <= nmb; d += 16) {
+		s = _mm512_add_epi32( _mm512_loadu_si512( (const void*)&acc[d] ),
+							  _mm512_loadu_si512( (const void*)&partial[d] ) );
+		s = _mm512_min_epu32( s, _mm512_sub_epi32(s, vp) );
+		_mm512_storeu_si512( (void*)&acc[d], s );
+	}
+	return d;
+}
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ Partial reconstruction
+ -------------------------------------------------------------------------------
+ Decodes the shares of GF(65537) distributed over the holders.
+	plain = lambda[0] * share[0] + ... + lambda[k-1] * share[k-1]
+ The aggregator exports the Lagrange coefficient lambda[i] at 0 for the chosen
+ x coordinates, and each holder computes its partial lambda[i] * share[i]
+ (sss_partial_scale). The partials are summed pairwise in a reduction tree
+ (sss_partial_add), so that each node adds only two vectors.
+
+ The partials are reduced values (0 to 65536), in the same format as the shares.
+ *******************************************************************************/
+#ifndef SSS_PARTIAL_H
+#define SSS_PARTIAL_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***** Function *****/
+void sss_partial_set_simd(
+	slb_bool_t			avx2,		/* =SLB_TRUE: AVX2 is used */
+	slb_bool_t			avx512		/* =SLB_TRUE: AVX-512 is used */
+);
+
+SLB_RC sss_partial_coef(
+	slb_uint_t			k,			/* threshold */
+	const slb_uint16_t	x[],		/* x coordinates of the chosen k shares */
+	slb_uint32_t		lambda[],	/* [out] Lagrange coefficients at 0 [k] */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+void sss_partial_scale(
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint32_t*	share,		/* share */
+	slb_uint32_t		lambda,		/* Lagrange coefficient of the share */
+	slb_uint32_t*		partial		/* [out] partial */
+);
+
+void sss_partial_add(
+	slb_int_t			nmb,		/* number of data */
+	slb_uint32_t*		acc,		/* [in/out] partial to add to */
+	const slb_uint32_t*	partial		/* partial */
+);
+
+void sss_partial_to_plain(
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint32_t*	sum,		/* sum of all the partials */
+	slb_uint16_t*		plain		/* [out] plain data */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_PARTIAL_H */
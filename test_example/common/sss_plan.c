@@ -0,0 +1,205 @@
+/*******************************************************************************
+ Encode plan
+ *******************************************************************************/
+#include "sss_plan.h"
+#include "sss_gfp.h"
+#include "sss_mem.h"
+
+#include <string.h>
+
+static SLB_RC plan_alloc(SSS_ENCODE_PLAN* plan, slb_uint_t k, slb_uint_t l, slb_uint_t n,
+						 const slb_uint16_t x[], void* mem_param);
+
+/* Builds encode plan
+	The x coordinates are in the range of slb_sss_decode, and must be distinct.
+*/
+SLB_RC sss_plan_build(
+	SSS_ENCODE_PLAN*	plan,		/* [out] encode plan */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	const slb_uint16_t	x[],		/* x coordinates */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	slb_uint_t i, j;
+	slb_uint32_t v;
+	const SLB_RC rc = plan_alloc( plan, k, 1U, n, x, mem_param );
+
+	if ( SLB_R_FAILED(rc) ) {
+		return rc;
+	}
+
+	for (i = 0; i < n; ++i) {
+		v = 1U;
+		for (j = 0; j < k; ++j) {
+			plan->mat[i * k + j] = v;
+			v = SSS_GFP_MUL(v, x[i]);
+		}
+	}
+
+	return R_SUCCESS;
+}
+
+/* Builds encode plan of packed secret sharing
+	The x coordinates are in the range of slb_sss_decode, and must be distinct.
+	The anchors are above the range, so they are not used as x coordinates.
+*/
+SLB_RC sss_plan_build_packed(
+	SSS_ENCODE_PLAN*	plan,		/* [out] encode plan */
+	slb_uint_t			k,			/* privacy threshold (k - 1 shares give no information) */
+	slb_uint_t			l,			/* number of plain data of a polynomial */
+	slb_uint_t			n,			/* number of shares (k + l - 1 or more) */
+	const slb_uint16_t	x[],		/* x coordinates */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	slb_uint32_t* anchor;
+	slb_uint32_t* xs;
+	slb_uint_t c, i, m;
+	SLB_RC rc;
+
+	if (l == 0U) {
+		return R_INVALID_PARAM;
+	}
+	rc = plan_alloc( plan, k, l, n, x, mem_param );
+	if ( SLB_R_FAILED(rc) ) {
+		return rc;
+	}
+	m = plan->m;
+
+	/* Work area: anchors [m], x coordinates [n], and sss_gfp_lagrange_rows [2 * m] */
+	anchor = slb_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint32_t) * ( 3U * m + n ) ) );
+	if (anchor == SLB_NULL) {
+		sss_plan_free(plan);
+		return R_LOW_MEMORY;
+	}
+	xs = &anchor[m];
+
+	for (c = 0; c < m; ++c) {
+		anchor[c] = ( SSS_GFP_PRIME - c ) % SSS_GFP_PRIME;
+	}
+	for (i = 0; i < n; ++i) {
+		xs[i] = x[i];
+	}
+	sss_gfp_lagrange_rows( m, anchor, n, xs, plan->mat, &xs[n] );
+
+	slb_free( mem_param, anchor, SLB_FALSE );
+	return R_SUCCESS;
+}
+
+/* Builds encode plan of several policies
+	The x coordinates of each policy are in the range of slb_sss_decode, and must be distinct.
+*/
+SLB_RC sss_plan_build_multi(
+	SSS_ENCODE_PLAN*	plan,		/* [out] encode plan */
+	slb_uint_t			npolicy,	/* number of policies */
+	const slb_uint_t	k[],		/* threshold of each policy */
+	const slb_uint_t	n[],		/* number of shares of each policy */
+	const slb_uint16_t*	const x[],	/* x coordinates of each policy */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	slb_uint_t p, i, j, m = 0, nt = 0, c0, s;
+	slb_uint32_t v;
+	SLB_RC rc;
+
+	memset(plan, 0, sizeof(*plan));
+
+	if (npolicy == 0U) {
+		return R_INVALID_PARAM;
+	}
+	for (p = 0; p < npolicy; ++p) {
+		if ( (k[p] < SLB_SSS_MIN_PLAYERS) || (n[p] < k[p]) || (slb_sss_get_max_players_decode() < n[p]) ) {
+			return R_INVALID_PARAM;
+		}
+		rc = sss_gfp_check_x( n[p], x[p], slb_sss_get_max_players_decode() );
+		if ( SLB_R_FAILED(rc) ) {
+			return rc;
+		}
+		m += k[p];
+		nt += n[p];
+	}
+
+	plan->mem_param = mem_param;
+	plan->npolicy = npolicy;
+	plan->m = m;
+	plan->n = nt;
+	plan->x = sss_mem_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint16_t) * nt ), sizeof(slb_uint16_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	plan->mat = sss_mem_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint32_t) * nt * m ), SSS_MEM_ALIGN, SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	plan->span = sss_mem_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint_t) * ( 2U * nt + npolicy ) ), sizeof(slb_uint_t),
+								SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	if ( (plan->x == SLB_NULL) || (plan->mat == SLB_NULL) || (plan->span == SLB_NULL) ) {
+		sss_plan_free(plan);
+		return R_LOW_MEMORY;
+	}
+	memset( plan->mat, 0, sizeof(slb_uint32_t) * nt * m );
+
+	/* Vandermonde rows over the columns of each policy */
+	c0 = 0;
+	s = 0;
+	for (p = 0; p < npolicy; ++p) {
+		plan->span[2U * nt + p] = c0;
+		for (i = 0; i < n[p]; ++i, ++s) {
+			plan->x[s] = x[p][i];
+			plan->span[2U * s] = c0;
+			plan->span[2U * s + 1U] = c0 + k[p];
+			v = 1U;
+			for (j = 0; j < k[p]; ++j) {
+				plan->mat[s * m + c0 + j] = v;
+				v = SSS_GFP_MUL(v, x[p][i]);
+			}
+		}
+		c0 += k[p];
+	}
+	plan->k = m;
+	plan->l = 1U;
+	return R_SUCCESS;
+}
+
+/* Frees encode plan
+	No handle may use the plan after this.
+*/
+void sss_plan_free(
+	SSS_ENCODE_PLAN*	plan		/* encode plan */
+)
+{
+	sss_mem_free( plan->mem_param, plan->x, (slb_uint_t)( sizeof(slb_uint16_t) * plan->n ), SSS_MEM_TABLE, SLB_FALSE );
+	sss_mem_free( plan->mem_param, plan->mat, (slb_uint_t)( sizeof(slb_uint32_t) * plan->n * plan->m ), SSS_MEM_TABLE, SLB_FALSE );
+	sss_mem_free( plan->mem_param, plan->span, (slb_uint_t)( sizeof(slb_uint_t) * ( 2U * plan->n + plan->npolicy ) ),
+				  SSS_MEM_TABLE, SLB_FALSE );
+
+	memset(plan, 0, sizeof(*plan));
+}
+
+/* Checks the parameters and allocates the plan */
+static SLB_RC plan_alloc(SSS_ENCODE_PLAN* plan, slb_uint_t k, slb_uint_t l, slb_uint_t n,
+						 const slb_uint16_t x[], void* mem_param)
+{
+	const slb_uint_t m = k + l - 1U;
+	SLB_RC rc;
+
+	memset(plan, 0, sizeof(*plan));
+
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (n < m) || (slb_sss_get_max_players_decode() < n) ) {
+		return R_INVALID_PARAM;
+	}
+	rc = sss_gfp_check_x( n, x, slb_sss_get_max_players_decode() );
+	if ( SLB_R_FAILED(rc) ) {
+		return rc;
+	}
+
+	plan->mem_param = mem_param;
+	plan->m = m;
+	plan->n = n;
+	plan->x = sss_mem_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint16_t) * n ), sizeof(slb_uint16_t), SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	plan->mat = sss_mem_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint32_t) * n * m ), SSS_MEM_ALIGN, SSS_MEM_TABLE, SSS_MEM_HANDLE );
+	if ( (plan->x == SLB_NULL) || (plan->mat == SLB_NULL) ) {
+		sss_plan_free(plan);
+		return R_LOW_MEMORY;
+	}
+
+	memcpy( plan->x, x, sizeof(slb_uint16_t) * n );
+	plan->k = k;
+	plan->l = l;
+	return R_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ Encode plan
+ -------------------------------------------------------------------------------
+ Holds the tables that depend only on the x coordinates and the parameters:
+ the validated x coordinates and the encoding matrix over GF(65537).
+
+ The plan is built once and is not changed until it is freed, so any number of
+ encoding handles and threads can share it. Each encoding handle then keeps only
+ the random state of each secret (see sss_gemm_start_plan).
+
+ Plan of sss_plan_build:
+	The matrix is the Vandermonde matrix M[i][j] = x[i]^j (k columns), and the
+	shares are compatible with slb_sss_decode.
+
+ Plan of sss_plan_build_packed (packed secret sharing):
+	One polynomial of degree k + l - 2 carries l plain data at the anchors
+	0, -1, ..., -(l-1), and k - 1 random values at the anchors -l, ..., -(k+l-2).
+	M[i][c] is the Lagrange coefficient of anchor c at x[i] (k + l - 1 columns).
+	Each share is 1/l of the plain data. Any k - 1 shares give no information,
+	and k + l - 1 shares reconstruct the plain data (see sss_packed.h).
+	Since the plain data at 0 is encoded as before, slb_sss_decode with the
+	threshold k + l - 1 reconstructs the first row of the plain data.
+
+ Plan of sss_plan_build_multi (several policies of (k, n) in one pass):
+	Policy p has its own polynomial of k[p] columns (the plain data and k[p] - 1
+	random values), and its n[p] shares are the Vandermonde rows of x[p] over
+	those columns, compatible with slb_sss_decode of the threshold k[p].
+	The columns are the concatenation of the policies (m = k[0] + k[1] + ...),
+	and the shares are the concatenation of the policies (n = n[0] + n[1] + ...).
+	The other columns of a share are 0, and span gives the nonzero columns, so
+	that the encoding skips them. The x coordinates are distinct in a policy.
+ *******************************************************************************/
+#ifndef SSS_PLAN_H
+#define SSS_PLAN_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***** Encode plan *****/
+typedef struct {
+	slb_uint_t		k;				/* threshold */
+	slb_uint_t		l;				/* number of plain data of a polynomial (1: not packed) */
+	slb_uint_t		m;				/* number of columns of the matrix (k + l - 1) */
+	slb_uint_t		n;				/* number of shares */
+	void*			mem_param;		/* parameter for memory management callback */
+	slb_uint16_t*	x;				/* x coordinates [n] */
+	slb_uint32_t*	mat;			/* encoding matrix [n * m] */
+	slb_uint_t		npolicy;		/* number of policies (0: not multi-policy) */
+	slb_uint_t*		span;			/* multi-policy: columns span[2i] to span[2i+1] - 1 of share i are nonzero,
+									   and span[2n + p] is the first column of policy p [2n + npolicy] */
+} SSS_ENCODE_PLAN;
+
+/***** Function *****/
+SLB_RC sss_plan_build(
+	SSS_ENCODE_PLAN*	plan,		/* [out] encode plan */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	const slb_uint16_t	x[],		/* x coordinates */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+SLB_RC sss_plan_build_packed(
+	SSS_ENCODE_PLAN*	plan,		/* [out] encode plan */
+	slb_uint_t			k,			/* privacy threshold (k - 1 shares give no information) */
+	slb_uint_t			l,			/* number of plain data of a polynomial */
+	slb_uint_t			n,			/* number of shares (k + l - 1 or more) */
+	const slb_uint16_t	x[],		/* x coordinates */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+SLB_RC sss_plan_build_multi(
+	SSS_ENCODE_PLAN*	plan,		/* [out] encode plan */
+	slb_uint_t			npolicy,	/* number of policies */
+	const slb_uint_t	k[],		/* threshold of each policy */
+	const slb_uint_t	n[],		/* number of shares of each policy */
+	const slb_uint16_t*	const x[],	/* x coordinates of each policy */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+void sss_plan_free(
+	SSS_ENCODE_PLAN*	plan		/* encode plan */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_PLAN_H */
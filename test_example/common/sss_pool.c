@@ -0,0 +1,514 @@
+/*******************************************************************************
+ Pool allocator
+ *******************************************************************************/
+#include "sss_pool.h"
+#include "sss_wipe.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#	include <windows.h>
+#	define POOL_TLS				__declspec(thread)
+#	define POOL_LOCK()			AcquireSRWLockExclusive(&s_lock)
+#	define POOL_UNLOCK()		ReleaseSRWLockExclusive(&s_lock)
+#	define POOL_GEN()			( (slb_uint_t)InterlockedCompareExchange(&s_gen, 0, 0) )
+#else
+#	include <sys/mman.h>
+#	include <pthread.h>
+#	define POOL_TLS				__thread
+#	define POOL_LOCK()			pthread_mutex_lock(&s_lock)
+#	define POOL_UNLOCK()		pthread_mutex_unlock(&s_lock)
+#	define POOL_GEN()			( (slb_uint_t)__atomic_load_n(&s_gen, __ATOMIC_ACQUIRE) )
+#endif
+
+#define POOL_MIN_SHIFT		6U								/* Shift of the minimum block (64 bytes) */
+#define POOL_CLASSES		( ( 26U - POOL_MIN_SHIFT ) * 4U + 1U )	/* Classes up to SSS_POOL_MAX_BLOCK (2^26) */
+#define POOL_CACHE_CLASSES	( ( 16U - POOL_MIN_SHIFT ) * 4U + 1U )	/* Classes up to SSS_POOL_CACHE_MAX (2^16) */
+#define POOL_PAGE			4096U							/* Page size of a block mapped directly */
+
+/***** Free block *****/
+typedef struct POOL_BLOCK_ {
+	struct POOL_BLOCK_*	next;		/* next block of the class */
+} POOL_BLOCK;
+
+/***** Region mapped from the system *****/
+typedef struct POOL_REGION_ {
+	void*				base;		/* base address */
+	size_t				size;		/* size in bytes */
+	slb_bool_t			locked;		/* =SLB_TRUE: locked */
+	slb_bool_t			huge;		/* =SLB_TRUE: huge pages */
+	struct POOL_REGION_*	next;	/* next region */
+} POOL_REGION;
+
+static slb_uint_t pool_class(size_t size);
+static size_t pool_class_size(slb_uint_t c);
+static POOL_BLOCK* pool_take(slb_uint_t c);
+static POOL_BLOCK* pool_carve(slb_uint_t c, POOL_REGION* region);
+static POOL_REGION* pool_region(size_t size);
+static void* pool_map(size_t size, slb_bool_t* locked, slb_bool_t* huge);
+static void pool_unmap(void* mem, size_t size);
+static void pool_sync_cache(void);
+static void pool_flush_cache(void);
+
+#if defined(_MSC_VER)
+static SRWLOCK s_lock = SRWLOCK_INIT;			/* lock of the global lists */
+static volatile LONG s_gen = 1;					/* generation (incremented by release) */
+static INIT_ONCE s_once = INIT_ONCE_STATIC_INIT;
+static DWORD s_exit = FLS_OUT_OF_INDEXES;		/* fiber local storage to flush the cache at the thread exit */
+static BOOL CALLBACK pool_exit_init(PINIT_ONCE once, PVOID param, PVOID* context);
+static VOID WINAPI pool_exit(PVOID param);
+#else
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static int s_gen = 1;
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+static pthread_key_t s_exit;					/* key to flush the cache at the thread exit */
+static void pool_exit_init(void);
+static void pool_exit(void* param);
+#endif
+static slb_uint_t s_flags = 0U;					/* options of the regions */
+static POOL_BLOCK* s_list[POOL_CLASSES];		/* free blocks of each class */
+static POOL_REGION* s_regions = SLB_NULL;		/* regions mapped */
+static slb_uint8_t* s_bump = SLB_NULL;			/* unused part of the current arena */
+static size_t s_bump_left = 0;					/* size of the unused part */
+static SSS_POOL_STAT s_stat;					/* statistics */
+
+static POOL_TLS slb_uint_t t_gen = 0U;							/* generation of the cache */
+static POOL_TLS slb_bool_t t_exit = SLB_FALSE;					/* =SLB_TRUE: flushed at the thread exit */
+static POOL_TLS POOL_BLOCK* t_cache[POOL_CACHE_CLASSES];		/* cached blocks of this thread */
+static POOL_TLS slb_uint_t t_count[POOL_CACHE_CLASSES];			/* number of the cached blocks */
+
+/* Initializes pool (the options are applied to the regions mapped after this) */
+void sss_pool_init(
+	slb_uint_t			flags		/* SSS_POOL_LOCK, SSS_POOL_HUGE */
+)
+{
+	POOL_LOCK();
+	s_flags = flags;
+	POOL_UNLOCK();
+}
+
+/* Allocates memory (SLB_ALLOC) */
+void* sss_pool_alloc(
+	void*				param,		/* parameter for memory management callback (not used) */
+	slb_uint_t			size		/* size in bytes */
+)
+{
+	POOL_BLOCK* block;
+	POOL_REGION* region;
+	size_t class_size;
+	slb_uint_t c;
+	slb_bool_t locked, huge;
+
+	(void)param;
+
+	if (SSS_POOL_MAX_BLOCK < size) {
+		void* mem = pool_map( ( (size_t)size + POOL_PAGE - 1U ) & ~(size_t)( POOL_PAGE - 1U ), &locked, &huge );
+		POOL_LOCK();
+		s_stat.system_calls += locked ? 2U : 1U;
+		POOL_UNLOCK();
+		return mem;
+	}
+
+	c = pool_class(size);
+
+	/* Cache of this thread */
+	if (c < POOL_CACHE_CLASSES) {
+		pool_sync_cache();
+		block = t_cache[c];
+		if (block != SLB_NULL) {
+			t_cache[c] = block->next;
+			--t_count[c];
+			return block;
+		}
+	}
+
+	/* Global list, or the current arena */
+	POOL_LOCK();
+	block = pool_take(c);
+	POOL_UNLOCK();
+	if (block != SLB_NULL) {
+		return block;
+	}
+
+	/* New region (mapped out of the lock, and added to the lists after it) */
+	class_size = pool_class_size(c);
+	region = pool_region( ( SSS_POOL_ARENA / 2U < class_size ) ? ( class_size + SSS_POOL_ARENA - 1U ) & ~(size_t)( SSS_POOL_ARENA - 1U )
+																: SSS_POOL_ARENA );
+	if (region == SLB_NULL) {
+		return SLB_NULL;
+	}
+	POOL_LOCK();
+	block = pool_carve(c, region);
+	POOL_UNLOCK();
+
+	return block;
+}
+
+/* Frees memory (SLB_FREE)
+	The memory is kept in the pool. Memory not cleared by the caller (the cleared flag of SLB_FREE)
+	is wiped here, so that the pool keeps no data of the freed blocks.
+*/
+void sss_pool_free(
+	void*				param,		/* parameter for memory management callback (not used) */
+	void*				mem,		/* memory */
+	slb_uint_t			size,		/* size in bytes */
+	slb_bool_t			cleared		/* =SLB_TRUE: memory is cleared */
+)
+{
+	POOL_BLOCK* block = (POOL_BLOCK*)mem;
+	POOL_BLOCK* flush = SLB_NULL;
+	POOL_BLOCK* last = SLB_NULL;
+	slb_uint_t c, i;
+
+	(void)param;
+
+	if (mem == SLB_NULL) {
+		return;
+	}
+	if (SSS_POOL_MAX_BLOCK < size) {
+		pool_unmap( mem, ( (size_t)size + POOL_PAGE - 1U ) & ~(size_t)( POOL_PAGE - 1U ) );
+		POOL_LOCK();
+		++s_stat.system_calls;
+		POOL_UNLOCK();
+		return;
+	}
+
+	/* The block is kept with no data (cleared by the caller, or wiped here) */
+	if (cleared == SLB_FALSE) {
+		sss_wipe( mem, size );
+	}
+
+	c = pool_class(size);
+
+	/* Cache of this thread (half of a full cache is returned to the global list) */
+	if (c < POOL_CACHE_CLASSES) {
+		pool_sync_cache();
+		block->next = t_cache[c];
+		t_cache[c] = block;
+		if (++t_count[c] <= SSS_POOL_CACHE) {
+			return;
+		}
+		flush = t_cache[c];
+		for (i = 0; i < SSS_POOL_CACHE / 2U; ++i) {
+			last = ( last == SLB_NULL ) ? flush : last->next;
+		}
+		t_cache[c] = last->next;
+		t_count[c] -= SSS_POOL_CACHE / 2U;
+		block = flush;
+	}
+	else {
+		last = block;
+	}
+
+	POOL_LOCK();
+	last->next = s_list[c];
+	s_list[c] = block;
+	POOL_UNLOCK();
+}
+
+/* Gets statistics */
+void sss_pool_get_stat(
+	SSS_POOL_STAT*		stat		/* [out] statistics */
+)
+{
+	POOL_LOCK();
+	*stat = s_stat;
+	POOL_UNLOCK();
+}
+
+/* Releases all regions to the system
+	All blocks must be freed. The caches of the threads are discarded by the generation.
+*/
+void sss_pool_release(void)
+{
+	POOL_REGION* region;
+	POOL_REGION* regions;
+
+	POOL_LOCK();
+	regions = s_regions;
+	s_regions = SLB_NULL;
+	memset( s_list, 0, sizeof(s_list) );
+	memset( &s_stat, 0, sizeof(s_stat) );
+	s_bump = SLB_NULL;
+	s_bump_left = 0;
+#if defined(_MSC_VER)
+	InterlockedIncrement(&s_gen);
+#else
+	__atomic_add_fetch(&s_gen, 1, __ATOMIC_RELEASE);
+#endif
+	POOL_UNLOCK();
+
+	/* Unmap out of the lock */
+	while (regions != SLB_NULL) {
+		region = regions;
+		regions = region->next;
+		pool_unmap( region->base, region->size );
+		free(region);
+	}
+}
+
+/* Class of the size
+	The size of (2^e, 2^(e+1)] is rounded up to 2^e * (1 + q/4), and the class is (e - 6) * 4 + q.
+*/
+static slb_uint_t pool_class(size_t size)
+{
+	slb_uint_t e = POOL_MIN_SHIFT;
+	size_t q;
+
+	if ( size <= ( (size_t)1 << POOL_MIN_SHIFT ) ) {
+		return 0U;
+	}
+	while ( ( (size_t)2 << e ) < size ) {
+		++e;
+	}
+	q = ( size - ( (size_t)1 << e ) + ( (size_t)1 << (e - 2U) ) - 1U ) >> (e - 2U);
+	return ( e - POOL_MIN_SHIFT ) * 4U + (slb_uint_t)q;
+}
+
+/* Size of the class */
+static size_t pool_class_size(slb_uint_t c)
+{
+	return (size_t)( 4U + c % 4U ) << ( c / 4U + POOL_MIN_SHIFT - 2U );
+}
+
+/* Takes a block from the list of the class or the current arena (locked)
+	SLB_NULL is returned when a new region is needed.
+*/
+static POOL_BLOCK* pool_take(slb_uint_t c)
+{
+	const size_t size = pool_class_size(c);
+	POOL_BLOCK* block = s_list[c];
+
+	if (block != SLB_NULL) {
+		s_list[c] = block->next;
+		return block;
+	}
+	if ( (SSS_POOL_ARENA / 2U < size) || (s_bump_left < size) ) {
+		return SLB_NULL;
+	}
+
+	block = (POOL_BLOCK*)s_bump;
+	s_bump += size;
+	s_bump_left -= size;
+	return block;
+}
+
+/* Adds a new region, and carves a block out of it (locked)
+	A block larger than half an arena has a region of its own. Otherwise the region is
+	the new arena, and the rest of the current arena is put into the lists.
+*/
+static POOL_BLOCK* pool_carve(slb_uint_t c, POOL_REGION* region)
+{
+	const size_t size = pool_class_size(c);
+	POOL_BLOCK* block;
+	slb_uint_t r;
+
+	region->next = s_regions;
+	s_regions = region;
+
+	++s_stat.regions;
+	s_stat.locked += region->locked ? 1U : 0U;
+	s_stat.huge += region->huge ? 1U : 0U;
+	s_stat.mapped += region->size;
+	s_stat.system_calls += 1U + ( ( s_flags & SSS_POOL_LOCK ) ? 1U : 0U ) + ( ( s_flags & SSS_POOL_HUGE ) ? 1U : 0U );
+
+	if (SSS_POOL_ARENA / 2U < size) {
+		return (POOL_BLOCK*)region->base;
+	}
+
+	while ( pool_class_size(0U) <= s_bump_left ) {
+		r = pool_class(s_bump_left);
+		if (s_bump_left < pool_class_size(r)) {
+			--r;
+		}
+		block = (POOL_BLOCK*)s_bump;
+		block->next = s_list[r];
+		s_list[r] = block;
+		s_bump += pool_class_size(r);
+		s_bump_left -= pool_class_size(r);
+	}
+
+	block = (POOL_BLOCK*)region->base;
+	s_bump = (slb_uint8_t*)region->base + size;
+	s_bump_left = SSS_POOL_ARENA - size;
+	return block;
+}
+
+/* Maps a region (not locked, since the system calls may take long) */
+static POOL_REGION* pool_region(size_t size)
+{
+	POOL_REGION* region;
+
+	region = (POOL_REGION*)malloc( sizeof(POOL_REGION) );
+	if (region == SLB_NULL) {
+		return SLB_NULL;
+	}
+	region->base = pool_map( size, &region->locked, &region->huge );
+	if (region->base == SLB_NULL) {
+		free(region);
+		return SLB_NULL;
+	}
+	region->size = size;
+	region->next = SLB_NULL;
+	return region;
+}
+
+/* Maps memory from the system with the options */
+static void* pool_map(size_t size, slb_bool_t* locked, slb_bool_t* huge)
+{
+	void* mem = SLB_NULL;
+
+	*locked = SLB_FALSE;
+	*huge = SLB_FALSE;
+
+#if defined(_MSC_VER)
+	/* Large pages are locked always (SeLockMemoryPrivilege is needed) */
+	if ( ( s_flags & SSS_POOL_HUGE ) && ( GetLargePageMinimum() != 0U ) && ( size % GetLargePageMinimum() == 0U ) ) {
+		mem = VirtualAlloc( SLB_NULL, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE );
+		if (mem != SLB_NULL) {
+			*locked = SLB_TRUE;
+			*huge = SLB_TRUE;
+			return mem;
+		}
+	}
+	mem = VirtualAlloc( SLB_NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+	if (mem == SLB_NULL) {
+		return SLB_NULL;
+	}
+	if (s_flags & SSS_POOL_LOCK) {
+		*locked = VirtualLock( mem, size ) ? SLB_TRUE : SLB_FALSE;
+	}
+#else
+	/* Reserved huge pages, or transparent huge pages of an aligned region */
+	if ( ( s_flags & SSS_POOL_HUGE ) && ( size % SSS_POOL_ARENA == 0U ) ) {
+		mem = mmap( SLB_NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+		if (mem != MAP_FAILED) {
+			*huge = SLB_TRUE;
+		}
+		else {
+			slb_uint8_t* raw = mmap( SLB_NULL, size + SSS_POOL_ARENA, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+			size_t head;
+
+			if (raw == MAP_FAILED) {
+				return SLB_NULL;
+			}
+			head = (size_t)( ( SSS_POOL_ARENA - ( (slb_uintptr_t)raw & ( SSS_POOL_ARENA - 1U ) ) ) & ( SSS_POOL_ARENA - 1U ) );
+			if (head != 0U) {
+				munmap( raw, head );
+			}
+			munmap( raw + head + size, SSS_POOL_ARENA - head );
+			mem = raw + head;
+			*huge = ( madvise( mem, size, MADV_HUGEPAGE ) == 0 ) ? SLB_TRUE : SLB_FALSE;
+		}
+	}
+	else {
+		mem = mmap( SLB_NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+		if (mem == MAP_FAILED) {
+			return SLB_NULL;
+		}
+	}
+	if (s_flags & SSS_POOL_LOCK) {
+		*locked = ( mlock( mem, size ) == 0 ) ? SLB_TRUE : SLB_FALSE;
+	}
+#endif
+
+	return mem;
+}
+
+/* Unmaps memory (the lock is released with the mapping) */
+static void pool_unmap(void* mem, size_t size)
+{
+#if defined(_MSC_VER)
+	(void)size;
+	VirtualFree( mem, 0, MEM_RELEASE );
+#else
+	munmap( mem, size );
+#endif
+}
+
+/* Discards the cache of this thread after sss_pool_release
+	At the first use of the cache, the thread is registered to flush it at the exit.
+*/
+static void pool_sync_cache(void)
+{
+	const slb_uint_t gen = POOL_GEN();
+
+	if (t_gen != gen) {
+		memset( t_cache, 0, sizeof(t_cache) );
+		memset( t_count, 0, sizeof(t_count) );
+		t_gen = gen;
+	}
+	if (t_exit == SLB_FALSE) {
+#if defined(_MSC_VER)
+		InitOnceExecuteOnce( &s_once, pool_exit_init, SLB_NULL, SLB_NULL );
+		t_exit = ( (s_exit != FLS_OUT_OF_INDEXES) && FlsSetValue(s_exit, (PVOID)&t_exit) ) ? SLB_TRUE : SLB_FALSE;
+#else
+		pthread_once( &s_once, pool_exit_init );
+		t_exit = ( pthread_setspecific(s_exit, &t_exit) == 0 ) ? SLB_TRUE : SLB_FALSE;
+#endif
+	}
+}
+
+/* Returns the cache of this thread to the global lists */
+static void pool_flush_cache(void)
+{
+	POOL_BLOCK* block;
+	slb_uint_t c;
+	slb_uint64_t flushed = 0U;
+
+	pool_sync_cache();
+
+	POOL_LOCK();
+	for (c = 0; c < POOL_CACHE_CLASSES; ++c) {
+		while (t_cache[c] != SLB_NULL) {
+			block = t_cache[c];
+			t_cache[c] = block->next;
+			block->next = s_list[c];
+			s_list[c] = block;
+			++flushed;
+		}
+		t_count[c] = 0U;
+	}
+	s_stat.flushed += flushed;
+	POOL_UNLOCK();
+}
+
+#if defined(_MSC_VER)
+
+/* Allocates the fiber local storage with the callback at the thread exit */
+static BOOL CALLBACK pool_exit_init(PINIT_ONCE once, PVOID param, PVOID* context)
+{
+	(void)once;
+	(void)param;
+	(void)context;
+
+	s_exit = FlsAlloc(pool_exit);
+	return TRUE;
+}
+
+/* Flushes the cache at the thread exit */
+static VOID WINAPI pool_exit(PVOID param)
+{
+	if (param != SLB_NULL) {
+		pool_flush_cache();
+	}
+}
+
+#else
+
+/* Creates the key with the destructor at the thread exit */
+static void pool_exit_init(void)
+{
+	(void)pthread_key_create( &s_exit, pool_exit );
+}
+
+/* Flushes the cache at the thread exit */
+static void pool_exit(void* param)
+{
+	(void)param;
+
+	pool_flush_cache();
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ Pool allocator
+ -------------------------------------------------------------------------------
+ Memory management callbacks for slb_config that reuse the freed blocks:
+	slb_config(sss_pool_alloc, sss_pool_free);
+
+ The blocks are divided into size classes of 4 steps for each power of 2
+ (64, 80, 96, 112, 128, 160, ...). The blocks are carved out of arenas of
+ SSS_POOL_ARENA bytes, and a block larger than half an arena has a region of its
+ own. A freed block is kept in the list of its class, and is not returned to the
+ system until sss_pool_release. The memory of an open/close cycle is reused,
+ so the cycle does not call the system allocator and mlock.
+
+ Each thread has a cache of SSS_POOL_CACHE blocks for the classes up to
+ SSS_POOL_CACHE_MAX bytes, and takes the lock only when the cache is empty or full.
+ The cache is returned to the global lists when the thread exits. A new region
+ is mapped out of the lock, and added to the lists after it.
+
+ A block freed without the clearing (the cleared flag of SLB_FREE) is wiped,
+ so that the pool keeps no data of the freed blocks.
+
+ Options of the regions:
+	SSS_POOL_LOCK	the memory is not swapped (mlock / VirtualLock)
+	SSS_POOL_HUGE	huge pages (MAP_HUGETLB or transparent huge pages / MEM_LARGE_PAGES)
+ When the system refuses an option (e.g. RLIMIT_MEMLOCK), the region is used
+ without it, and sss_pool_get_stat shows the regions with the option.
+
+ The pool is global to the process. Blocks of more than SSS_POOL_MAX_BLOCK bytes
+ are mapped and unmapped for each allocation.
+ *******************************************************************************/
+#ifndef SSS_POOL_H
+#define SSS_POOL_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_POOL_ARENA		( 2U * 1024U * 1024U )		/* Size of an arena (huge page) */
+#define SSS_POOL_MAX_BLOCK	( 64U * 1024U * 1024U )		/* Maximum size of a pooled block */
+#define SSS_POOL_CACHE		8U							/* Number of blocks of a class cached by a thread */
+#define SSS_POOL_CACHE_MAX	( 64U * 1024U )				/* Maximum size of a block cached by a thread */
+
+#define SSS_POOL_LOCK		0x0001U		/* Locks the memory */
+#define SSS_POOL_HUGE		0x0002U		/* Uses huge pages */
+
+/***** Statistics *****/
+typedef struct {
+	slb_uint_t		regions;		/* number of regions mapped */
+	slb_uint_t		locked;			/* number of regions locked */
+	slb_uint_t		huge;			/* number of regions of huge pages */
+	slb_uint64_t	mapped;			/* bytes mapped */
+	slb_uint64_t	system_calls;	/* calls of the system allocator (map, lock, unmap) */
+	slb_uint64_t	flushed;		/* blocks returned from the caches of exited threads */
+} SSS_POOL_STAT;
+
+/***** Function *****/
+void sss_pool_init(
+	slb_uint_t			flags		/* SSS_POOL_LOCK, SSS_POOL_HUGE */
+);
+
+void* sss_pool_alloc(
+	void*				param,		/* parameter for memory management callback (not used) */
+	slb_uint_t			size		/* size in bytes */
+);
+
+void sss_pool_free(
+	void*				param,		/* parameter for memory management callback (not used) */
+	void*				mem,		/* memory */
+	slb_uint_t			size,		/* size in bytes */
+	slb_bool_t			cleared		/* =SLB_TRUE: memory is cleared */
+);
+
+void sss_pool_get_stat(
+	SSS_POOL_STAT*		stat		/* [out] statistics */
+);
+
+void sss_pool_release(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_POOL_H */
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ Decode resource
+ *******************************************************************************/
+#include "sss_res.h"
+#include "sss_gfp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
+
+#define RES_FILE_SIZE	( sizeof(SSS_RES_HEADER) + sizeof(slb_uint32_t) * SSS_RES_COUNT )
+
+static void res_build(slb_uint32_t* inv);
+static slb_uint64_t res_checksum(const slb_uint32_t* inv);
+
+static const slb_uint32_t* s_inv = SLB_NULL;		/* table in use */
+static slb_uint32_t* s_built = SLB_NULL;			/* table built by this process */
+static void* s_map = SLB_NULL;						/* mapped file */
+#if defined(_MSC_VER)
+static HANDLE s_mapping = SLB_NULL;					/* file mapping object */
+#endif
+
+/* Saves decode resource to the file */
+SLB_RC sss_res_save(
+	const char*			path		/* file path */
+)
+{
+	SSS_RES_HEADER header;
+	slb_uint32_t* inv;
+	FILE* fp;
+	slb_bool_t ok;
+
+	inv = malloc( sizeof(slb_uint32_t) * SSS_RES_COUNT );
+	if (inv == SLB_NULL) {
+		return R_LOW_MEMORY;
+	}
+	res_build(inv);
+
+	memset(&header, 0, sizeof(header));
+	memcpy( header.magic, SSS_RES_MAGIC, sizeof(header.magic) );
+	header.version = SSS_RES_VERSION;
+	header.prime = SSS_GFP_PRIME;
+	header.count = SSS_RES_COUNT;
+	header.header_size = sizeof(SSS_RES_HEADER);
+	header.checksum = res_checksum(inv);
+
+	fp = fopen(path, "wb");
+	ok = (slb_bool_t)( fp != SLB_NULL );
+	if (ok) {
+		ok = (slb_bool_t)( ( fwrite(&header, sizeof(header), 1, fp) == 1 ) &&
+						   ( fwrite(inv, sizeof(slb_uint32_t), SSS_RES_COUNT, fp) == SSS_RES_COUNT ) );
+		ok = (slb_bool_t)( ( fclose(fp) == 0 ) && ok );
+	}
+
+	free(inv);
+	return ok ? R_SUCCESS : R_SSS_RES_IO;
+}
+
+/* Maps decode resource from the file
+	R_SSS_NOT_INIT is returned if the file cannot be mapped or is not valid,
+	and then the table is built by sss_res_prepare.
+*/
+SLB_RC sss_res_map(
+	const char*			path		/* file path */
+)
+{
+	const SSS_RES_HEADER* header;
+	void* map = SLB_NULL;
+
+	if (s_inv != SLB_NULL) {
+		return R_SUCCESS;
+	}
+
+#if defined(_MSC_VER)
+	{
+		HANDLE file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, SLB_NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, SLB_NULL );
+		if (file != INVALID_HANDLE_VALUE) {
+			LARGE_INTEGER size;
+			if ( GetFileSizeEx(file, &size) && (size.QuadPart == (LONGLONG)RES_FILE_SIZE) ) {
+				s_mapping = CreateFileMappingA( file, SLB_NULL, PAGE_READONLY, 0, 0, SLB_NULL );
+				if (s_mapping != SLB_NULL) {
+					map = MapViewOfFile( s_mapping, FILE_MAP_READ, 0, 0, 0 );
+					if (map == SLB_NULL) {
+						CloseHandle(s_mapping);
+						s_mapping = SLB_NULL;
+					}
+				}
+			}
+			CloseHandle(file);
+		}
+	}
+#else
+	{
+		const int fd = open(path, O_RDONLY);
+		if (0 <= fd) {
+			struct stat st;
+			if ( (fstat(fd, &st) == 0) && ( (size_t)st.st_size == RES_FILE_SIZE ) ) {
+				map = mmap( SLB_NULL, RES_FILE_SIZE, PROT_READ, MAP_SHARED, fd, 0 );
+				if (map == MAP_FAILED) {
+					map = SLB_NULL;
+				}
+			}
+			close(fd);
+		}
+	}
+#endif
+
+	if (map == SLB_NULL) {
+		return R_SSS_NOT_INIT;
+	}
+	s_map = map;
+
+	/* Check the header and the checksum */
+	header = (const SSS_RES_HEADER*)map;
+	if ( (memcmp( header->magic, SSS_RES_MAGIC, sizeof(header->magic) ) != 0) ||
+		 (header->version != SSS_RES_VERSION) || (header->prime != SSS_GFP_PRIME) ||
+		 (header->count != SSS_RES_COUNT) || (header->header_size != sizeof(SSS_RES_HEADER)) ||
+		 (header->checksum != res_checksum( (const slb_uint32_t*)( header + 1 ) )) ) {
+		sss_res_release();
+		return R_SSS_NOT_INIT;
+	}
+
+	s_inv = (const slb_uint32_t*)( header + 1 );
+	sss_gfp_set_inv_table(s_inv);
+	return R_SUCCESS;
+}
+
+/* Prepares decode resource
+	If the file is not mapped, the table is built (at the first call only).
+	Call it in the main thread before decoding.
+*/
+SLB_RC sss_res_prepare(void)
+{
+	if (s_inv != SLB_NULL) {
+		return R_SUCCESS;
+	}
+
+	s_built = malloc( sizeof(slb_uint32_t) * SSS_RES_COUNT );
+	if (s_built == SLB_NULL) {
+		return R_LOW_MEMORY;
+	}
+	res_build(s_built);
+
+	s_inv = s_built;
+	sss_gfp_set_inv_table(s_inv);
+	return R_SUCCESS;
+}
+
+/* Returns whether decode resource is mapped from the file */
+slb_bool_t sss_res_is_mapped(void)
+{
+	return (slb_bool_t)( s_map != SLB_NULL );
+}
+
+/* Releases decode resource */
+void sss_res_release(void)
+{
+	sss_gfp_set_inv_table(SLB_NULL);
+	s_inv = SLB_NULL;
+
+	if (s_built != SLB_NULL) {
+		free(s_built);
+		s_built = SLB_NULL;
+	}
+	if (s_map != SLB_NULL) {
+#if defined(_MSC_VER)
+		UnmapViewOfFile(s_map);
+		CloseHandle(s_mapping);
+		s_mapping = SLB_NULL;
+#else
+		munmap(s_map, RES_FILE_SIZE);
+#endif
+		s_map = SLB_NULL;
+	}
+}
+
+/* Builds the table of inverses
+	inv[i] = -(p / i) * inv[p mod i], since p = (p / i) * i + (p mod i).
+*/
+static void res_build(slb_uint32_t* inv)
+{
+	slb_uint32_t i;
+
+	inv[0] = 0U;
+	inv[1] = 1U;
+	for (i = 2; i < SSS_RES_COUNT; ++i) {
+		inv[i] = SSS_GFP_SUB( 0U, SSS_GFP_MUL( SSS_GFP_PRIME / i, inv[SSS_GFP_PRIME % i] ) );
+	}
+}
+
+/* Gets the checksum of the table (FNV-1a, 64 bits, of 32-bit entries)
+	An entry is folded at once instead of a byte, so that mapping is faster than building.
+*/
+static slb_uint64_t res_checksum(const slb_uint32_t* inv)
+{
+	slb_uint64_t h = 0xcbf29ce484222325ULL;
+	slb_uint_t i;
+
+	for (i = 0; i < SSS_RES_COUNT; ++i) {
+		h ^= inv[i];
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
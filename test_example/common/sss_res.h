@@ -0,0 +1,64 @@
+/*******************************************************************************
+ Decode resource
+ -------------------------------------------------------------------------------
+ The table of the multiplicative inverses of GF(65537), used by sss_gfp_inv
+ instead of the exponentiation.
+
+ The table is saved to a file once, and each process maps the file read-only,
+ so that the processes share one copy in the page cache and do not build it.
+ When the file is not mapped, the table is built by sss_res_prepare,
+ as slb_sss_init_decode_res of each process.
+
+ File format (little endian):
+	SSS_RES_HEADER, and inv[SSS_RES_COUNT] (slb_uint32_t, inv[0] = 0).
+	The checksum is FNV-1a (64 bits) of the 32-bit entries of the table.
+
+ The resource is global to the process, and the functions are not thread-safe.
+ Map or prepare it once in the main thread before decoding, as slb_sss_init_decode_res.
+ The decoding handles do not prepare it; without it, sss_gfp_inv uses the exponentiation.
+ *******************************************************************************/
+#ifndef SSS_RES_H
+#define SSS_RES_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_RES_MAGIC		"SSSRES\r\n"	/* Magic number of the file */
+#define SSS_RES_VERSION		2U				/* Version of the file */
+#define SSS_RES_COUNT		65537U			/* Number of entries of the table */
+
+#define R_SSS_RES_IO		0xc180U			/* File I/O error */
+
+/***** File header *****/
+typedef struct {
+	char			magic[8];		/* SSS_RES_MAGIC */
+	slb_uint32_t	version;		/* SSS_RES_VERSION */
+	slb_uint32_t	prime;			/* SSS_GFP_PRIME */
+	slb_uint32_t	count;			/* SSS_RES_COUNT */
+	slb_uint32_t	header_size;	/* sizeof(SSS_RES_HEADER) */
+	slb_uint64_t	checksum;		/* FNV-1a of the table */
+} SSS_RES_HEADER;
+
+/***** Function *****/
+SLB_RC sss_res_save(
+	const char*			path		/* file path */
+);
+
+SLB_RC sss_res_map(
+	const char*			path		/* file path */
+);
+
+SLB_RC sss_res_prepare(void);
+
+slb_bool_t sss_res_is_mapped(void);
+
+void sss_res_release(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_RES_H */
@@ -0,0 +1,393 @@
+/*******************************************************************************
+ Robust decoding
+ *******************************************************************************/
+#include "sss_robust.h"
+#include "sss_gfp.h"
+
+#include <string.h>
+
+static void robust_free(void* mem_param, void* mem, slb_bool_t clear);
+static void robust_predict(SSS_ROBUST* robust, slb_int_t nmb, const slb_uint32_t** share, slb_uint_t nmb_others);
+static slb_bool_t robust_berlekamp_welch(SSS_ROBUST* robust, const slb_uint32_t** share, slb_int_t index);
+
+/* Opens robust decoding context */
+SLB_RC sss_robust_open(
+	SSS_ROBUST*			robust,		/* robust decoding context */
+	slb_uint_t			m,			/* number of shares */
+	slb_uint_t			k,			/* threshold */
+	const slb_uint16_t	x[],		/* x coordinates */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	slb_uint_t i;
+	SLB_RC rc;
+
+	memset(robust, 0, sizeof(*robust));
+
+	if ( (k < SLB_SSS_MIN_PLAYERS) || (m < k) || (nmb_max <= 0) ) {
+		return R_INVALID_PARAM;
+	}
+
+	/* Check x coordinates */
+	rc = sss_gfp_check_x( m, x, SLB_MASK_OF_UINT16 );
+	if ( SLB_R_FAILED(rc) ) {
+		return rc;
+	}
+
+	robust->m = m;
+	robust->k = k;
+	robust->e_max = (m - k) / 2U;
+	robust->nmb_max = nmb_max;
+	robust->mem_param = mem_param;
+
+	/* Allocate resources */
+	robust->x = slb_alloc( mem_param, sizeof(slb_uint32_t) * m );
+	robust->suspect = slb_alloc( mem_param, sizeof(slb_bool_t) * m );
+	robust->excluded = slb_alloc( mem_param, sizeof(slb_bool_t) * m );
+	robust->mismatch = slb_alloc( mem_param, sizeof(slb_bool_t) * m );
+	robust->basis = slb_alloc( mem_param, sizeof(slb_uint_t) * k );
+	robust->coef_basis = slb_alloc( mem_param, sizeof(slb_uint_t) * k );
+	robust->others = slb_alloc( mem_param, sizeof(slb_uint_t) * m );
+	robust->xb = slb_alloc( mem_param, sizeof(slb_uint32_t) * k );
+	robust->coef = slb_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint32_t) * m * k ) );
+	robust->acc = slb_alloc( mem_param, sizeof(slb_uint64_t) * (slb_uint_t)nmb_max );
+	robust->cnt = slb_alloc( mem_param, sizeof(slb_uint_t) * (slb_uint_t)nmb_max );
+	robust->mat = slb_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint32_t) * m * (m + 1U) ) );
+	robust->pivot = slb_alloc( mem_param, sizeof(slb_uint_t) * m );
+	robust->sol = slb_alloc( mem_param, sizeof(slb_uint32_t) * (m + 1U) );
+	robust->loc = slb_alloc( mem_param, sizeof(slb_uint32_t) * (m + 1U) );
+
+	if ( (robust->x == SLB_NULL) || (robust->suspect == SLB_NULL) || (robust->excluded == SLB_NULL) ||
+		 (robust->mismatch == SLB_NULL) || (robust->basis == SLB_NULL) || (robust->coef_basis == SLB_NULL) ||
+		 (robust->others == SLB_NULL) ||
+		 (robust->xb == SLB_NULL) || (robust->coef == SLB_NULL) || (robust->acc == SLB_NULL) ||
+		 (robust->cnt == SLB_NULL) || (robust->mat == SLB_NULL) || (robust->pivot == SLB_NULL) ||
+		 (robust->sol == SLB_NULL) || (robust->loc == SLB_NULL) ) {
+		sss_robust_close(robust);
+		return R_LOW_MEMORY;
+	}
+
+	for (i = 0; i < m; ++i) {
+		robust->x[i] = (slb_uint32_t)x[i];
+		robust->suspect[i] = SLB_FALSE;
+	}
+
+	return R_SUCCESS;
+}
+
+/* Closes robust decoding context */
+void sss_robust_close(
+	SSS_ROBUST*			robust		/* robust decoding context */
+)
+{
+	void* mem_param = robust->mem_param;
+
+	/* Buffers holding share values are cleared */
+	robust_free( mem_param, robust->x, SLB_FALSE );
+	robust_free( mem_param, robust->suspect, SLB_FALSE );
+	robust_free( mem_param, robust->excluded, SLB_FALSE );
+	robust_free( mem_param, robust->mismatch, SLB_FALSE );
+	robust_free( mem_param, robust->basis, SLB_FALSE );
+	robust_free( mem_param, robust->coef_basis, SLB_FALSE );
+	robust_free( mem_param, robust->others, SLB_FALSE );
+	robust_free( mem_param, robust->xb, SLB_FALSE );
+	robust_free( mem_param, robust->coef, SLB_FALSE );
+	robust_free( mem_param, robust->acc, SLB_TRUE );
+	robust_free( mem_param, robust->cnt, SLB_FALSE );
+	robust_free( mem_param, robust->mat, SLB_TRUE );
+	robust_free( mem_param, robust->pivot, SLB_FALSE );
+	robust_free( mem_param, robust->sol, SLB_TRUE );
+	robust_free( mem_param, robust->loc, SLB_TRUE );
+
+	memset(robust, 0, sizeof(*robust));
+}
+
+/* Finds the faulty shares of a chunk
+	Returns SLB_FALSE if a word of the chunk has more faulty shares than (m - k) / 2.
+	The shares found faulty are excluded first from the basis of the next chunk,
+	so a share that stays faulty does not need the Berlekamp-Welch algorithm again.
+*/
+slb_bool_t sss_robust_check(
+	SSS_ROBUST*			robust,		/* robust decoding context */
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint32_t**	share,	/* share buffer [m] */
+	slb_bool_t			faulty[]	/* [out] =SLB_TRUE: faulty share */
+)
+{
+	const slb_uint_t m = robust->m;
+	const slb_uint_t k = robust->k;
+	slb_uint_t i, nmb_basis, nmb_others;
+	slb_int_t j;
+
+	if ( (nmb <= 0) || (robust->nmb_max < nmb) ) {
+		return SLB_FALSE;
+	}
+
+	for (i = 0; i < m; ++i) {
+		robust->excluded[i] = SLB_FALSE;
+	}
+
+	for (;;) {
+
+		/* Select the basis, giving priority to the shares not suspected */
+		nmb_basis = 0;
+		for (i = 0; (i < m) && (nmb_basis < k); ++i) {
+			if ( !robust->suspect[i] && !robust->excluded[i] ) {
+				robust->basis[nmb_basis++] = i;
+			}
+		}
+		for (i = 0; (i < m) && (nmb_basis < k); ++i) {
+			if ( robust->suspect[i] && !robust->excluded[i] ) {
+				robust->basis[nmb_basis++] = i;
+			}
+		}
+		if (nmb_basis < k) {
+			return SLB_FALSE;
+		}
+
+		nmb_others = 0;
+		for (i = 0; i < m; ++i) {
+			robust->mismatch[i] = SLB_TRUE;
+		}
+		for (i = 0; i < k; ++i) {
+			robust->mismatch[ robust->basis[i] ] = SLB_FALSE;
+			robust->xb[i] = robust->x[ robust->basis[i] ];
+		}
+		for (i = 0; i < m; ++i) {
+			if (robust->mismatch[i]) {
+				robust->others[nmb_others++] = i;
+			}
+		}
+
+		/* Lagrange coefficients are reused while the basis is unchanged */
+		if ( (robust->coef_valid == SLB_FALSE) ||
+			 ( memcmp(robust->coef_basis, robust->basis, sizeof(slb_uint_t) * k) != 0 ) ) {
+			for (i = 0; i < nmb_others; ++i) {
+				sss_gfp_lagrange( k, robust->xb, robust->x[ robust->others[i] ], &robust->coef[i * k] );
+			}
+			memcpy(robust->coef_basis, robust->basis, sizeof(slb_uint_t) * k);
+			robust->coef_valid = SLB_TRUE;
+		}
+
+		/* Predict the other shares from the basis and count mismatches */
+		robust_predict(robust, nmb, share, nmb_others);
+
+		/* Find a word with too many mismatches */
+		for (j = 0; j < nmb; ++j) {
+			if (robust->e_max < robust->cnt[j]) {
+				break;
+			}
+		}
+
+		/* All mismatched shares are faulty */
+		if (j == nmb) {
+			for (i = 0; i < m; ++i) {
+				faulty[i] = robust->mismatch[i];
+				robust->suspect[i] = robust->mismatch[i];
+			}
+			return SLB_TRUE;
+		}
+
+		/* The basis contains a faulty share */
+		if ( robust_berlekamp_welch(robust, share, j) == SLB_FALSE ) {
+			return SLB_FALSE;
+		}
+	}
+}
+
+/* Frees a buffer if allocated */
+static void robust_free(void* mem_param, void* mem, slb_bool_t clear)
+{
+	if (mem != SLB_NULL) {
+		slb_free(mem_param, mem, clear);
+	}
+}
+
+/* Predicts the other shares from the basis shares
+	Sets mismatch flags of the other shares and the number of mismatches of each word.
+	The sum of products is accumulated in 64 bits and reduced only once per word.
+*/
+static void robust_predict(SSS_ROBUST* robust, slb_int_t nmb, const slb_uint32_t** share, slb_uint_t nmb_others)
+{
+	const slb_uint_t k = robust->k;
+	slb_uint64_t*const acc = robust->acc;
+	slb_uint_t*const cnt = robust->cnt;
+	slb_uint_t t, b;
+	slb_int_t j;
+
+	for (j = 0; j < nmb; ++j) {
+		cnt[j] = 0;
+	}
+
+	for (t = 0; t < nmb_others; ++t) {
+		const slb_uint_t other = robust->others[t];
+		const slb_uint32_t*const coef = &robust->coef[t * k];
+		const slb_uint32_t* y = share[other];
+		slb_uint_t mismatches = 0;
+
+		for (j = 0; j < nmb; ++j) {
+			acc[j] = 0;
+		}
+
+		for (b = 0; b < k; ++b) {
+			const slb_uint64_t c = coef[b];
+			const slb_uint32_t* yb = share[ robust->basis[b] ];
+			for (j = 0; j < nmb; ++j) {
+				acc[j] += c * yb[j];
+			}
+		}
+
+		for (j = 0; j < nmb; ++j) {
+			const slb_uint_t differ = (slb_uint_t)( sss_gfp_reduce(acc[j]) != y[j] );
+			cnt[j] += differ;
+			mismatches |= differ;
+		}
+
+		robust->mismatch[other] = (slb_bool_t)(mismatches != 0U);
+	}
+}
+
+/* Finds the faulty shares of a word by Berlekamp-Welch algorithm
+	Solves Q(x_i) = y_i * E(x_i) for all shares, where E is the monic error locator
+	of degree e_max and Q is a polynomial of degree less than e_max + k.
+	Then the polynomial is Q / E, and the shares that do not lie on it are excluded from the basis.
+	Returns SLB_FALSE if the word cannot be corrected.
+*/
+static slb_bool_t robust_berlekamp_welch(SSS_ROBUST* robust, const slb_uint32_t** share, slb_int_t index)
+{
+	const slb_uint_t m = robust->m;
+	const slb_uint_t k = robust->k;
+	const slb_uint_t e = robust->e_max;
+	const slb_uint_t nq = e + k;				/* number of coefficients of Q */
+	const slb_uint_t cols = nq + e;			/* number of unknowns */
+	const slb_uint_t width = cols + 1U;		/* with right-hand side */
+	slb_uint32_t*const mat = robust->mat;
+	slb_uint32_t*const sol = robust->sol;
+	slb_uint32_t*const loc = robust->loc;
+	slb_uint_t i, c, r, rank, errors;
+	slb_bool_t basis_excluded;
+
+	/* Build linear system */
+	for (i = 0; i < m; ++i) {
+		slb_uint32_t*const row = &mat[i * width];
+		const slb_uint32_t xi = robust->x[i];
+		const slb_uint32_t yi = share[i][index];
+		slb_uint32_t pw = 1U;
+
+		for (c = 0; c < nq; ++c) {
+			row[c] = pw;
+			if (c < e) {
+				row[nq + c] = SSS_GFP_SUB( 0U, SSS_GFP_MUL(yi, pw) );
+			}
+			pw = SSS_GFP_MUL(pw, xi);
+		}
+		row[cols] = SSS_GFP_MUL( yi, sss_gfp_pow(xi, e) );
+	}
+
+	/* Gauss-Jordan elimination */
+	rank = 0;
+	for (c = 0; (c < cols) && (rank < m); ++c) {
+		slb_uint32_t* prow;
+		slb_uint32_t inv;
+
+		for (r = rank; r < m; ++r) {
+			if (mat[r * width + c] != 0U) {
+				break;
+			}
+		}
+		if (r == m) {
+			continue;
+		}
+
+		prow = &mat[rank * width];
+		if (r != rank) {
+			slb_uint32_t* srow = &mat[r * width];
+			slb_uint_t l;
+			for (l = 0; l < width; ++l) {
+				slb_uint32_t tmp = prow[l];
+				prow[l] = srow[l];
+				srow[l] = tmp;
+			}
+		}
+
+		inv = sss_gfp_inv(prow[c]);
+		for (i = c; i < width; ++i) {
+			prow[i] = SSS_GFP_MUL(prow[i], inv);
+		}
+
+		for (r = 0; r < m; ++r) {
+			slb_uint32_t*const row = &mat[r * width];
+			const slb_uint32_t f = row[c];
+			if ( (r != rank) && (f != 0U) ) {
+				for (i = c; i < width; ++i) {
+					row[i] = SSS_GFP_SUB( row[i], SSS_GFP_MUL(f, prow[i]) );
+				}
+			}
+		}
+
+		robust->pivot[rank++] = c;
+	}
+
+	/* Inconsistent system */
+	for (r = rank; r < m; ++r) {
+		if (mat[r * width + cols] != 0U) {
+			return SLB_FALSE;
+		}
+	}
+
+	/* Solution (free unknowns are zero) */
+	for (c = 0; c < cols; ++c) {
+		sol[c] = 0;
+	}
+	for (r = 0; r < rank; ++r) {
+		sol[ robust->pivot[r] ] = mat[r * width + cols];
+	}
+
+	/* Divide Q by E: the quotient is placed at sol[e .. nq - 1] */
+	for (c = 0; c < e; ++c) {
+		loc[c] = sol[nq + c];
+	}
+	loc[e] = 1U;
+
+	for (c = nq; e < c; --c) {
+		const slb_uint32_t q = sol[c - 1U];
+		for (i = 0; i < e; ++i) {
+			slb_uint32_t* p = &sol[c - 1U - e + i];
+			*p = SSS_GFP_SUB( *p, SSS_GFP_MUL(q, loc[i]) );
+		}
+	}
+
+	/* Remainder must be zero */
+	for (c = 0; c < e; ++c) {
+		if (sol[c] != 0U) {
+			return SLB_FALSE;
+		}
+	}
+
+	/* Exclude the shares that do not lie on the polynomial */
+	errors = 0;
+	for (i = 0; i < m; ++i) {
+		const slb_uint32_t xi = robust->x[i];
+		slb_uint32_t fx = 0;
+
+		for (c = nq; e < c; --c) {
+			fx = SSS_GFP_ADD( SSS_GFP_MUL(fx, xi), sol[c - 1U] );
+		}
+
+		if (fx != share[i][index]) {
+			++errors;
+			robust->excluded[i] = SLB_TRUE;
+		}
+	}
+
+	/* At least one basis share must be excluded, otherwise the same basis would be selected again */
+	basis_excluded = SLB_FALSE;
+	for (i = 0; i < k; ++i) {
+		if (robust->excluded[ robust->basis[i] ]) {
+			basis_excluded = SLB_TRUE;
+		}
+	}
+
+	return (slb_bool_t)( (errors <= e) && basis_excluded );
+}
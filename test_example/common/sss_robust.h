@@ -0,0 +1,73 @@
+/*******************************************************************************
+ Robust decoding
+ -------------------------------------------------------------------------------
+ When m shares (m > k) are available and some of them might be stale or corrupt,
+ finds the faulty shares of each chunk. The plain data can then be decoded by
+ slb_sss_decode with k shares that are not faulty.
+
+ The shares of a chunk are checked against the polynomial through k basis shares.
+ Only when a word has more mismatches than (m - k) / 2, the basis contains
+ a faulty share, and the Berlekamp-Welch algorithm is applied to that word
+ to find it. Up to (m - k) / 2 faulty shares per word can be corrected.
+ *******************************************************************************/
+#ifndef SSS_ROBUST_H
+#define SSS_ROBUST_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***** Robust decoding context *****/
+typedef struct {
+	slb_uint_t		m;			/* number of shares */
+	slb_uint_t		k;			/* threshold */
+	slb_uint_t		e_max;		/* maximum number of faulty shares */
+	slb_int_t		nmb_max;	/* maximum number of data */
+	void*			mem_param;	/* parameter for memory management callback */
+
+	slb_uint32_t*	x;			/* x coordinates [m] */
+	slb_bool_t*		suspect;	/* faulty shares of the previous chunk [m] */
+	slb_bool_t*		excluded;	/* shares excluded from basis [m] */
+	slb_bool_t*		mismatch;	/* shares mismatched with basis [m] */
+	slb_uint_t*		basis;		/* indices of basis shares [k] */
+	slb_uint_t*		coef_basis;	/* basis of Lagrange coefficients [k] */
+	slb_bool_t		coef_valid;	/* =SLB_TRUE: Lagrange coefficients are valid */
+	slb_uint_t*		others;		/* indices of other shares [m] */
+	slb_uint32_t*	xb;			/* x coordinates of basis shares [k] */
+	slb_uint32_t*	coef;		/* Lagrange coefficients [m * k] */
+	slb_uint64_t*	acc;		/* accumulator [nmb_max] */
+	slb_uint_t*		cnt;		/* number of mismatches [nmb_max] */
+	slb_uint32_t*	mat;		/* Berlekamp-Welch linear system [m * (m + 1)] */
+	slb_uint_t*		pivot;		/* pivot columns [m] */
+	slb_uint32_t*	sol;		/* solution of linear system [m + 1] */
+	slb_uint32_t*	loc;		/* error locator polynomial [m + 1] */
+} SSS_ROBUST;
+
+/***** Function *****/
+SLB_RC sss_robust_open(
+	SSS_ROBUST*			robust,		/* robust decoding context */
+	slb_uint_t			m,			/* number of shares */
+	slb_uint_t			k,			/* threshold */
+	const slb_uint16_t	x[],		/* x coordinates */
+	slb_int_t			nmb_max,	/* maximum number of data */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+void sss_robust_close(
+	SSS_ROBUST*			robust		/* robust decoding context */
+);
+
+slb_bool_t sss_robust_check(
+	SSS_ROBUST*			robust,		/* robust decoding context */
+	slb_int_t			nmb,		/* number of data */
+	const slb_uint32_t**	share,	/* share buffer [m] */
+	slb_bool_t			faulty[]	/* [out] =SLB_TRUE: faulty share */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_ROBUST_H */
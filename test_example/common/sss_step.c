@@ -0,0 +1,136 @@
+/*******************************************************************************
+ Step encoding/decoding
+ *******************************************************************************/
+#include "sss_step.h"
+#include "sss_clock.h"
+
+#include <string.h>
+
+static SLB_RC step_open(SSS_STEP* step, H_SLB_SSS handle, slb_uint_t nshare, slb_int_t size,
+						slb_uint32_t** share, slb_int_t nmb, void* mem_param);
+
+/* Opens step handle of encoding */
+SLB_RC sss_step_open_encode(
+	SSS_STEP*			step,		/* step handle */
+	H_SLB_SSS			hEncode,	/* control handle (encoding started) */
+	slb_uint_t			n,			/* number of shares */
+	slb_int_t			size,		/* plain size */
+	const slb_uint16_t*	plain,		/* plain data */
+	slb_uint32_t**		share,		/* [out] share buffers [n][size] */
+	slb_int_t			nmb,		/* number of data of a chunk */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	const SLB_RC rc = step_open( step, hEncode, n, size, share, nmb, mem_param );
+
+	step->in_plain = plain;
+	return rc;
+}
+
+/* Opens step handle of decoding */
+SLB_RC sss_step_open_decode(
+	SSS_STEP*			step,		/* step handle */
+	H_SLB_SSS			hDecode,	/* control handle (decoding started) */
+	slb_uint_t			k,			/* threshold */
+	slb_int_t			size,		/* plain size */
+	const slb_uint32_t**	share,	/* share buffers [k][size] */
+	slb_uint16_t*		plain,		/* [out] plain data */
+	slb_int_t			nmb,		/* number of data of a chunk */
+	void*				mem_param	/* parameter for memory management callback */
+)
+{
+	const SLB_RC rc = step_open( step, hDecode, k, size, (slb_uint32_t**)share, nmb, mem_param );
+
+	step->decode = SLB_TRUE;
+	step->out_plain = plain;
+	return rc;
+}
+
+/* Runs a step
+	Chunks are processed until the budget is used (at least one chunk).
+	When a chunk fails, its error is returned and the step stays at the chunk.
+*/
+SLB_RC sss_step_run(
+	SSS_STEP*			step,		/* step handle */
+	slb_uint64_t		budget_ns,	/* time budget (nanoseconds) */
+	slb_int_t*			progress	/* [out] data processed so far (SLB_NULL: not needed) */
+)
+{
+	const slb_uint64_t start = sss_clock_ns();
+	SLB_RC rc = R_SUCCESS;
+	slb_uint_t i;
+
+	if (step->sel == SLB_NULL) {
+		return R_INVALID_HANDLE;
+	}
+
+	while (step->offset < step->size) {
+		slb_int_t nmb = step->nmb;
+		if ( (step->size - step->offset) < nmb ) {
+			nmb = step->size - step->offset;
+		}
+
+		for (i = 0; i < step->nshare; ++i) {
+			step->sel[i] = &step->share[i][step->offset];
+		}
+		if (step->decode) {
+			rc = slb_sss_decode( step->handle, nmb, (const slb_uint32_t**)step->sel, &step->out_plain[step->offset] );
+		}
+		else {
+			rc = slb_sss_encode( step->handle, nmb, &step->in_plain[step->offset], step->sel );
+		}
+		if ( SLB_R_FAILED(rc) || (rc == R_SSS_STOP) ) {
+			break;
+		}
+		step->offset += nmb;
+
+		if ( budget_ns <= sss_clock_ns() - start ) {
+			break;
+		}
+	}
+
+	if (progress != SLB_NULL) {
+		*progress = step->offset;
+	}
+	if ( SLB_R_FAILED(rc) || (rc == R_SSS_STOP) ) {
+		return rc;
+	}
+	return (step->offset == step->size) ? R_COMPLETE : R_SUCCESS;
+}
+
+/* Closes step handle (the control handle is not closed) */
+void sss_step_close(
+	SSS_STEP*			step		/* step handle */
+)
+{
+	if (step->sel != SLB_NULL) {
+		slb_free( step->mem_param, step->sel, SLB_FALSE );
+	}
+
+	memset(step, 0, sizeof(*step));
+}
+
+/* Opens step handle */
+static SLB_RC step_open(SSS_STEP* step, H_SLB_SSS handle, slb_uint_t nshare, slb_int_t size,
+						slb_uint32_t** share, slb_int_t nmb, void* mem_param)
+{
+	memset(step, 0, sizeof(*step));
+
+	if ( (nshare == 0U) || (size <= 0) || (nmb <= 0) || (share == SLB_NULL) ) {
+		return R_INVALID_PARAM;
+	}
+
+	step->sel = slb_alloc( mem_param, (slb_uint_t)( sizeof(slb_uint32_t*) * nshare ) );
+	if (step->sel == SLB_NULL) {
+		return R_LOW_MEMORY;
+	}
+
+	step->handle = handle;
+	step->nshare = nshare;
+	step->size = size;
+	step->nmb = nmb;
+	step->mem_param = mem_param;
+	step->share = share;
+	return R_SUCCESS;
+}
+
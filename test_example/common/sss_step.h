@@ -0,0 +1,106 @@
+/*******************************************************************************
+ Step encoding/decoding
+ -------------------------------------------------------------------------------
+ Encodes or decodes a whole buffer by steps with the time budget, for the
+ single-threaded event loops. Each call of sss_step_run processes chunks of
+ libslbsss until the budget is used, and the next call resumes at the next
+ chunk. At least one chunk is processed per call, so that the step always
+ progresses.
+
+ sss_step_run returns R_SUCCESS while data remains, and R_COMPLETE at the end.
+
+ In C++20, sss_step_awaitable runs one step per co_await, and posts the
+ coroutine to the event loop between steps.
+ *******************************************************************************/
+#ifndef SSS_STEP_H
+#define SSS_STEP_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***** Step handle *****/
+typedef struct {
+	H_SLB_SSS			handle;			/* started control handle of libslbsss */
+	slb_bool_t			decode;			/* =SLB_TRUE: decoding */
+	slb_uint_t			nshare;			/* number of shares (n of encoding, k of decoding) */
+	slb_int_t			size;			/* plain size */
+	slb_int_t			nmb;			/* number of data of a chunk */
+	slb_int_t			offset;			/* data processed */
+	void*				mem_param;		/* parameter for memory management callback */
+	const slb_uint16_t*	in_plain;		/* plain data (encoding) */
+	slb_uint16_t*		out_plain;		/* [out] plain data (decoding) */
+	slb_uint32_t**		share;			/* share buffers [nshare][size] */
+	slb_uint32_t**		sel;			/* share pointers of the chunk [nshare] */
+} SSS_STEP;
+
+/***** Function *****/
+SLB_RC sss_step_open_encode(
+	SSS_STEP*			step,		/* step handle */
+	H_SLB_SSS			hEncode,	/* control handle (encoding started) */
+	slb_uint_t			n,			/* number of shares */
+	slb_int_t			size,		/* plain size */
+	const slb_uint16_t*	plain,		/* plain data */
+	slb_uint32_t**		share,		/* [out] share buffers [n][size] */
+	slb_int_t			nmb,		/* number of data of a chunk */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+SLB_RC sss_step_open_decode(
+	SSS_STEP*			step,		/* step handle */
+	H_SLB_SSS			hDecode,	/* control handle (decoding started) */
+	slb_uint_t			k,			/* threshold */
+	slb_int_t			size,		/* plain size */
+	const slb_uint32_t**	share,	/* share buffers [k][size] */
+	slb_uint16_t*		plain,		/* [out] plain data */
+	slb_int_t			nmb,		/* number of data of a chunk */
+	void*				mem_param	/* parameter for memory management callback */
+);
+
+SLB_RC sss_step_run(
+	SSS_STEP*			step,		/* step handle */
+	slb_uint64_t		budget_ns,	/* time budget (nanoseconds) */
+	slb_int_t*			progress	/* [out] data processed so far (SLB_NULL: not needed) */
+);
+
+void sss_step_close(
+	SSS_STEP*			step		/* step handle */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+/***** C++20 awaitable *****/
+#if defined(__cplusplus) && ( __cplusplus >= 202002L )
+#include <coroutine>
+
+/* Runs one step per co_await
+	post(h) must resume h later from the event loop.
+		SLB_RC rc;
+		while ( ( rc = co_await sss_step_awaitable<Post>{ &step, budget_ns, post } ) == R_SUCCESS ) {}
+*/
+template <class Post>
+struct sss_step_awaitable {
+	SSS_STEP*		step;
+	slb_uint64_t	budget_ns;
+	Post			post;
+	SLB_RC			rc = R_SUCCESS;
+
+	/* The step is run here, and the coroutine is suspended only if it succeeded */
+	bool await_ready() {
+		rc = sss_step_run(step, budget_ns, SLB_NULL);
+		return rc != R_SUCCESS;
+	}
+	void await_suspend(std::coroutine_handle<> h) {
+		post(h);
+	}
+	SLB_RC await_resume() const noexcept {
+		return rc;
+	}
+};
+#endif
+
+#endif	/* ifndef SSS_STEP_H */
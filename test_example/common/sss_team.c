@@ -0,0 +1,234 @@
+/*******************************************************************************
+ Thread team
+ *******************************************************************************/
+#include "sss_team.h"
+#include "sss_metrics.h"
+
+#include <string.h>
+
+#if defined(_MSC_VER)
+#	define TEAM_LOAD(p)			( (slb_uint_t)InterlockedCompareExchange((volatile LONG*)(p), 0, 0) )
+#	define TEAM_STORE(p, v)		InterlockedExchange((volatile LONG*)(p), (LONG)(v))
+#	define TEAM_INC(p)			InterlockedIncrement((volatile LONG*)(p))
+#	define TEAM_DEC(p)			InterlockedDecrement((volatile LONG*)(p))
+#	define TEAM_PAUSE()			YieldProcessor()
+#	define TEAM_YIELD()			SwitchToThread()
+#	define TEAM_LOCK(t)			EnterCriticalSection(&(t)->lock)
+#	define TEAM_UNLOCK(t)		LeaveCriticalSection(&(t)->lock)
+#	define TEAM_WAIT(t)			SleepConditionVariableCS(&(t)->wake, &(t)->lock, INFINITE)
+#	define TEAM_WAKE(t)			WakeAllConditionVariable(&(t)->wake)
+#else
+#	include <sched.h>
+#	define TEAM_LOAD(p)			( (slb_uint_t)__atomic_load_n(p, __ATOMIC_SEQ_CST) )
+#	define TEAM_STORE(p, v)		__atomic_store_n(p, v, __ATOMIC_SEQ_CST)
+#	define TEAM_INC(p)			__atomic_add_fetch(p, 1U, __ATOMIC_SEQ_CST)
+#	define TEAM_DEC(p)			__atomic_sub_fetch(p, 1U, __ATOMIC_SEQ_CST)
+#	define TEAM_PAUSE()			__builtin_ia32_pause()
+#	define TEAM_YIELD()			sched_yield()
+#	define TEAM_LOCK(t)			pthread_mutex_lock(&(t)->lock)
+#	define TEAM_UNLOCK(t)		pthread_mutex_unlock(&(t)->lock)
+#	define TEAM_WAIT(t)			pthread_cond_wait(&(t)->wake, &(t)->lock)
+#	define TEAM_WAKE(t)			pthread_cond_broadcast(&(t)->wake)
+#endif
+
+#if defined(_MSC_VER)
+static DWORD WINAPI team_thread(LPVOID param);
+#else
+static void* team_thread(void* param);
+#endif
+static void team_work(SSS_TEAM_WORKER* worker);
+
+/* Opens a team and starts the workers
+	The threads are assigned to the CPUs of sss_topo_select (the fastest first).
+*/
+SLB_RC sss_team_open(
+	SSS_TEAM*			team,		/* thread team */
+	slb_uint_t			nthread,	/* number of threads (0: the selected CPUs) */
+	slb_bool_t			physical,	/* =SLB_TRUE: one thread per physical core */
+	slb_bool_t			pin			/* =SLB_TRUE: the workers are pinned to the CPUs */
+)
+{
+	SSS_TEAM_WORKER* worker;
+	slb_uint_t count, t;
+
+	memset(team, 0, sizeof(*team));
+
+	(void)sss_topo_read( &team->topo, SLB_NULL );
+	count = sss_topo_select( &team->topo, physical, SSS_TEAM_MAX_THREADS, team->index );
+	if (nthread == 0U) {
+		nthread = count;
+	}
+	if ( (nthread == 0U) || (SSS_TEAM_MAX_THREADS < nthread) ) {
+		return R_INVALID_PARAM;
+	}
+	for (t = count; t < nthread; ++t) {
+		team->index[t] = team->index[t % count];
+	}
+	team->spin = ( nthread <= team->topo.logical ) ? SSS_TEAM_SPIN : 0U;
+
+#if defined(_MSC_VER)
+	InitializeCriticalSection(&team->lock);
+	InitializeConditionVariable(&team->wake);
+#else
+	pthread_mutex_init(&team->lock, SLB_NULL);
+	pthread_cond_init(&team->wake, SLB_NULL);
+#endif
+
+	/* Start the workers (thread 0 is the caller) */
+	team->nthread = 1U;
+	for (t = 1U; t < nthread; ++t) {
+		worker = &team->worker[t];
+		worker->team = team;
+		worker->number = t;
+		worker->cpu = pin ? team->topo.cpu[team->index[t]] : SSS_TOPO_ANY;
+#if defined(_MSC_VER)
+		worker->handle = CreateThread(SLB_NULL, 0, team_thread, worker, 0, SLB_NULL);
+		if (worker->handle == SLB_NULL) {
+#else
+		if ( pthread_create(&worker->handle, SLB_NULL, team_thread, worker) != 0 ) {
+#endif
+			sss_team_close(team);
+			return R_LOW_MEMORY;
+		}
+		++team->nthread;
+	}
+	return R_SUCCESS;
+}
+
+/* Runs a task on all threads, and returns when they have finished */
+SLB_RC sss_team_run(
+	SSS_TEAM*			team,		/* thread team */
+	SSS_TEAM_TASK		task,		/* task */
+	void*				param,		/* parameter of the task */
+	slb_int_t			total,		/* number of data */
+	slb_int_t			align		/* alignment of the partitions */
+)
+{
+	slb_uint_t i;
+
+	if ( (team->nthread == 0U) || (total < 0) || (align <= 0) ) {
+		return R_INVALID_PARAM;
+	}
+
+	team->task = task;
+	team->param = param;
+	sss_topo_partition( &team->topo, team->nthread, team->index, total, align, team->start );
+	TEAM_STORE(&team->done, 0U);
+	sss_metrics_add( SSS_METRIC_PARALLEL_REGIONS, 1U );
+
+	/* Publish the task, and wake the parked workers */
+	TEAM_INC(&team->generation);
+	if (TEAM_LOAD(&team->parked) != 0U) {
+		TEAM_LOCK(team);
+		TEAM_WAKE(team);
+		TEAM_UNLOCK(team);
+	}
+
+	if (team->start[0] < team->start[1]) {
+		task( param, 0U, team->start[0], team->start[1] );
+	}
+
+	/* Wait for the workers */
+	for (i = 0; TEAM_LOAD(&team->done) != team->nthread - 1U; ++i) {
+		if (i < team->spin) {
+			TEAM_PAUSE();
+		}
+		else {
+			TEAM_YIELD();
+		}
+	}
+	return R_SUCCESS;
+}
+
+/* Stops the workers and closes a team */
+void sss_team_close(
+	SSS_TEAM*			team		/* thread team */
+)
+{
+	slb_uint_t t;
+
+	if (team->nthread == 0U) {
+		return;
+	}
+
+	TEAM_STORE(&team->stop, 1U);
+	TEAM_LOCK(team);
+	TEAM_WAKE(team);
+	TEAM_UNLOCK(team);
+
+	for (t = 1U; t < team->nthread; ++t) {
+#if defined(_MSC_VER)
+		WaitForSingleObject(team->worker[t].handle, INFINITE);
+		CloseHandle(team->worker[t].handle);
+#else
+		pthread_join(team->worker[t].handle, SLB_NULL);
+#endif
+	}
+
+#if defined(_MSC_VER)
+	DeleteCriticalSection(&team->lock);
+#else
+	pthread_cond_destroy(&team->wake);
+	pthread_mutex_destroy(&team->lock);
+#endif
+	team->nthread = 0;
+}
+
+/* Entry of a worker thread */
+#if defined(_MSC_VER)
+static DWORD WINAPI team_thread(LPVOID param)
+{
+	team_work( (SSS_TEAM_WORKER*)param );
+	return 0;
+}
+#else
+static void* team_thread(void* param)
+{
+	team_work( (SSS_TEAM_WORKER*)param );
+	return SLB_NULL;
+}
+#endif
+
+/* Runs the tasks of a worker until the team is closed
+	The generation counter is seq_cst with the parked counter, so a task
+	published while the worker is parking is seen by either of them.
+*/
+static void team_work(SSS_TEAM_WORKER* worker)
+{
+	SSS_TEAM* team = worker->team;
+	slb_uint_t seen = 0;
+	slb_uint_t i;
+
+	if (worker->cpu != SSS_TOPO_ANY) {
+		(void)sss_topo_pin(worker->cpu);
+	}
+
+	for (;;) {
+		/* Spin, and then park */
+		for (i = 0; i < team->spin; ++i) {
+			if ( (TEAM_LOAD(&team->generation) != seen) || (TEAM_LOAD(&team->stop) != 0U) ) {
+				break;
+			}
+			TEAM_PAUSE();
+		}
+		if (i == team->spin) {
+			TEAM_LOCK(team);
+			TEAM_INC(&team->parked);
+			while ( (TEAM_LOAD(&team->generation) == seen) && (TEAM_LOAD(&team->stop) == 0U) ) {
+				TEAM_WAIT(team);
+			}
+			TEAM_DEC(&team->parked);
+			TEAM_UNLOCK(team);
+		}
+		if (TEAM_LOAD(&team->stop) != 0U) {
+			break;
+		}
+
+		/* Run the partition */
+		seen = TEAM_LOAD(&team->generation);
+		if (team->start[worker->number] < team->start[worker->number + 1U]) {
+			team->task( team->param, worker->number, team->start[worker->number], team->start[worker->number + 1U] );
+		}
+		TEAM_INC(&team->done);
+	}
+}
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ Thread team
+ -------------------------------------------------------------------------------
+ With MP_OMP, each slb_sss_decode call forks and joins the threads, and for
+ chunks of 4 to 64 KB the cost is close to that of the decoding itself.
+
+ A team keeps its worker threads between the calls. sss_team_run publishes a
+ task by a generation counter (no lock), and the caller and the workers each
+ run a partition of the data (see sss_topo_partition); the caller waits for the
+ completion counter. An idle worker spins for SSS_TEAM_SPIN polls, and then parks
+ on a condition variable until the next task. When the team has more threads
+ than the logical CPUs, the workers park without spinning.
+
+ The task is called with the thread number (0: the caller), so that each thread
+ uses its own handle (e.g. SSS_INTERP) and buffers. The task must not call
+ the memory management callback of the caller thread.
+ *******************************************************************************/
+#ifndef SSS_TEAM_H
+#define SSS_TEAM_H
+
+#include "slb_sss.h"
+#include "sss_topo.h"
+
+#if defined(_MSC_VER)
+#	include <windows.h>
+#else
+#	include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_TEAM_MAX_THREADS	64U		/* Maximum threads (including the caller) */
+#define SSS_TEAM_SPIN			20000U	/* Polls before parking or yielding */
+
+/***** Task *****/
+typedef void (*SSS_TEAM_TASK)(
+	void*				param,		/* parameter of the task */
+	slb_uint_t			thread,		/* thread number (0: the caller) */
+	slb_int_t			start,		/* start of the partition */
+	slb_int_t			end			/* end of the partition */
+);
+
+struct SSS_TEAM_;
+
+/***** Worker *****/
+typedef struct {
+	struct SSS_TEAM_*	team;		/* team */
+	slb_uint_t		number;			/* thread number */
+	slb_uint_t		cpu;			/* CPU to pin (SSS_TOPO_ANY: not pinned) */
+#if defined(_MSC_VER)
+	HANDLE			handle;			/* thread handle */
+#else
+	pthread_t		handle;			/* thread handle */
+#endif
+} SSS_TEAM_WORKER;
+
+/***** Thread team *****/
+typedef struct SSS_TEAM_ {
+	slb_uint_t		nthread;		/* number of threads (including the caller) */
+	slb_uint_t		spin;			/* polls before parking */
+	slb_uint_t		index[SSS_TEAM_MAX_THREADS];	/* CPU indexes of the topology */
+	SSS_TOPO		topo;			/* topology */
+	SSS_TEAM_WORKER	worker[SSS_TEAM_MAX_THREADS];	/* workers (0: unused) */
+
+	SSS_TEAM_TASK	task;			/* task in run */
+	void*			param;			/* parameter of the task */
+	slb_int_t		start[SSS_TEAM_MAX_THREADS + 1U];	/* partitions */
+	volatile slb_uint_t	generation;	/* incremented for each task */
+	volatile slb_uint_t	done;		/* number of the threads that finished the task */
+	volatile slb_uint_t	parked;		/* number of the parked workers */
+	volatile slb_uint_t	stop;		/* =1: the workers exit */
+#if defined(_MSC_VER)
+	CRITICAL_SECTION	lock;		/* lock of parking */
+	CONDITION_VARIABLE	wake;		/* wakes the parked workers */
+#else
+	pthread_mutex_t	lock;			/* lock of parking */
+	pthread_cond_t	wake;			/* wakes the parked workers */
+#endif
+} SSS_TEAM;
+
+/***** Function *****/
+SLB_RC sss_team_open(
+	SSS_TEAM*			team,		/* thread team */
+	slb_uint_t			nthread,	/* number of threads (0: the selected CPUs) */
+	slb_bool_t			physical,	/* =SLB_TRUE: one thread per physical core */
+	slb_bool_t			pin			/* =SLB_TRUE: the workers are pinned to the CPUs */
+);
+
+SLB_RC sss_team_run(
+	SSS_TEAM*			team,		/* thread team */
+	SSS_TEAM_TASK		task,		/* task */
+	void*				param,		/* parameter of the task */
+	slb_int_t			total,		/* number of data */
+	slb_int_t			align		/* alignment of the partitions */
+);
+
+void sss_team_close(
+	SSS_TEAM*			team		/* thread team */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_TEAM_H */
@@ -0,0 +1,373 @@
+/*******************************************************************************
+ CPU topology
+ *******************************************************************************/
+#if defined(__GNUC__) && !defined(_GNU_SOURCE)
+#	define _GNU_SOURCE		/* sched_setaffinity */
+#endif
+
+#include "sss_topo.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#	include <stdlib.h>
+#	include <windows.h>
+#else
+#	include <sched.h>
+#	include <pthread.h>
+#endif
+
+static SLB_RC topo_read_system(SSS_TOPO* topo, const char* root);
+#if !defined(_MSC_VER)
+static slb_bool_t topo_read_uint(const char* root, slb_uint_t cpu, const char* name, slb_uint_t* value);
+#endif
+static void topo_finish(SSS_TOPO* topo);
+
+#if !defined(_MSC_VER)
+static void topo_save_affinity(void);
+
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+static cpu_set_t s_affinity;					/* affinity of the process before the first pin */
+static slb_bool_t s_affinity_saved = SLB_FALSE;
+#endif
+
+/* Reads topology
+	When the topology of the system is not available, each logical CPU is a core.
+*/
+SLB_RC sss_topo_read(
+	SSS_TOPO*			topo,		/* [out] topology */
+	const char*			root		/* root of the topology (SLB_NULL: the system) */
+)
+{
+	SLB_RC rc;
+	slb_uint_t i;
+
+	memset(topo, 0, sizeof(*topo));
+
+	rc = topo_read_system( topo, root );
+	if ( SLB_R_FAILED(rc) ) {
+		if (root != SLB_NULL) {
+			return rc;
+		}
+		memset(topo, 0, sizeof(*topo));
+		topo->logical = (slb_uint_t)slb_get_nmb_of_cores();
+		if (SSS_TOPO_MAX_CPUS < topo->logical) {
+			topo->logical = SSS_TOPO_MAX_CPUS;
+		}
+		for (i = 0; i < topo->logical; ++i) {
+			topo->cpu[i] = i;
+			topo->core[i] = i;
+		}
+	}
+
+	topo_finish(topo);
+	return R_SUCCESS;
+}
+
+/* Lists CPUs to run threads on (the fastest class, and the first threads of the cores first)
+	Returns the number of the CPUs.
+*/
+slb_uint_t sss_topo_select(
+	const SSS_TOPO*		topo,		/* topology */
+	slb_bool_t			physical,	/* =SLB_TRUE: one thread per physical core */
+	slb_uint_t			max,		/* maximum number of threads */
+	slb_uint_t			index[]		/* [out] indexes of the CPUs of the threads [max] */
+)
+{
+	slb_uint_t order[SSS_TOPO_MAX_CPUS];
+	slb_uint_t i, j, t, count = 0;
+
+	for (i = 0; i < topo->logical; ++i) {
+		if ( physical && (topo->thread[i] != 0U) ) {
+			continue;
+		}
+		/* Insertion by speed (descending) and thread (ascending) */
+		for (j = count; 0U < j; --j) {
+			t = order[j - 1U];
+			if ( (topo->speed[i] < topo->speed[t]) ||
+				 ( (topo->speed[i] == topo->speed[t]) && (topo->thread[t] <= topo->thread[i]) ) ) {
+				break;
+			}
+			order[j] = t;
+		}
+		order[j] = i;
+		++count;
+	}
+
+	if (max < count) {
+		count = max;
+	}
+	memcpy( index, order, sizeof(slb_uint_t) * count );
+	return count;
+}
+
+/* Divides data in proportion to the speed of the CPUs
+	When the speed of a CPU is unknown, the data is divided equally.
+*/
+void sss_topo_partition(
+	const SSS_TOPO*		topo,		/* topology */
+	slb_uint_t			nthread,	/* number of threads */
+	const slb_uint_t	index[],	/* indexes of the CPUs of the threads */
+	slb_int_t			total,		/* number of data */
+	slb_int_t			align,		/* alignment of the partitions */
+	slb_int_t			start[]		/* [out] start of the partitions [nthread + 1] */
+)
+{
+	slb_uint64_t sum = 0, cum = 0;
+	slb_bool_t equal = SLB_FALSE;
+	slb_uint_t t;
+	slb_int_t s;
+
+	for (t = 0; t < nthread; ++t) {
+		sum += topo->speed[index[t]];
+		if (topo->speed[index[t]] == 0U) {
+			equal = SLB_TRUE;
+		}
+	}
+	if (equal) {
+		sum = nthread;
+	}
+
+	start[0] = 0;
+	for (t = 0; t < nthread; ++t) {
+		cum += equal ? 1U : topo->speed[index[t]];
+		s = (slb_int_t)( (slb_uint64_t)total * cum / sum );
+		s -= s % align;
+		start[t + 1U] = ( s < start[t] ) ? start[t] : s;
+	}
+	start[nthread] = total;
+}
+
+/* Pins the calling thread to a CPU
+	SSS_TOPO_ANY restores the affinity of the process (on Linux, the affinity saved at the first pin,
+	which keeps the CPUs of taskset or cpuset).
+*/
+SLB_RC sss_topo_pin(
+	slb_uint_t			cpu			/* CPU number (SSS_TOPO_ANY: the CPUs of the process) */
+)
+{
+#if defined(_MSC_VER)
+	DWORD_PTR process_mask, system_mask;
+	DWORD_PTR mask;
+
+	if (cpu == SSS_TOPO_ANY) {
+		if ( !GetProcessAffinityMask( GetCurrentProcess(), &process_mask, &system_mask ) ) {
+			return R_INVALID_PARAM;
+		}
+		mask = process_mask;
+	}
+	else if (cpu < sizeof(DWORD_PTR) * 8U) {
+		mask = (DWORD_PTR)1 << cpu;
+	}
+	else {
+		return R_INVALID_PARAM;
+	}
+	return ( SetThreadAffinityMask( GetCurrentThread(), mask ) != 0 ) ? R_SUCCESS : R_INVALID_PARAM;
+#else
+	cpu_set_t set;
+
+	pthread_once( &s_once, topo_save_affinity );
+
+	CPU_ZERO(&set);
+	if (cpu == SSS_TOPO_ANY) {
+		if (s_affinity_saved == SLB_FALSE) {
+			return R_INVALID_PARAM;
+		}
+		set = s_affinity;
+	}
+	else if (cpu < CPU_SETSIZE) {
+		CPU_SET(cpu, &set);
+	}
+	else {
+		return R_INVALID_PARAM;
+	}
+	return ( sched_setaffinity( 0, sizeof(set), &set ) == 0 ) ? R_SUCCESS : R_INVALID_PARAM;
+#endif
+}
+
+/* Sets the number of threads of libslbsss (MP_OMP) */
+void sss_topo_set_mp(
+	const SSS_TOPO*		topo,		/* topology */
+	slb_bool_t			physical	/* =SLB_TRUE: one thread per physical core */
+)
+{
+	slb_sss_set_mp( MP_OMP, (slb_int_t)( physical ? topo->physical : topo->logical ) );
+}
+
+#if defined(_MSC_VER)
+
+/* Reads topology of the system (processor group 0) */
+static SLB_RC topo_read_system(SSS_TOPO* topo, const char* root)
+{
+	SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* buf;
+	SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* info;
+	DWORD len = 0;
+	DWORD offset;
+	slb_uint_t core_of[64], speed_of[64];
+	slb_uint_t i, cores = 0;
+
+	if (root != SLB_NULL) {
+		return R_INVALID_PARAM;
+	}
+
+	GetLogicalProcessorInformationEx( RelationProcessorCore, SLB_NULL, &len );
+	buf = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)malloc(len);
+	if (buf == SLB_NULL) {
+		return R_LOW_MEMORY;
+	}
+	if ( !GetLogicalProcessorInformationEx( RelationProcessorCore, buf, &len ) ) {
+		free(buf);
+		return R_INVALID_PARAM;
+	}
+
+	for (i = 0; i < 64U; ++i) {
+		core_of[i] = SSS_TOPO_ANY;
+	}
+	for (offset = 0; offset < len; offset += info->Size) {
+		info = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)( (BYTE*)buf + offset );
+		if (info->Processor.GroupMask[0].Group == 0) {
+			for (i = 0; i < 64U; ++i) {
+				if ( ( info->Processor.GroupMask[0].Mask >> i ) & 1U ) {
+					core_of[i] = cores;
+					speed_of[i] = (slb_uint_t)info->Processor.EfficiencyClass + 1U;
+				}
+			}
+			++cores;
+		}
+	}
+	free(buf);
+
+	for (i = 0; i < 64U; ++i) {
+		if (core_of[i] != SSS_TOPO_ANY) {
+			topo->cpu[topo->logical] = i;
+			topo->core[topo->logical] = core_of[i];
+			topo->speed[topo->logical] = speed_of[i];
+			++topo->logical;
+		}
+	}
+	return ( topo->logical != 0U ) ? R_SUCCESS : R_INVALID_PARAM;
+}
+
+#else
+
+/* Reads topology of sysfs
+	The physical cores are numbered in the order of appearance.
+*/
+static SLB_RC topo_read_system(SSS_TOPO* topo, const char* root)
+{
+	slb_uint_t key[SSS_TOPO_MAX_CPUS];
+	char path[256];
+	FILE* fp;
+	slb_uint_t first, last, cpu, package, core_id, i;
+	int c;
+
+	if (root == SLB_NULL) {
+		root = SSS_TOPO_SYSFS;
+	}
+	if ( sizeof(path) < strlen(root) + 64U ) {
+		return R_INVALID_PARAM;
+	}
+
+	/* Online CPUs (e.g. "0-3,8-11") */
+	sprintf(path, "%s/online", root);
+	if ( ( fp = fopen(path, "r") ) == SLB_NULL ) {
+		return R_INVALID_PARAM;
+	}
+	while ( fscanf(fp, "%u", &first) == 1 ) {
+		last = first;
+		c = fgetc(fp);
+		if (c == '-') {
+			if ( fscanf(fp, "%u", &last) != 1 ) {
+				break;
+			}
+			c = fgetc(fp);
+		}
+		for (cpu = first; (cpu <= last) && (topo->logical < SSS_TOPO_MAX_CPUS); ++cpu) {
+			topo->cpu[topo->logical++] = cpu;
+		}
+		if (c != ',') {
+			break;
+		}
+	}
+	fclose(fp);
+
+	/* Physical cores and speed */
+	for (i = 0; i < topo->logical; ++i) {
+		cpu = topo->cpu[i];
+		if ( !topo_read_uint( root, cpu, "topology/physical_package_id", &package ) ||
+			 !topo_read_uint( root, cpu, "topology/core_id", &core_id ) ) {
+			return R_INVALID_PARAM;
+		}
+		key[i] = ( package << 16 ) | ( core_id & 0xffffU );
+		for (first = 0; first < i; ++first) {
+			if (key[first] == key[i]) {
+				break;
+			}
+		}
+		topo->core[i] = ( first < i ) ? topo->core[first] : topo->physical++;
+
+		if ( !topo_read_uint( root, cpu, "cpufreq/cpuinfo_max_freq", &topo->speed[i] ) &&
+			 !topo_read_uint( root, cpu, "cpu_capacity", &topo->speed[i] ) ) {
+			topo->speed[i] = 0U;
+		}
+	}
+	return ( topo->logical != 0U ) ? R_SUCCESS : R_INVALID_PARAM;
+}
+
+/* Reads a number of a CPU */
+static slb_bool_t topo_read_uint(const char* root, slb_uint_t cpu, const char* name, slb_uint_t* value)
+{
+	char path[256];
+	FILE* fp;
+	slb_bool_t ok;
+
+	sprintf(path, "%s/cpu%u/%s", root, cpu, name);
+	if ( ( fp = fopen(path, "r") ) == SLB_NULL ) {
+		return SLB_FALSE;
+	}
+	ok = ( fscanf(fp, "%u", value) == 1 ) ? SLB_TRUE : SLB_FALSE;
+	fclose(fp);
+	return ok;
+}
+
+#endif
+
+/* Numbers the physical cores, the threads in the cores and the classes */
+static void topo_finish(SSS_TOPO* topo)
+{
+	slb_uint_t i, j;
+
+	topo->physical = 0;
+	topo->classes = 0;
+	for (i = 0; i < topo->logical; ++i) {
+		topo->thread[i] = 0;
+		for (j = 0; j < i; ++j) {
+			if (topo->core[j] == topo->core[i]) {
+				++topo->thread[i];
+			}
+		}
+		if ( topo->physical <= topo->core[i] ) {
+			topo->physical = topo->core[i] + 1U;
+		}
+		for (j = 0; j < i; ++j) {
+			if (topo->speed[j] == topo->speed[i]) {
+				break;
+			}
+		}
+		if (j == i) {
+			++topo->classes;
+		}
+	}
+}
+
+#if !defined(_MSC_VER)
+
+/* Saves the affinity of the process before the first pin */
+static void topo_save_affinity(void)
+{
+	CPU_ZERO(&s_affinity);
+	s_affinity_saved = ( sched_getaffinity( 0, sizeof(s_affinity), &s_affinity ) == 0 ) ? SLB_TRUE : SLB_FALSE;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ CPU topology
+ -------------------------------------------------------------------------------
+ slb_get_nmb_of_cores returns the number of logical CPUs. The arithmetic kernels
+ keep the SIMD ports busy, so a second thread of a physical core (SMT) adds
+ little, and on hybrid CPUs the slower cores delay the join of the threads.
+
+ sss_topo_read reads the physical cores of the logical CPUs and their speed:
+	Linux	ROOT/online, ROOT/cpuN/topology/{physical_package_id, core_id},
+			ROOT/cpuN/cpufreq/cpuinfo_max_freq or ROOT/cpuN/cpu_capacity
+			(ROOT is SSS_TOPO_SYSFS, or a directory of the same layout for tests)
+	Windows	GetLogicalProcessorInformationEx (EfficiencyClass as the speed)
+ The CPUs of the same speed are a class; two or more classes are a hybrid CPU.
+
+ sss_topo_select lists the CPUs to run threads on (one per physical core, or all),
+ the fastest first. sss_topo_partition divides data among the threads in
+ proportion to the speed of their CPUs, and sss_topo_pin pins the calling thread.
+ *******************************************************************************/
+#ifndef SSS_TOPO_H
+#define SSS_TOPO_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_TOPO_MAX_CPUS	256U						/* Maximum logical CPUs */
+#define SSS_TOPO_SYSFS		"/sys/devices/system/cpu"	/* Root of the topology of Linux */
+#define SSS_TOPO_ANY		0xffffffffU					/* Any CPU (sss_topo_pin) */
+
+/***** Topology *****/
+typedef struct {
+	slb_uint_t		logical;					/* number of logical CPUs */
+	slb_uint_t		physical;					/* number of physical cores */
+	slb_uint_t		classes;					/* number of classes of speed */
+	slb_uint_t		cpu[SSS_TOPO_MAX_CPUS];		/* CPU number */
+	slb_uint_t		core[SSS_TOPO_MAX_CPUS];	/* physical core (0 to physical - 1) */
+	slb_uint_t		thread[SSS_TOPO_MAX_CPUS];	/* thread in the core (0: first) */
+	slb_uint_t		speed[SSS_TOPO_MAX_CPUS];	/* relative speed (0: unknown) */
+} SSS_TOPO;
+
+/***** Function *****/
+SLB_RC sss_topo_read(
+	SSS_TOPO*			topo,		/* [out] topology */
+	const char*			root		/* root of the topology (SLB_NULL: the system) */
+);
+
+slb_uint_t sss_topo_select(
+	const SSS_TOPO*		topo,		/* topology */
+	slb_bool_t			physical,	/* =SLB_TRUE: one thread per physical core */
+	slb_uint_t			max,		/* maximum number of threads */
+	slb_uint_t			index[]		/* [out] indexes of the CPUs of the threads [max] */
+);
+
+void sss_topo_partition(
+	const SSS_TOPO*		topo,		/* topology */
+	slb_uint_t			nthread,	/* number of threads */
+	const slb_uint_t	index[],	/* indexes of the CPUs of the threads */
+	slb_int_t			total,		/* number of data */
+	slb_int_t			align,		/* alignment of the partitions */
+	slb_int_t			start[]		/* [out] start of the partitions [nthread + 1] */
+);
+
+SLB_RC sss_topo_pin(
+	slb_uint_t			cpu			/* CPU number (SSS_TOPO_ANY: the CPUs of the process) */
+);
+
+void sss_topo_set_mp(
+	const SSS_TOPO*		topo,		/* topology */
+	slb_bool_t			physical	/* =SLB_TRUE: one thread per physical core */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_TOPO_H */
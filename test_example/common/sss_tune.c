@@ -0,0 +1,125 @@
+/*******************************************************************************
+ Chunk size tuning
+ *******************************************************************************/
+#include "sss_tune.h"
+#include "sss_clock.h"
+#include "cpuinfo.h"
+
+#include <string.h>
+
+static slb_int_t tune_clamp(slb_int_t nmb, slb_int_t maxnmb);
+static void tune_add(SSS_TUNE* tune, slb_int_t nmb);
+
+/* Returns nmb of the model */
+slb_int_t sss_tune_model(
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	slb_int_t			maxnmb		/* maximum number of data */
+)
+{
+	slb_uint_t l2 = GetCacheSize(2U);
+
+	if (l2 == 0U) {
+		l2 = SSS_TUNE_L2_DEFAULT;
+	}
+	return tune_clamp( (slb_int_t)( ( l2 / 2U ) / ( 4U * k + 4U * n + 2U ) ), maxnmb );
+}
+
+/* Starts tuning */
+void sss_tune_start(
+	SSS_TUNE*			tune,		/* tuning handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	slb_int_t			maxnmb,		/* maximum number of data */
+	slb_int_t			hint		/* another candidate (0: none) */
+)
+{
+	const slb_int_t model = sss_tune_model( k, n, maxnmb );
+
+	memset(tune, 0, sizeof(*tune));
+
+	tune_add( tune, model );
+	tune_add( tune, tune_clamp( model / 2, maxnmb ) );
+	tune_add( tune, tune_clamp( model * 2, maxnmb ) );
+	if (0 < hint) {
+		tune_add( tune, ( hint < maxnmb ) ? hint : maxnmb );
+	}
+	tune->nmb = model;
+}
+
+/* Begins a chunk, and returns nmb of the chunk */
+slb_int_t sss_tune_begin(
+	SSS_TUNE*			tune		/* tuning handle */
+)
+{
+	tune->start = sss_clock_ns();
+	return ( tune->cur < tune->ncand ) ? tune->cand[tune->cur] : tune->nmb;
+}
+
+/* Ends a chunk
+	A chunk of less data (the last one) is not timed.
+*/
+void sss_tune_end(
+	SSS_TUNE*			tune,		/* tuning handle */
+	slb_int_t			nmb			/* number of data processed */
+)
+{
+	const double ns = (double)( sss_clock_ns() - tune->start ) / (double)( ( 0 < nmb ) ? nmb : 1 );
+	slb_uint_t i, best;
+
+	/* Use the fastest candidate, and time again after the period */
+	if (tune->ncand <= tune->cur) {
+		if (SSS_TUNE_PERIOD <= ++tune->chunks) {
+			tune->cur = 0U;
+			tune->samples = 0U;
+			tune->chunks = 0U;
+		}
+		return;
+	}
+
+	if (nmb != tune->cand[tune->cur]) {
+		return;
+	}
+	if ( (tune->samples == 0U) || (ns < tune->ns[tune->cur]) ) {
+		tune->ns[tune->cur] = ns;
+	}
+	if (++tune->samples < SSS_TUNE_SAMPLES) {
+		return;
+	}
+	tune->samples = 0U;
+	if (++tune->cur < tune->ncand) {
+		return;
+	}
+
+	best = 0U;
+	for (i = 1U; i < tune->ncand; ++i) {
+		if (tune->ns[i] < tune->ns[best]) {
+			best = i;
+		}
+	}
+	tune->nmb = tune->cand[best];
+}
+
+/* Aligns and limits nmb */
+static slb_int_t tune_clamp(slb_int_t nmb, slb_int_t maxnmb)
+{
+	nmb -= nmb % SSS_TUNE_ALIGN;
+	if (nmb < SSS_TUNE_ALIGN) {
+		nmb = SSS_TUNE_ALIGN;
+	}
+	return ( nmb < maxnmb ) ? nmb : maxnmb;
+}
+
+/* Adds a candidate (no duplicate) */
+static void tune_add(SSS_TUNE* tune, slb_int_t nmb)
+{
+	slb_uint_t i;
+
+	for (i = 0; i < tune->ncand; ++i) {
+		if (tune->cand[i] == nmb) {
+			return;
+		}
+	}
+	tune->cand[tune->ncand++] = nmb;
+}
+
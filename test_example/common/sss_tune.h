@@ -0,0 +1,73 @@
+/*******************************************************************************
+ Chunk size tuning
+ -------------------------------------------------------------------------------
+ Chooses the number of data of a chunk (nmb) for encoding/decoding.
+
+ The model fits the working set of a chunk in half of the L2 cache
+ (the other half is left to the tables and the other data):
+	nmb * ( 4 * k + 4 * n + 2 ) <= L2 / 2
+ (32-bit coefficients of k rows, 32-bit shares of n rows and 16-bit plain data).
+
+ The candidates (the model, half and double of it, and the hint such as
+ slb_sss_get_bestnmb) are timed online for SSS_TUNE_SAMPLES chunks each, and the
+ fastest per data is used. The candidates are timed again every SSS_TUNE_PERIOD chunks.
+	nmb = sss_tune_begin(&tune);
+	(encode or decode a chunk of nmb or less)
+	sss_tune_end(&tune, nmb);
+ *******************************************************************************/
+#ifndef SSS_TUNE_H
+#define SSS_TUNE_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_TUNE_ALIGN			64		/* nmb is a multiple of this (SIMD and cache line) */
+#define SSS_TUNE_L2_DEFAULT		( 256U * 1024U )	/* L2 size when it is unknown */
+#define SSS_TUNE_CANDIDATES		4U		/* Maximum number of candidates */
+#define SSS_TUNE_SAMPLES		4U		/* Chunks timed for each candidate */
+#define SSS_TUNE_PERIOD			4096U	/* Chunks between the timings */
+
+/***** Tuning handle *****/
+typedef struct {
+	slb_int_t		cand[SSS_TUNE_CANDIDATES];	/* candidates of nmb */
+	double			ns[SSS_TUNE_CANDIDATES];	/* minimum time per data (ns) */
+	slb_uint_t		ncand;			/* number of candidates */
+	slb_uint_t		cur;			/* candidate timed (ncand: timing is done) */
+	slb_uint_t		samples;		/* chunks timed for the current candidate */
+	slb_uint_t		chunks;			/* chunks after the timing */
+	slb_int_t		nmb;			/* nmb in use */
+	slb_uint64_t	start;			/* start time of the chunk (ns) */
+} SSS_TUNE;
+
+/***** Function *****/
+slb_int_t sss_tune_model(
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	slb_int_t			maxnmb		/* maximum number of data */
+);
+
+void sss_tune_start(
+	SSS_TUNE*			tune,		/* tuning handle */
+	slb_uint_t			k,			/* threshold */
+	slb_uint_t			n,			/* number of shares */
+	slb_int_t			maxnmb,		/* maximum number of data */
+	slb_int_t			hint		/* another candidate (0: none) */
+);
+
+slb_int_t sss_tune_begin(
+	SSS_TUNE*			tune		/* tuning handle */
+);
+
+void sss_tune_end(
+	SSS_TUNE*			tune,		/* tuning handle */
+	slb_int_t			nmb			/* number of data processed */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_TUNE_H */
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ Secure wipe
+ *******************************************************************************/
+#include "sss_wipe.h"
+#include "sss_mem.h"
+#include "sss_metrics.h"
+#include "cpuinfo.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+/* Barrier after the stores (the cleared memory is regarded as read) */
+#if defined(_MSC_VER)
+#	define WIPE_BARRIER(mem)	_ReadWriteBarrier()
+#else
+#	define WIPE_BARRIER(mem)	__asm__ __volatile__( "" : : "r"(mem) : "memory" )
+#endif
+
+static void wipe_stream_avx2(slb_uint8_t* mem, slb_uint_t size);
+
+/* memset called through a volatile pointer is not removed */
+static void* (*const volatile s_memset)(void*, int, size_t) = memset;
+
+static slb_bool_t s_avx2 = SLB_FALSE;
+static slb_bool_t s_share = SLB_TRUE;
+
+/* Sets SIMD to be used */
+void sss_wipe_set_simd(
+	slb_bool_t			avx2		/* =SLB_TRUE: AVX2 is used */
+)
+{
+	s_avx2 = avx2;
+}
+
+/* Sets wipe policy (plain data and coefficients are always wiped) */
+void sss_wipe_set_policy(
+	slb_bool_t			share		/* =SLB_TRUE: share buffers are wiped */
+)
+{
+	s_share = share;
+}
+
+/* Wipes memory */
+void sss_wipe(
+	void*				mem,		/* memory */
+	slb_uint_t			size		/* size in bytes */
+)
+{
+	if ( (mem == SLB_NULL) || (size == 0U) ) {
+		return;
+	}
+	if ( s_avx2 && (SSS_WIPE_NT_MIN <= size) ) {
+		wipe_stream_avx2( (slb_uint8_t*)mem, size );
+	}
+	else {
+		s_memset( mem, 0, size );
+	}
+	WIPE_BARRIER(mem);
+	sss_metrics_add( SSS_METRIC_WIPE_BYTES, size );
+}
+
+/* Wipes memory by the policy of the class */
+void sss_wipe_class(
+	SSS_WIPE_CLASS		cls,		/* buffer class */
+	void*				mem,		/* memory */
+	slb_uint_t			size		/* size in bytes */
+)
+{
+	if ( (cls != SSS_WIPE_SHARE) || s_share ) {
+		sss_wipe( mem, size );
+	}
+}
+
+/* Wipes memory by the policy of the class, and frees it */
+void sss_wipe_free(
+	void*				mem_param,	/* parameter for memory management callback */
+	SSS_WIPE_CLASS		cls,		/* buffer class */
+	void*				mem,		/* memory (SLB_NULL: nothing is done) */
+	slb_uint_t			size		/* size in bytes */
+)
+{
+	static const SSS_MEM_USAGE usage[] = { SSS_MEM_PLAIN, SSS_MEM_COEF, SSS_MEM_SHARE };
+
+	if (mem != SLB_NULL) {
+		sss_wipe_class( cls, mem, size );
+		sss_mem_free( mem_param, mem, size, usage[cls], ( cls != SSS_WIPE_SHARE ) || s_share );
+	}
+}
+
+/* Non-temporal stores (AVX2)
+	The head and the tail out of 32-byte alignment are cleared by memset.
+*/
+SIMD_TARGET("avx2")
+static void wipe_stream_avx2(slb_uint8_t* mem, slb_uint_t size)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	slb_uint_t head = (slb_uint_t)( ( 32U - ( (size_t)mem & 31U ) ) & 31U );
+	slb_uint_t i;
+
+	s_memset( mem, 0, head );
+	for (i = head; i + 32U <= size; i += 32U) {
+		_mm256_stream_si256( (__m256i*)&mem[i], zero );
+	}
+	_mm_sfence();
+	s_memset( &mem[i], 0, size - i );
+}
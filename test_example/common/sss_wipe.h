@@ -0,0 +1,65 @@
+/*******************************************************************************
+ Secure wipe
+ -------------------------------------------------------------------------------
+ Clears the buffers of the example modules so that the stores are not removed
+ by the compiler. Regions of SSS_WIPE_NT_MIN bytes or more are cleared by
+ non-temporal stores (AVX2), which do not evict the working set from the cache.
+
+ The buffers are classified, and the policy decides which classes are wiped:
+	SSS_WIPE_PLAIN	plain data and partial sums of it	(always wiped)
+	SSS_WIPE_COEF	random coefficients					(always wiped)
+	SSS_WIPE_SHARE	share data only						(optional, wiped by default)
+
+ sss_wipe_free wipes a buffer of sss_mem_alloc by the policy and frees it
+ without the clearing of slb_free, so that the memory is cleared once.
+ *******************************************************************************/
+#ifndef SSS_WIPE_H
+#define SSS_WIPE_H
+
+#include "slb_sss.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSS_WIPE_NT_MIN		( 32U * 1024U * 1024U )	/* Minimum size of non-temporal stores (by benchmark) */
+
+/***** Buffer class *****/
+typedef enum {
+	SSS_WIPE_PLAIN,				/* plain data */
+	SSS_WIPE_COEF,				/* random coefficients */
+	SSS_WIPE_SHARE				/* share data */
+} SSS_WIPE_CLASS;
+
+/***** Function *****/
+void sss_wipe_set_simd(
+	slb_bool_t			avx2		/* =SLB_TRUE: AVX2 is used */
+);
+
+void sss_wipe_set_policy(
+	slb_bool_t			share		/* =SLB_TRUE: share buffers are wiped */
+);
+
+void sss_wipe(
+	void*				mem,		/* memory */
+	slb_uint_t			size		/* size in bytes */
+);
+
+void sss_wipe_class(
+	SSS_WIPE_CLASS		cls,		/* buffer class */
+	void*				mem,		/* memory */
+	slb_uint_t			size		/* size in bytes */
+);
+
+void sss_wipe_free(
+	void*				mem_param,	/* parameter for memory management callback */
+	SSS_WIPE_CLASS		cls,		/* buffer class */
+	void*				mem,		/* memory (SLB_NULL: nothing is done) */
+	slb_uint_t			size		/* size in bytes */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ifndef SSS_WIPE_H */